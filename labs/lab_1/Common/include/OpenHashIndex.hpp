@@ -0,0 +1,145 @@
+/**
+ * @file OpenHashIndex.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the OpenHashIndex class - open addressing index over positions of a container
+ * @version 0.1
+ * @date 2025-10-20
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class OpenHashIndex
+ * @brief Open addressing (linear probing) hash index over positions of an external container
+ *
+ * The index does not own the keys: it stores positions of elements in the owner's
+ * vector together with their cached hashes. Key comparison is delegated to the owner
+ * through a predicate, so the same index serves sets of strings, multisets and
+ * sets of interned identifiers. Lookup and insertion are O(1) on average.
+ */
+class OpenHashIndex{
+    std::vector<std::uint32_t> slots;   ///< Probe table: 0 - empty slot, otherwise position + 1
+    std::vector<std::size_t> hashes;    ///< Cached hash of every indexed position
+    unsigned shift;                     ///< 64 - log2(slots.size()) for fibonacci hashing
+
+    /**
+     * @brief Private method to get the home slot of a hash
+     *
+     * @param hash hash of the element
+     * @return std::size_t
+     */
+    std::size_t homeSlot(std::size_t hash) const;
+
+    /**
+     * @brief Private constant method to find the probe table slot holding an indexed position
+     *
+     * @param position indexed position
+     * @return std::size_t
+     */
+    std::size_t slotOf(std::size_t position) const;
+
+    /**
+     * @brief Private method to put a position into the probe table without growing
+     *
+     * @param hash hash of the element
+     * @param position position of the element in the owner's container
+     */
+    void place(std::size_t hash, std::uint32_t position);
+
+    /**
+     * @brief Private method to resize the probe table for the given number of elements
+     *
+     * @param count number of elements the table must hold at load factor <= 1/2
+     */
+    void resizeFor(std::size_t count);
+
+    public:
+    /**
+     * @brief Value returned by find when the element is absent
+     *
+     */
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    /**
+     * @brief Construct a new empty OpenHashIndex object
+     *
+     */
+    OpenHashIndex();
+
+    /**
+     * @brief Public method to find the position of an element
+     *
+     * @tparam Equal predicate bool(std::size_t position) comparing the searched key with the key at position
+     * @param hash hash of the searched key
+     * @param equal predicate called only for positions with equal hashes
+     * @return std::size_t position of the element or npos
+     */
+    template <typename Equal>
+    std::size_t find(std::size_t hash, Equal&& equal) const{
+        if(hashes.empty()) return npos;
+        const std::size_t mask = slots.size() - 1;
+        for(std::size_t i = homeSlot(hash); ; i = (i + 1) & mask){
+            std::uint32_t slot = slots[i];
+            if(slot == 0) return npos; // дошли до пустого - элемента нет
+            std::size_t position = slot - 1;
+            if(hashes[position] == hash && equal(position)) return position;
+        }
+    }
+
+    /**
+     * @brief Public method to index a new element placed at position size()
+     *
+     * @param hash hash of the new element
+     */
+    void append(std::size_t hash);
+
+    /**
+     * @brief Public method to remove the element at position in O(1)
+     *
+     * The last element takes the freed position (swap-and-pop): the owner must move
+     * its last element to position and pop the back of its container the same way.
+     *
+     * @param position position of the removed element
+     */
+    void erase(std::size_t position);
+
+    /**
+     * @brief Public method to rebuild the index from a new list of hashes (one per position)
+     *
+     * @param newHashes hashes of the owner's elements in container order
+     */
+    void rebuild(std::vector<std::size_t> newHashes);
+
+    /**
+     * @brief Public constant method to get the cached hash of a position
+     *
+     * @param position position of the element
+     * @return std::size_t
+     */
+    std::size_t hashAt(std::size_t position) const;
+
+    /**
+     * @brief Public method to reserve space for the given number of elements
+     *
+     * @param count expected number of elements
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Public method to clear the index
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Public constant method to get the number of indexed elements
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+};
@@ -0,0 +1,82 @@
+/**
+ * @file SetLiteralParser.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the SetLiteralParser class - shared single-pass parser of set literals
+ * @version 0.1
+ * @date 2025-10-21
+ *
+ *
+ */
+
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @struct ElementSpan
+ * @brief Top-level element of a set literal as a view into the source string
+ *
+ */
+struct ElementSpan{
+    std::string_view text;  ///< Element text without leading and trailing spaces
+    bool hasSpaces;         ///< True if the element contains inner spaces that must be removed
+};
+
+/**
+ * @class SetLiteralParser
+ * @brief Single-pass validator and tokenizer of set literals shared by Set and MultiSet
+ *
+ * Grammar: a literal is either one set in braces "{a, {b, c}}" or a bare list "a, b, {c}".
+ * Atoms consist of latin letters and digits, spaces are allowed between tokens.
+ * Validation and splitting into top-level elements happen in the same pass,
+ * elements are returned as views into the source string without copying.
+ */
+class SetLiteralParser{
+    public:
+    /**
+     * @brief Public static method to check whether a string is a valid set literal
+     *
+     * @param literal string being checked
+     * @return true
+     * @return false
+     */
+    static bool isValid(std::string_view literal);
+
+    /**
+     * @brief Public static method to check whether a string is exactly one valid element
+     * (an atom or one set in braces), e.g. "a" or "{a, {b}}" but not "a, b"
+     *
+     * @param element string being checked
+     * @return true
+     * @return false
+     */
+    static bool isElement(std::string_view element);
+
+    /**
+     * @brief Public static method to validate a literal and split it into top-level elements
+     *
+     * @param literal string to parse
+     * @param elements output vector of element spans, cleared before parsing
+     * @return true if the literal is valid
+     * @return false if the literal is invalid (elements are left empty)
+     */
+    static bool parse(std::string_view literal, std::vector<ElementSpan>& elements);
+
+    /**
+     * @brief Public static method to get the canonical text of an element (without spaces)
+     *
+     * @param element element span
+     * @return std::string
+     */
+    static std::string normalize(const ElementSpan& element);
+
+    /**
+     * @brief Public static method to check whether a character may appear in an atom
+     *
+     * @param symbol character being checked
+     * @return true
+     * @return false
+     */
+    static bool isAtomChar(char symbol);
+};
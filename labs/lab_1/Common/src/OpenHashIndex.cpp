@@ -0,0 +1,97 @@
+#include "OpenHashIndex.hpp"
+
+OpenHashIndex::OpenHashIndex() : shift(64) {}
+
+std::size_t OpenHashIndex::homeSlot(std::size_t hash) const{
+    // fibonacci hashing: слабые младшие биты хэша не портят распределение
+    return static_cast<std::size_t>((static_cast<std::uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> shift);
+}
+
+std::size_t OpenHashIndex::slotOf(std::size_t position) const{
+    const std::size_t mask = slots.size() - 1;
+    std::size_t i = homeSlot(hashes[position]);
+    while(slots[i] != position + 1){
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+void OpenHashIndex::place(std::size_t hash, std::uint32_t position){
+    const std::size_t mask = slots.size() - 1;
+    std::size_t i = homeSlot(hash);
+    while(slots[i] != 0){
+        i = (i + 1) & mask;
+    }
+    slots[i] = position + 1;
+}
+
+void OpenHashIndex::resizeFor(std::size_t count){
+    std::size_t capacity = 8;
+    unsigned bits = 3;
+    while(capacity < count * 2){ // load factor не больше 1/2
+        capacity <<= 1;
+        bits++;
+    }
+    if(capacity == slots.size()) return;
+    slots.assign(capacity, 0);
+    shift = 64 - bits;
+    for(std::size_t position = 0; position < hashes.size(); ++position){
+        place(hashes[position], static_cast<std::uint32_t>(position));
+    }
+}
+
+void OpenHashIndex::append(std::size_t hash){
+    hashes.push_back(hash);
+    if(slots.size() < hashes.size() * 2){
+        resizeFor(hashes.size()); // resizeFor уже разложил и новый элемент
+        return;
+    }
+    place(hash, static_cast<std::uint32_t>(hashes.size() - 1));
+}
+
+void OpenHashIndex::erase(std::size_t position){
+    if(position >= hashes.size()) return;
+    const std::size_t mask = slots.size() - 1;
+    const std::size_t last = hashes.size() - 1;
+    // backward shift deletion: сдвигаем назад элементы цепочки, которые могут занять дыру
+    std::size_t hole = slotOf(position);
+    for(std::size_t i = (hole + 1) & mask; slots[i] != 0; i = (i + 1) & mask){
+        std::size_t home = homeSlot(hashes[slots[i] - 1]);
+        if(((i - home) & mask) >= ((i - hole) & mask)){ // домашний слот не позже дыры
+            slots[hole] = slots[i];
+            hole = i;
+        }
+    }
+    slots[hole] = 0;
+    if(position != last){ // последний элемент занимает освободившуюся позицию
+        slots[slotOf(last)] = static_cast<std::uint32_t>(position + 1);
+        hashes[position] = hashes[last];
+    }
+    hashes.pop_back();
+}
+
+void OpenHashIndex::rebuild(std::vector<std::size_t> newHashes){
+    hashes = std::move(newHashes);
+    slots.clear();
+    if(hashes.empty()) return;
+    resizeFor(hashes.size());
+}
+
+std::size_t OpenHashIndex::hashAt(std::size_t position) const{
+    return hashes[position];
+}
+
+void OpenHashIndex::reserve(std::size_t count){
+    hashes.reserve(count);
+    if(slots.size() < count * 2) resizeFor(count);
+}
+
+void OpenHashIndex::clear(){
+    hashes.clear();
+    slots.clear();
+    shift = 64;
+}
+
+std::size_t OpenHashIndex::size() const{
+    return hashes.size();
+}
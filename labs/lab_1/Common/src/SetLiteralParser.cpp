@@ -0,0 +1,172 @@
+#include "SetLiteralParser.hpp"
+
+namespace {
+/**
+ * @brief Element being collected on one nesting level
+ *
+ */
+struct SpanBuilder{
+    std::size_t start = 0;
+    std::size_t end = 0;
+    bool open = false;
+    bool pendingSpace = false;
+    bool hasSpaces = false;
+
+    void begin(std::size_t position){
+        start = position;
+        end = position;
+        open = true;
+        pendingSpace = false;
+        hasSpaces = false;
+    }
+
+    void extend(std::size_t position){
+        if(!open) return;
+        if(pendingSpace) hasSpaces = true; // пробел внутри элемента, а не по краям
+        pendingSpace = false;
+        end = position + 1;
+    }
+
+    void space(){
+        if(open && end > start) pendingSpace = true;
+    }
+
+    void close(std::string_view literal, std::vector<ElementSpan>& out){
+        if(!open) return;
+        out.push_back({literal.substr(start, end - start), hasSpaces});
+        open = false;
+    }
+};
+}
+
+bool SetLiteralParser::isAtomChar(char symbol){
+    return (symbol >= '0' && symbol <= '9') || (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z');
+}
+
+bool SetLiteralParser::isValid(std::string_view literal){
+    std::vector<ElementSpan> elements;
+    return parse(literal, elements);
+}
+
+bool SetLiteralParser::isElement(std::string_view element){
+    std::size_t first = element.find_first_not_of(' ');
+    if(first == std::string_view::npos) return false;
+    std::size_t last = element.find_last_not_of(' ');
+    std::string_view text = element.substr(first, last - first + 1);
+    if(text.front() != '{'){
+        for(char c : text){
+            if(!isAtomChar(c)) return false; // атом - только буквы и цифры
+        }
+        return true;
+    }
+    int balance = 0;
+    for(std::size_t i = 0; i < text.size(); ++i){
+        if(text[i] == '{') balance++;
+        else if(text[i] == '}' && --balance == 0 && i + 1 != text.size()) return false; // первая скобка закрылась раньше конца
+    }
+    return isValid(text);
+}
+
+bool SetLiteralParser::parse(std::string_view literal, std::vector<ElementSpan>& elements){
+    elements.clear();
+    auto fail = [&elements](){
+        elements.clear(); // частично собранные элементы первой скобки не отдаем
+        return false;
+    };
+    std::vector<ElementSpan> outer;     // элементы верхнего уровня "a, b, {c}"
+    SpanBuilder outerSpan;
+    SpanBuilder innerSpan;              // элементы внутри первой скобки "{a, b}"
+    int balance = 0;
+    bool expectElement = true;
+    bool afterComma = false;
+    bool inToken = false;
+    bool inFirstGroup = false;
+    bool firstGroupClosed = false;
+    bool seenAnything = false;
+
+    for(std::size_t i = 0; i < literal.size(); ++i){
+        char c = literal[i];
+        if(c == ' '){
+            inToken = false;
+            outerSpan.space();
+            innerSpan.space();
+            continue;
+        }
+        if(c == '{'){
+            if(inToken || !expectElement) return fail();
+            if(balance == 0){
+                outerSpan.begin(i);
+                if(!seenAnything) inFirstGroup = true;
+            } else if(balance == 1 && inFirstGroup){
+                innerSpan.begin(i);
+            }
+            balance++;
+            expectElement = true;
+            afterComma = false;
+            outerSpan.extend(i);
+            innerSpan.extend(i);
+        }
+        else if(c == '}'){
+            inToken = false;
+            if(balance <= 0 || afterComma) return fail();
+            balance--;
+            expectElement = false;
+            afterComma = false;
+            outerSpan.extend(i);
+            if(balance == 0 && inFirstGroup){
+                innerSpan.close(literal, elements); // закрылась первая скобка
+                inFirstGroup = false;
+                firstGroupClosed = true;
+            } else {
+                innerSpan.extend(i);
+            }
+        }
+        else if(c == ','){
+            inToken = false;
+            if(expectElement || afterComma) return fail();
+            expectElement = true;
+            afterComma = true;
+            if(balance == 0){
+                outerSpan.close(literal, outer);
+            } else if(balance == 1 && inFirstGroup){
+                innerSpan.close(literal, elements);
+            } else {
+                outerSpan.extend(i);
+                innerSpan.extend(i);
+            }
+        }
+        else {
+            if(!isAtomChar(c)) return fail();
+            if(!inToken){
+                if(!expectElement) return fail();
+                if(balance == 0){
+                    outerSpan.begin(i);
+                } else if(balance == 1 && inFirstGroup){
+                    innerSpan.begin(i);
+                }
+                inToken = true;
+                expectElement = false;
+                afterComma = false;
+            }
+            outerSpan.extend(i);
+            innerSpan.extend(i);
+        }
+        seenAnything = true;
+    }
+    if(balance != 0 || expectElement || afterComma) return fail();
+    outerSpan.close(literal, outer);
+    // вся строка - одно множество в скобках: его элементы уже собраны в elements
+    if(outer.size() == 1 && firstGroupClosed) return true;
+    elements.swap(outer);
+    return true;
+}
+
+std::string SetLiteralParser::normalize(const ElementSpan& element){
+    if(!element.hasSpaces) return std::string(element.text);
+    std::string result;
+    result.reserve(element.text.size());
+    for(char c : element.text){
+        if(c != ' ') result += c;
+    }
+    return result;
+}
@@ -10,19 +10,59 @@
 
 #include <vector>
 #include <string>
+#include "SetLiteralParser.hpp"
+#include "OpenHashIndex.hpp"
 #include <utility>
 
 /**
  * @class MultiSet
  * @brief Class for working with multisets
  * 
- * Stores elements as strings with their counts.
+ * Stores elements as strings with their counts, a hash index over the elements
+ * makes count lookups and updates O(1) and multiset operations linear.
  * Supports multiset operations: union, 
  * intersection, difference, membership testing, 
  * and boolean creation
  */
 class MultiSet{
-    std::vector<std::pair<std::string, int>> elInMultiSet;
+    std::vector<std::pair<std::string, int>> elInMultiSet;  ///< Distinct elements with counts in insertion order (erase moves the last one into the gap)
+    OpenHashIndex countIndex;                               ///< Hash index over elInMultiSet
+    int cardinality = 0;                                    ///< Cached total count of all elements
+
+    /**
+     * @brief Private constant method to find the position of an element by its hash
+     * 
+     * @param element element to find
+     * @param hash hash of the element
+     * @return std::size_t position in elInMultiSet or OpenHashIndex::npos
+     */
+    std::size_t find(std::string_view element, std::size_t hash) const;
+
+    /**
+     * @brief Private method to increase the count of an element, adding it if absent
+     * 
+     * @param element already validated element
+     * @param hash hash of the element
+     * @param count value added to the count
+     */
+    void addCount(std::string_view element, std::size_t hash, int count);
+
+    /**
+     * @brief Private method to remove the element at the given position in O(1)
+     * 
+     * The last element is moved into the freed position.
+     * 
+     * @param position position in elInMultiSet
+     */
+    void eraseAt(std::size_t position);
+
+    /**
+     * @brief Private method to replace the contents with the given counts dropping non-positive ones
+     * 
+     * @param counts counts aligned with the current positions (may be elInMultiSet itself)
+     */
+    void compact(std::vector<std::pair<std::string, int>>& counts);
+
     /**
      * @brief Private method to add one element to a multiset
      * 
@@ -35,15 +75,17 @@ class MultiSet{
     bool add(const std::string& element);
 
     /**
-     * @brief Private method for parsing a string to bring it to the desired form
+     * @brief Private method to insert already validated elements in one bulk pass
+     * 
+     * Elements are taken as views into the parsed literal, a string is allocated
+     * only for the stored element itself, no per-element revalidation is done.
      * 
-     * @param &string constant reference of the string to parse
-     * @return std::vector<std::string> 
+     * @param elements constant reference to the vector of element spans
      */
-    std::vector<std::string> parseMultiSetString(const std::string& string);
+    void insertParsed(const std::vector<ElementSpan>& elements);
 
     /**
-     * @brief Private method to check if a string is valid
+     * @brief Private method to check if a string is valid (delegates to SetLiteralParser)
      * 
      * @param &string constant reference of the string being checked
      * @return true 
@@ -58,45 +100,6 @@ class MultiSet{
      */
     std::string toString() const;
 
-    /**
-     * @brief Private intermediate method to remove all 
-     * spaces in a string
-     * 
-     * @param &str constant reference of the image string to form the output 
-     * prototype string after removing spaces
-     * @return std::string 
-     */
-    std::string removeSpaces(const std::string& str);
-    
-    /**
-     * @brief Private method to validate element content (letters and digits only)
-     * 
-     * @param str string to validate
-     * @param start starting index of the element
-     * @return int end index of the element
-     */
-    int validateElement(const std::string& str, size_t start) const;
-    
-    /**
-     * @brief Private method to handle bracket characters
-     * 
-     * @param c current character
-     * @param balance reference to bracket balance counter
-     * @param expectElement reference to element expectation flag
-     * @param afterComma reference to comma flag
-     * @return bool true if valid, false otherwise
-     */
-    bool handleBracket(char c, int& balance, bool& expectElement, bool& afterComma) const;
-    
-    /**
-     * @brief Private method to handle comma character
-     * 
-     * @param expectElement reference to element expectation flag
-     * @param afterComma reference to comma flag
-     * @return bool true if valid, false otherwise
-     */
-    bool handleComma(bool& expectElement, bool& afterComma) const;
-    
     public:
     /**
      * @brief Construct a new MultiSet object
@@ -120,6 +123,10 @@ class MultiSet{
     /**
      * @brief Public method to remove an element from a multiset
      * 
+     * Removing the last occurrence is O(1): the last element takes the place of the removed
+     * one, so getElInMultiSet() and the output keep insertion order only up to that point.
+     * The same holds for removeAll().
+     * 
      * @param &element constant reference of the string to remove element from multiset
      * @return true 
      * @return false 
@@ -162,6 +169,16 @@ class MultiSet{
      */
     int getCount(const std::string& element) const;
 
+    /**
+     * @brief Public constant method to get the k most frequent elements
+     * 
+     * Elements with equal counts keep the order in which they were added.
+     * 
+     * @param k number of elements to return
+     * @return std::vector<std::pair<std::string, int>> elements with counts, most frequent first
+     */
+    std::vector<std::pair<std::string, int>> getMostFrequent(std::size_t k) const;
+
     /**
      * @brief Public constant method for determining whether a multiset is empty
      * 
@@ -179,7 +196,7 @@ class MultiSet{
 
     /**
      * @brief Constant method to get a constant reference to a vector 
-     * of elements with counts in a multiset
+     * of elements with counts in a multiset (insertion order, see remove() for how removal changes it)
      * 
      * @return const std::vector<std::pair<std::string, int>>& 
      */
@@ -200,6 +217,21 @@ class MultiSet{
      */
     MultiSet& operator = (const MultiSet& other);
 
+    /**
+     * @brief Move constructor, takes over elements and index without copying
+     * 
+     * @param other rvalue reference to the multiset being moved (left empty)
+     */
+    MultiSet(MultiSet&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator
+     * 
+     * @param other rvalue reference to the multiset being moved (left empty)
+     * @return MultiSet& 
+     */
+    MultiSet& operator = (MultiSet&& other) noexcept;
+
     /**
      * @brief Public operator for filling a multiset with a string
      * 
@@ -273,7 +305,16 @@ class MultiSet{
      * @param other constant reference to the multiset to unite with
      * @return MultiSet
      */
-    MultiSet operator + (const MultiSet& other);
+    MultiSet operator + (const MultiSet& other) const &;
+
+    /**
+     * @brief Public operator for union of two multisets when the left operand is a temporary,
+     * the result reuses its storage instead of copying it
+     * 
+     * @param other constant reference to the multiset to unite with
+     * @return MultiSet
+     */
+    MultiSet operator + (const MultiSet& other) &&;
 
     /**
      * @brief Public operator for intersection of two multisets
@@ -281,7 +322,16 @@ class MultiSet{
      * @param other constant reference to the multiset to intersect with
      * @return MultiSet
      */
-    MultiSet operator * (const MultiSet& other);
+    MultiSet operator * (const MultiSet& other) const &;
+
+    /**
+     * @brief Public operator for intersection of two multisets when the left operand is a temporary,
+     * the result reuses its storage instead of copying it
+     * 
+     * @param other constant reference to the multiset to intersect with
+     * @return MultiSet
+     */
+    MultiSet operator * (const MultiSet& other) &&;
 
     /**
      * @brief Public operator for intersection with assignment
@@ -305,7 +355,16 @@ class MultiSet{
      * @param other constant reference to the multiset to subtract
      * @return MultiSet
      */
-    MultiSet operator - (const MultiSet& other);
+    MultiSet operator - (const MultiSet& other) const &;
+
+    /**
+     * @brief Public operator for difference of two multisets when the left operand is a temporary,
+     * the result reuses its storage instead of copying it
+     * 
+     * @param other constant reference to the multiset to subtract
+     * @return MultiSet
+     */
+    MultiSet operator - (const MultiSet& other) &&;
 
     /**
      * @brief Friend operator for outputting multiset to output stream
@@ -1,154 +1,109 @@
 #include <iostream>
 #include <utility>
 #include <algorithm>
+#include <functional>
 #include "MultiSets.hpp"
 
 bool MultiSet::isValid(const std::string& str) const {
-    int balance = 0;
-    bool expectElement = true;
-    bool afterComma = false;
-    for (size_t i = 0; i < str.size(); ++i) {
-        char tmp = str[i];
-        if (tmp == ' ') continue;
-        if (tmp == '{' || tmp == '}') {
-            if (!handleBracket(tmp, balance, expectElement, afterComma)) {
-                return false;
-            }
-        } 
-        else if (tmp == ',') {
-            if (!handleComma(expectElement, afterComma)) {
-                return false;
-            }
-        } 
-        else {
-            if (!expectElement) return false;
-            int endIndex = validateElement(str, i);
-            if (endIndex == -1) return false;
-            i = endIndex - 1;
-            expectElement = false;
-            afterComma = false;
-        }
-    }
-    return (balance == 0) && !expectElement && !afterComma;
+    return SetLiteralParser::isValid(str);
 }
 
-int MultiSet::validateElement(const std::string& str, size_t start) const {
-    size_t j = start;
-    while (j < str.size() && str[j] != ' ' && str[j] != ',' && str[j] != '}') {
-        char symbol = str[j];
-        if (!(isdigit(symbol) || (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z'))) {
-            return -1;
-        }
-        j++;
-    }
-    return j;
-}
-
-bool MultiSet::handleBracket(char c, int& balance, bool& expectElement, bool& afterComma) const {
-    if (c == '{') {
-        if (!expectElement) return false;
-        balance++;
-        expectElement = true;
-        afterComma = false;
-    } 
-    else if (c == '}') {
-        if (balance <= 0 || afterComma) return false;
-        balance--;
-        expectElement = false;
-        afterComma = false;
-    }
-    return true;
+namespace {
+std::size_t hashOf(std::string_view element){
+    return std::hash<std::string_view>{}(element);
+}
 }
 
-bool MultiSet::handleComma(bool& expectElement, bool& afterComma) const {
-    if (expectElement || afterComma) return false;
-    expectElement = true;
-    afterComma = true;
-    return true;
+std::size_t MultiSet::find(std::string_view element, std::size_t hash) const{
+    return countIndex.find(hash, [this, element](std::size_t position){
+        return elInMultiSet[position].first == element;
+    });
+}
+
+void MultiSet::addCount(std::string_view element, std::size_t hash, int count){
+    std::size_t position = find(element, hash);
+    if(position != OpenHashIndex::npos){
+        elInMultiSet[position].second += count; // увеличиваем счетчик за O(1)
+    } else {
+        elInMultiSet.emplace_back(std::string(element), count);
+        countIndex.append(hash);
+    }
+    cardinality += count;
 }
 
-std::vector<std::string> MultiSet::parseMultiSetString(const std::string& string){
-    std::vector<std::string> elements;
-    if (!isValid(string)) return elements; // проверка валидности
-    std::string strWithoutSpace = removeSpaces(string);
-    //избавляемся от скобочек
-    if (strWithoutSpace.front() == '{' && strWithoutSpace.back() == '}') {
-        strWithoutSpace = strWithoutSpace.substr(1, strWithoutSpace.size() - 2);
+void MultiSet::eraseAt(std::size_t position){
+    cardinality -= elInMultiSet[position].second;
+    countIndex.erase(position);
+    if(position + 1 != elInMultiSet.size()){ // последний элемент переезжает на место удаленного
+        elInMultiSet[position] = std::move(elInMultiSet.back());
     }
-    int balance = 0;
-    std::string element;
-    for (char c : strWithoutSpace) {
-        if (c == '{') {
-            balance++;
-            element += c;
-        } else if (c == '}') {
-            balance--;
-            element += c;
-        } else if (c == ',' && balance == 0) {
-            // запятая разделяет элементы
-            elements.push_back(element);
-            element.clear();
+    elInMultiSet.pop_back();
+}
+
+void MultiSet::compact(std::vector<std::pair<std::string, int>>& counts){
+    std::vector<std::size_t> keptHashes;
+    keptHashes.reserve(counts.size());
+    std::size_t kept = 0;
+    cardinality = 0;
+    for(std::size_t i = 0; i < counts.size(); ++i){ // сдвигаем на месте, строки не копируются
+        if(counts[i].second <= 0) continue;
+        cardinality += counts[i].second;
+        keptHashes.push_back(countIndex.hashAt(i));
+        if(kept != i) counts[kept] = std::move(counts[i]);
+        kept++;
+    }
+    counts.resize(kept);
+    countIndex.rebuild(std::move(keptHashes));
+}
+
+void MultiSet::insertParsed(const std::vector<ElementSpan>& elements){
+    elInMultiSet.reserve(elInMultiSet.size() + elements.size());
+    for(const ElementSpan& element : elements){
+        if(element.hasSpaces){
+            std::string normalized = SetLiteralParser::normalize(element);
+            addCount(normalized, hashOf(normalized), 1);
         } else {
-            element += c;
+            addCount(element.text, hashOf(element.text), 1);
         }
     }
-    if (!element.empty()) {
-        elements.push_back(element); // last элемент
-    }
-    return elements;
 }
 
 bool MultiSet::add(const std::string& element){
     if(!isValid(element)) return false;
-    // Ищем элемент в мультимножестве
-    for(auto& pair : elInMultiSet) {
-        if(pair.first == element) {
-            pair.second++; // увеличиваем счетчик
-            return true;
-        }
-    }
-    // Если элемент не найден, добавляем новый с счетчиком 1
-    elInMultiSet.push_back(std::make_pair(element, 1));
+    addCount(element, hashOf(element), 1);
     return true;
 }
 
 bool MultiSet::remove(const std::string& element){
     if(!isValid(element)) return false;
-    for(auto it = elInMultiSet.begin(); it != elInMultiSet.end(); ++it){
-        if(it->first == element){
-            if(it->second > 1) {
-                it->second--; // уменьшаем счетчик
-            } else {
-                elInMultiSet.erase(it); // удаляем элемент полностью
-            }
-            return true;
-        }
+    std::size_t position = find(element, hashOf(element));
+    if(position == OpenHashIndex::npos) return false;
+    if(elInMultiSet[position].second > 1) {
+        elInMultiSet[position].second--; // уменьшаем счетчик
+        cardinality--;
+    } else {
+        eraseAt(position); // удаляем элемент полностью
     }
-    return false;
+    return true;
 }
 
 int MultiSet::removeAll(const std::string& element){
     if(!isValid(element)) return 0;
-    for(auto it = elInMultiSet.begin(); it != elInMultiSet.end(); ++it){
-        if(it->first == element){
-            int count = it->second;
-            elInMultiSet.erase(it);
-            return count;
-        }
-    }
-    return 0;
+    std::size_t position = find(element, hashOf(element));
+    if(position == OpenHashIndex::npos) return 0;
+    int count = elInMultiSet[position].second;
+    eraseAt(position);
+    return count;
 }
 
 void MultiSet::clear(){
     elInMultiSet.clear(); //чистим
+    countIndex.clear();
+    cardinality = 0;
 }
 
 int MultiSet::getCardinality() const{
-    int total = 0;
-    for(const auto& pair : elInMultiSet) {
-        total += pair.second;
-    }
-    return total; // общее количество всех элементов
+    return cardinality; // общее количество всех элементов
 }
 
 int MultiSet::getDistinctCount() const{
@@ -157,12 +112,26 @@ int MultiSet::getDistinctCount() const{
 
 int MultiSet::getCount(const std::string& element) const{
     if(!isValid(element)) return 0;
-    for(const auto& pair : elInMultiSet) {
-        if(pair.first == element) {
-            return pair.second;
-        }
+    std::size_t position = find(element, hashOf(element));
+    return position == OpenHashIndex::npos ? 0 : elInMultiSet[position].second;
+}
+
+std::vector<std::pair<std::string, int>> MultiSet::getMostFrequent(std::size_t k) const{
+    std::vector<std::size_t> positions(elInMultiSet.size());
+    for(std::size_t i = 0; i < positions.size(); ++i) positions[i] = i;
+    k = std::min(k, positions.size());
+    // при равных счетчиках раньше идет элемент, добавленный раньше
+    std::partial_sort(positions.begin(), positions.begin() + k, positions.end(),
+        [this](std::size_t a, std::size_t b){
+            if(elInMultiSet[a].second != elInMultiSet[b].second) return elInMultiSet[a].second > elInMultiSet[b].second;
+            return a < b;
+        });
+    std::vector<std::pair<std::string, int>> result;
+    result.reserve(k);
+    for(std::size_t i = 0; i < k; ++i){
+        result.push_back(elInMultiSet[positions[i]]);
     }
-    return 0;
+    return result;
 }
 
 bool MultiSet::isVoid() const{
@@ -211,36 +180,48 @@ std::string MultiSet::toString() const {
     return newStr;
 }
 
-std::string MultiSet::removeSpaces(const std::string& str) {
-    std::string newStr;
-    for (char c : str) {
-        if (c != ' ') newStr += c;
-    }
-    return newStr;
-}
-
 const std::vector<std::pair<std::string, int>>& MultiSet::getElInMultiSet() const{
     return elInMultiSet;
 }
 
 MultiSet::MultiSet(const MultiSet& other){
     elInMultiSet = other.elInMultiSet;
+    countIndex = other.countIndex;
+    cardinality = other.cardinality;
 }
 
 MultiSet& MultiSet::operator = (const MultiSet& other){
     if(this != &other){ // при A=A или B=B не будет
         elInMultiSet = other.elInMultiSet;
+        countIndex = other.countIndex;
+        cardinality = other.cardinality;
+    }
+    return *this;
+}
+
+MultiSet::MultiSet(MultiSet&& other) noexcept
+    : elInMultiSet(std::move(other.elInMultiSet)), countIndex(std::move(other.countIndex)),
+      cardinality(std::exchange(other.cardinality, 0)) {
+    other.elInMultiSet.clear(); // исходное мультимножество остается пустым и пригодным
+    other.countIndex.clear();
+}
+
+MultiSet& MultiSet::operator = (MultiSet&& other) noexcept{
+    if(this != &other){
+        elInMultiSet = std::move(other.elInMultiSet);
+        countIndex = std::move(other.countIndex);
+        cardinality = std::exchange(other.cardinality, 0);
+        other.elInMultiSet.clear();
+        other.countIndex.clear();
     }
     return *this;
 }
 
 MultiSet& MultiSet::operator = (const std::string& elements){
-    if(!isValid(elements)) return *this;
+    std::vector<ElementSpan> parsed;
+    if(!SetLiteralParser::parse(elements, parsed)) return *this; // проверка и разбор за один проход
     clear(); // перед заданием множество чистим
-    std::vector<std::string> parsed = parseMultiSetString(elements);
-    for(const std::string& elem : parsed){
-        add(elem);
-    }
+    insertParsed(parsed);
     return *this;
 }
 
@@ -250,15 +231,15 @@ MultiSet& MultiSet::operator = (const char* elements){
 
 bool MultiSet::operator == (const MultiSet& other){
     if(other.getDistinctCount() != this->getDistinctCount()) return false;
-    for(const auto& pair : other.getElInMultiSet()){
-        if(this->getCount(pair.first) != pair.second) return false;
+    for(std::size_t i = 0; i < other.elInMultiSet.size(); ++i){
+        std::size_t position = find(other.elInMultiSet[i].first, other.countIndex.hashAt(i));
+        if(position == OpenHashIndex::npos || elInMultiSet[position].second != other.elInMultiSet[i].second) return false;
     }
     return true;
 }
 
 bool MultiSet::operator [] (const std::string& isHere) const{
-    if(!isValid(isHere)) return false;
-    return getCount(isHere) > 0;
+    return getCount(isHere) > 0; // getCount сам проверяет валидность
 }
 
 bool MultiSet::operator [] (const char* isHere) const{
@@ -266,20 +247,22 @@ bool MultiSet::operator [] (const char* isHere) const{
 }
 
 MultiSet& MultiSet::operator += (const MultiSet& other){
-    for(const auto& pair : other.getElInMultiSet()){
-        for(int i = 0; i < pair.second; i++) {
-            add(pair.first);
-        }
+    if(this == &other){ // A += A - удваиваем счетчики
+        for(auto& pair : elInMultiSet) pair.second *= 2;
+        cardinality *= 2;
+        return *this;
+    }
+    elInMultiSet.reserve(elInMultiSet.size() + other.elInMultiSet.size());
+    for(std::size_t i = 0; i < other.elInMultiSet.size(); ++i){
+        addCount(other.elInMultiSet[i].first, other.countIndex.hashAt(i), other.elInMultiSet[i].second);
     }
     return *this;
 }
 
 MultiSet& MultiSet::operator += (const std::string& string){
-    if(!isValid(string)) return *this;
-    std::vector<std::string> parsed = parseMultiSetString(string);
-    for(const std::string& elem : parsed){
-        add(elem);
-    }
+    std::vector<ElementSpan> parsed;
+    if(!SetLiteralParser::parse(string, parsed)) return *this;
+    insertParsed(parsed);
     return *this;
 }
 
@@ -287,51 +270,63 @@ MultiSet& MultiSet::operator += (const char* elements){
     return *this += std::string(elements);
 }
 
-MultiSet MultiSet::operator + (const MultiSet& other){
+MultiSet MultiSet::operator + (const MultiSet& other) const &{
     MultiSet newSet = *this;
     newSet += other;
     return newSet;
 }
 
-MultiSet MultiSet::operator * (const MultiSet& other){
+MultiSet MultiSet::operator + (const MultiSet& other) &&{
+    *this += other; // временный левый операнд меняем на месте, без копии
+    return std::move(*this);
+}
+
+MultiSet MultiSet::operator * (const MultiSet& other) const &{
     MultiSet newSet = *this;
     newSet *= other;
     return newSet;
 }
 
+MultiSet MultiSet::operator * (const MultiSet& other) &&{
+    *this *= other; // временный левый операнд меняем на месте, без копии
+    return std::move(*this);
+}
+
 MultiSet& MultiSet::operator *= (const MultiSet& other){
-    std::vector<std::pair<std::string, int>> tempSet;
-    for(const auto& pair : elInMultiSet){
-        int otherCount = other.getCount(pair.first);
-        if(otherCount > 0) {
-            //минимум из двух счетчиков
-            int minCount = std::min(pair.second, otherCount);
-            tempSet.push_back(std::make_pair(pair.first, minCount));
-        }
+    if(this == &other) return *this;
+    for(std::size_t i = 0; i < elInMultiSet.size(); ++i){
+        std::size_t position = other.find(elInMultiSet[i].first, countIndex.hashAt(i));
+        int otherCount = position == OpenHashIndex::npos ? 0 : other.elInMultiSet[position].second;
+        elInMultiSet[i].second = std::min(elInMultiSet[i].second, otherCount); //минимум из двух счетчиков
     }
-    elInMultiSet = tempSet;
+    compact(elInMultiSet);
     return *this;
 }
 
 MultiSet& MultiSet::operator -= (const MultiSet& other){
-    std::vector<std::pair<std::string, int>> tempSet;
-    for(const auto& pair : elInMultiSet){
-        int otherCount = other.getCount(pair.first);
-        int newCount = pair.second - otherCount;
-        if(newCount > 0) {
-            tempSet.push_back(std::make_pair(pair.first, newCount));
-        }
+    if(this == &other){
+        clear();
+        return *this;
     }
-    elInMultiSet = tempSet;
+    for(std::size_t i = 0; i < elInMultiSet.size(); ++i){
+        std::size_t position = other.find(elInMultiSet[i].first, countIndex.hashAt(i));
+        if(position != OpenHashIndex::npos) elInMultiSet[i].second -= other.elInMultiSet[position].second;
+    }
+    compact(elInMultiSet);
     return *this;
 }
 
-MultiSet MultiSet::operator - (const MultiSet& other){
+MultiSet MultiSet::operator - (const MultiSet& other) const &{
     MultiSet newSet = *this;
     newSet -= other;
     return newSet;
 }
 
+MultiSet MultiSet::operator - (const MultiSet& other) &&{
+    *this -= other; // временный левый операнд меняем на месте, без копии
+    return std::move(*this);
+}
+
 std::ostream& operator<<(std::ostream& os, const MultiSet& set) {
     os << set.toString();
     return os;
@@ -340,11 +335,13 @@ std::ostream& operator<<(std::ostream& os, const MultiSet& set) {
 std::istream& operator>>(std::istream& is, MultiSet& set) {
     std::string line;
     std::getline(is, line); // считываем
-    if (!set.isValid(line)) { // проходит ли валидацию
+    std::vector<ElementSpan> parsed;
+    if (!SetLiteralParser::parse(line, parsed)) { // проходит ли валидацию
         is.setstate(std::ios::failbit); // выбрасываем ошибку
         return is;
     }
-    set = line;
+    set.clear();
+    set.insertParsed(parsed);
     return is;
 }
 
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <sstream>
 #include "MultiSets.hpp"
 
 // Конструкторы и базовые состояния
@@ -262,4 +263,90 @@ TEST(MultiSetSpecific, IntersectionWithRepeatedElements) { //33
     EXPECT_TRUE(result.getCount("b") == 1);
     EXPECT_TRUE(result.getCount("c") == 0);
     EXPECT_TRUE(result.getCount("d") == 0);
-}
\ No newline at end of file
+}
+// Разбор строки мультимножества
+TEST(MultiSetParsing, RepeatedNestedElementsWithSpacesAreCounted) { //34
+    MultiSet MultiSet;
+    MultiSet = "{ {a, b}, {a,b} , c, c, c }";
+    EXPECT_TRUE(MultiSet.getCount("{a,b}") == 2 && MultiSet.getCount("c") == 3);
+    EXPECT_TRUE(MultiSet.getDistinctCount() == 2);
+}
+
+TEST(MultiSetParsing, AppendingLiteralAddsCounts) { //35
+    MultiSet MultiSet;
+    MultiSet = "{a, b}";
+    MultiSet += "a, a, {b}";
+    MultiSet += "{a, }";
+    EXPECT_TRUE(MultiSet.getCount("a") == 3 && MultiSet.getCount("{b}") == 1);
+    EXPECT_TRUE(MultiSet.getCardinality() == 5);
+}
+
+// Счетчики и частотные запросы
+TEST(MultiSetCounts, MostFrequentElementsAreOrderedByCount) { //36
+    MultiSet MultiSet;
+    MultiSet = "{b, a, c, a, c, a, d, c, {x}}";
+    std::vector<std::pair<std::string, int>> top = MultiSet.getMostFrequent(3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(top[0], std::make_pair(std::string("a"), 3));
+    EXPECT_EQ(top[1], std::make_pair(std::string("c"), 3));
+    EXPECT_EQ(top[2], std::make_pair(std::string("b"), 1));
+    EXPECT_EQ(MultiSet.getMostFrequent(100).size(), 5u);
+}
+
+TEST(MultiSetCounts, OperationsKeepCardinalityConsistent) { //37
+    MultiSet MultiSetOne;
+    MultiSetOne = "{a, a, a, b, c}";
+    MultiSet MultiSetTwo;
+    MultiSetTwo = "{a, b, b, d}";
+    MultiSet difference = MultiSetOne - MultiSetTwo;
+    EXPECT_TRUE(difference.getCount("a") == 2 && !difference["b"] && difference.getCardinality() == 3);
+    MultiSetOne += MultiSetOne;
+    EXPECT_TRUE(MultiSetOne.getCount("a") == 6 && MultiSetOne.getCardinality() == 10);
+    MultiSetOne.removeAll("a");
+    MultiSetOne.remove("b");
+    EXPECT_TRUE(MultiSetOne.getCardinality() == 3 && MultiSetOne.getCount("b") == 1);
+}
+
+TEST(MultiSetCounts, LargeHistogramIsLinear) { //38
+    MultiSet histogram;
+    std::string literal = "{";
+    for (int i = 0; i < 300000; ++i) literal += "t" + std::to_string(i % 1000) + ",";
+    literal.back() = '}';
+    histogram = literal;
+    EXPECT_EQ(histogram.getDistinctCount(), 1000);
+    EXPECT_EQ(histogram.getCount("t999"), 300);
+    EXPECT_EQ((histogram * histogram).getCardinality(), 300000);
+}
+
+TEST(MultiSetCounts, RemoveAllKeepsIndexConsistent) { //39
+    MultiSet histogram;
+    std::string literal = "{";
+    for (int i = 0; i < 6000; ++i) literal += "t" + std::to_string(i % 2000) + ",";
+    literal.back() = '}';
+    histogram = literal;
+    for (int i = 0; i < 2000; i += 3) EXPECT_EQ(histogram.removeAll("t" + std::to_string(i)), 3);
+    for (int i = 0; i < 2000; ++i) EXPECT_EQ(histogram.getCount("t" + std::to_string(i)), i % 3 == 0 ? 0 : 3);
+    EXPECT_EQ(histogram.getCardinality(), histogram.getDistinctCount() * 3);
+}
+
+TEST(MultiSetCounts, RemoveMovesLastElementIntoPlace) { //40
+    MultiSet multiSet("{a, b, b, c, d, d, e}");
+    EXPECT_TRUE(multiSet.remove("a"));
+    EXPECT_EQ(multiSet.removeAll("b"), 2);
+    EXPECT_TRUE(multiSet.remove("d"));
+    std::vector<std::pair<std::string, int>> expected = {{"e", 1}, {"d", 1}, {"c", 1}};
+    EXPECT_EQ(multiSet.getElInMultiSet(), expected);
+    std::ostringstream out;
+    out << multiSet;
+    EXPECT_EQ(out.str(), "{e,d,c}");
+}
+
+TEST(MultiSetMove, MoveKeepsCountsAndEmptiesSource) { //41
+    MultiSet source("{a, a, b}");
+    MultiSet moved(std::move(source));
+    EXPECT_TRUE(moved.getCardinality() == 3 && moved.getCount("a") == 2);
+    EXPECT_TRUE(source.getCardinality() == 0 && !source["a"]);
+    source = "{c}";
+    MultiSet chained = std::move(source) + moved - MultiSet("{a}");
+    EXPECT_TRUE(chained.getCardinality() == 3 && chained.getCount("a") == 1 && chained["c"]);
+}
@@ -0,0 +1,172 @@
+/**
+ * @file ElementPool.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the ElementPool class - interning pool of set elements
+ * @version 0.1
+ * @date 2025-10-23
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Identifier of an interned element
+ *
+ */
+using ElementId = std::uint32_t;
+
+/**
+ * @class ElementPool
+ * @brief Interning pool that maps set elements to canonical identifiers
+ *
+ * Atoms are interned by their text, nested sets are hash-consed by the sorted
+ * and deduplicated list of identifiers of their elements. So {b,a}, {a,b} and {a,a,b}
+ * get the same identifier, equal substructures are stored once and equality of
+ * elements of any depth is an integer comparison.
+ * The pool is shared by all sets and is thread safe: lookups take a shared lock,
+ * interning of a new element an exclusive one. It never shrinks - an interned element
+ * stays until the end of the process, since any set may still hold its identifier;
+ * the number of distinct elements is bounded by the range of ElementId.
+ */
+class ElementPool{
+    /**
+     * @brief Interned element: either an atom or a set of interned elements
+     *
+     */
+    struct Node{
+        bool isSet;                         ///< True for nested sets
+        std::string_view atom;              ///< Text of an atom (view into atomTexts)
+        std::vector<ElementId> children;    ///< Sorted identifiers of set elements
+    };
+
+    /**
+     * @brief Hash of a sorted list of children identifiers
+     *
+     */
+    struct ChildrenHash{
+        std::size_t operator()(const std::vector<ElementId>& children) const;
+    };
+
+    mutable std::shared_mutex mutex;                                            ///< Guards all members below
+    std::deque<Node> nodes;                                                     ///< Nodes indexed by identifier, never move
+    std::deque<std::string> atomTexts;                                          ///< Stable storage of atom texts
+    std::unordered_map<std::string_view, ElementId> atoms;                      ///< Atom text to identifier
+    std::unordered_map<std::vector<ElementId>, ElementId, ChildrenHash> sets;   ///< Children to identifier
+
+    /**
+     * @brief Private static method to walk an element text building identifiers bottom-up
+     *
+     * @tparam Pool ElementPool to intern unknown parts or const ElementPool to fail on them
+     * @param pool pool being searched
+     * @param element element text (spaces are skipped)
+     * @param id reference receiving the identifier
+     * @return true if the identifier was found or created
+     * @return false if the element is malformed or (for a const pool) unknown
+     */
+    template <typename Pool>
+    static bool resolve(Pool& pool, std::string_view element, ElementId& id);
+
+    /**
+     * @brief Private method to create a node, called under the exclusive lock
+     *
+     * @param node node to add
+     * @return ElementId identifier of the node
+     * @throw std::length_error if all identifiers are used
+     */
+    ElementId addNode(Node node);
+
+    /**
+     * @brief Private constant method to append the canonical text of an element, called under a lock
+     *
+     * @param id identifier of the element
+     * @param result string receiving the text
+     */
+    void appendText(ElementId id, std::string& result) const;
+
+    public:
+    /**
+     * @brief Construct a new empty ElementPool object
+     *
+     */
+    ElementPool() = default;
+
+    ElementPool(const ElementPool&) = delete;
+    ElementPool& operator = (const ElementPool&) = delete;
+
+    /**
+     * @brief Public static method to get the pool shared by all sets
+     *
+     * @return ElementPool&
+     */
+    static ElementPool& instance();
+
+    /**
+     * @brief Public method to intern a valid element (atom or nested set)
+     *
+     * @param element element text, spaces are ignored
+     * @return ElementId
+     * @throw std::invalid_argument if the element is malformed
+     * @throw std::length_error if all identifiers are used
+     */
+    ElementId intern(std::string_view element);
+
+    /**
+     * @brief Public constant method to find an element without interning it
+     *
+     * @param element element text, spaces are ignored
+     * @param id reference receiving the identifier
+     * @return true if every part of the element is already interned
+     * @return false otherwise
+     */
+    bool lookup(std::string_view element, ElementId& id) const;
+
+    /**
+     * @brief Public method to intern a set given by identifiers of its elements
+     *
+     * @param children identifiers of elements, order and duplicates do not matter
+     * @return ElementId
+     * @throw std::length_error if all identifiers are used
+     */
+    ElementId internSet(std::vector<ElementId> children);
+
+    /**
+     * @brief Public constant method to check whether an identifier denotes a nested set
+     *
+     * @param id identifier of the element
+     * @return true
+     * @return false
+     */
+    bool isSet(ElementId id) const;
+
+    /**
+     * @brief Public constant method to get sorted identifiers of elements of a nested set
+     *
+     * @param id identifier of a nested set
+     * @return const std::vector<ElementId>& valid for the lifetime of the pool
+     */
+    const std::vector<ElementId>& getChildren(ElementId id) const;
+
+    /**
+     * @brief Public constant method to get the canonical text of an element
+     *
+     * @param id identifier of the element
+     * @return std::string
+     */
+    std::string toString(ElementId id) const;
+
+    /**
+     * @brief Public constant method to get the number of interned elements
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+};
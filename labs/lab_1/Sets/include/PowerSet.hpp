@@ -0,0 +1,178 @@
+/**
+ * @file PowerSet.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the lazy power set range used by Set::getSubsets
+ * @version 0.1
+ * @date 2025-10-22
+ *
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class Subset
+ * @brief One subset of a power set as a bitmask over a shared element table
+ *
+ * Bit i of the mask is set when the i-th element of the table belongs to the subset.
+ * The subset does not hold any strings of its own and only points to the table,
+ * so it must not outlive the PowerSetRange it came from.
+ */
+class Subset{
+    const std::vector<std::string>* table;  ///< Elements of the source set, owned by the range
+    std::uint64_t mask;                     ///< Bitmask of chosen elements
+
+    public:
+    /**
+     * @brief Construct a new Subset object
+     *
+     * @param table element table of the range
+     * @param mask bitmask of chosen elements
+     */
+    Subset(const std::vector<std::string>& table, std::uint64_t mask);
+
+    /**
+     * @brief Public constant method to get the bitmask of the subset
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t getMask() const;
+
+    /**
+     * @brief Public constant method to get the number of elements in the subset
+     *
+     * @return std::size_t
+     */
+    std::size_t getCardinality() const;
+
+    /**
+     * @brief Public constant method to check whether the i-th table element is in the subset
+     *
+     * @param index index of the element in the table
+     * @return true
+     * @return false
+     */
+    bool contains(std::size_t index) const;
+
+    /**
+     * @brief Public constant method to get the elements of the subset
+     *
+     * @return std::vector<std::string>
+     */
+    std::vector<std::string> getElements() const;
+
+    /**
+     * @brief Public constant method to convert the subset to a set string "{a,b}"
+     *
+     * @return std::string
+     */
+    std::string toString() const;
+};
+
+/**
+ * @class PowerSetRange
+ * @brief Lazy range over subsets of a set in Gray code order
+ *
+ * Nothing is materialised: the iterator keeps only the rank of the current subset,
+ * subset number r is gray(r) = r ^ (r >> 1), so neighbouring subsets differ by one element.
+ * The range can be split into independent chunks to be consumed in parallel.
+ * Sets of up to 63 elements are supported.
+ */
+class PowerSetRange{
+    std::shared_ptr<const std::vector<std::string>> table; ///< Elements of the source set
+    std::uint64_t first;                                   ///< Rank of the first subset of the range
+    std::uint64_t last;                                    ///< Rank after the last subset of the range
+
+    public:
+    /**
+     * @brief Largest number of elements whose power set can be enumerated
+     *
+     */
+    static constexpr std::size_t maxElements = 63;
+
+    /**
+     * @class Iterator
+     * @brief Input iterator over subsets of the range
+     *
+     */
+    class Iterator{
+        const PowerSetRange* range;
+        std::uint64_t rank;
+
+        public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Subset;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Subset;
+
+        /**
+         * @brief Construct a new Iterator object
+         *
+         * @param range range being iterated
+         * @param rank rank of the current subset
+         */
+        Iterator(const PowerSetRange* range, std::uint64_t rank);
+
+        /**
+         * @brief Public constant method to get the Gray code mask of the current subset
+         *
+         * @return std::uint64_t
+         */
+        std::uint64_t mask() const;
+
+        /**
+         * @brief Public constant method to get the index of the element toggled
+         * when moving from the previous subset to the current one
+         *
+         * @return std::size_t index of the element or PowerSetRange::maxElements for rank 0
+         */
+        std::size_t toggled() const;
+
+        Subset operator*() const;
+        Iterator& operator++();
+        Iterator operator++(int);
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const;
+    };
+
+    /**
+     * @brief Construct a range over all subsets of the given elements
+     *
+     * @param elements elements of the source set
+     * @throw std::length_error if there are more than maxElements elements
+     */
+    explicit PowerSetRange(std::vector<std::string> elements);
+
+    /**
+     * @brief Public constant method to get the number of subsets in the range
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t size() const;
+
+    /**
+     * @brief Public constant method to get the element table shared by all subsets
+     *
+     * @return const std::vector<std::string>&
+     */
+    const std::vector<std::string>& getElements() const;
+
+    /**
+     * @brief Public constant method to split the range into count parts and take one of them
+     *
+     * @param index index of the part, from 0 to count - 1
+     * @param count number of parts
+     * @return PowerSetRange
+     */
+    PowerSetRange chunk(std::size_t index, std::size_t count) const;
+
+    Iterator begin() const;
+    Iterator end() const;
+};
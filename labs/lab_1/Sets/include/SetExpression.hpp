@@ -0,0 +1,208 @@
+/**
+ * @file SetExpression.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of set expression templates - fused evaluation of chained set algebra
+ * @version 0.1
+ * @date 2025-10-26
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include "Sets.hpp"
+
+/**
+ * @namespace setexpr
+ * @brief Expression templates over Set
+ *
+ * setexpr::ref(a) + setexpr::ref(b) * setexpr::ref(c) - setexpr::ref(d) builds a tree of
+ * lightweight nodes instead of intermediate sets. Converting the tree to Set walks the
+ * elements of the leaves once, filtering them by membership predicates of the other
+ * operands, so only the result is allocated. Elements come out in the same order
+ * as with the ordinary operators. Operands are held by reference and must outlive the
+ * evaluation, an expression is meant to be converted to Set in the same full expression.
+ */
+namespace setexpr{
+
+/**
+ * @struct Expression
+ * @brief CRTP base of all expression nodes
+ *
+ * Every node provides contains(ElementId), sizeHint() and forEachMember(visitor),
+ * the visitor is called once with the identifier and the text of every element
+ * of the node, so the caller needs neither a membership check nor deduplication.
+ *
+ * @tparam Node type of the derived node
+ */
+template <typename Node>
+struct Expression{
+    const Node& self() const{
+        return static_cast<const Node&>(*this);
+    }
+};
+
+/**
+ * @class Ref
+ * @brief Leaf node referring to an existing set
+ *
+ */
+class Ref : public Expression<Ref>{
+    const SetStorage* storage;
+
+    public:
+    explicit Ref(const Set& set) : storage(&set.getStorage()) {}
+
+    bool contains(ElementId id) const{
+        return storage->contains(id);
+    }
+
+    std::size_t sizeHint() const{
+        return storage->size();
+    }
+
+    template <typename Visitor>
+    void forEachMember(Visitor&& visit) const{
+        const std::vector<ElementId>& ids = storage->identifiers();
+        const std::vector<std::string>& items = storage->items();
+        for(std::size_t i = 0; i < ids.size(); ++i){
+            visit(ids[i], items[i]);
+        }
+    }
+};
+
+/**
+ * @class Union
+ * @brief Node of the union: members of the left operand, then new members of the right one
+ *
+ */
+template <typename Left, typename Right>
+class Union : public Expression<Union<Left, Right>>{
+    Left left;
+    Right right;
+
+    public:
+    Union(const Left& left, const Right& right) : left(left), right(right) {}
+
+    bool contains(ElementId id) const{
+        return left.contains(id) || right.contains(id);
+    }
+
+    std::size_t sizeHint() const{
+        return left.sizeHint() + right.sizeHint();
+    }
+
+    template <typename Visitor>
+    void forEachMember(Visitor&& visit) const{
+        left.forEachMember(visit);
+        right.forEachMember([this, &visit](ElementId id, const std::string& element){
+            if(!left.contains(id)) visit(id, element); // уже выданные левым операндом пропускаем
+        });
+    }
+};
+
+/**
+ * @class Intersection
+ * @brief Node of the intersection: members of the left operand found in the right one
+ *
+ */
+template <typename Left, typename Right>
+class Intersection : public Expression<Intersection<Left, Right>>{
+    Left left;
+    Right right;
+
+    public:
+    Intersection(const Left& left, const Right& right) : left(left), right(right) {}
+
+    bool contains(ElementId id) const{
+        return left.contains(id) && right.contains(id);
+    }
+
+    std::size_t sizeHint() const{
+        return std::min(left.sizeHint(), right.sizeHint());
+    }
+
+    template <typename Visitor>
+    void forEachMember(Visitor&& visit) const{
+        left.forEachMember([this, &visit](ElementId id, const std::string& element){
+            if(right.contains(id)) visit(id, element); // порядок как у operator*: по левому операнду
+        });
+    }
+};
+
+/**
+ * @class Difference
+ * @brief Node of the difference: members of the left operand missing from the right one
+ *
+ */
+template <typename Left, typename Right>
+class Difference : public Expression<Difference<Left, Right>>{
+    Left left;
+    Right right;
+
+    public:
+    Difference(const Left& left, const Right& right) : left(left), right(right) {}
+
+    bool contains(ElementId id) const{
+        return left.contains(id) && !right.contains(id);
+    }
+
+    std::size_t sizeHint() const{
+        return left.sizeHint();
+    }
+
+    template <typename Visitor>
+    void forEachMember(Visitor&& visit) const{
+        left.forEachMember([this, &visit](ElementId id, const std::string& element){
+            if(!right.contains(id)) visit(id, element);
+        });
+    }
+};
+
+/**
+ * @brief Function to wrap a set into an expression leaf
+ *
+ * @param set constant reference to the set, must outlive the expression
+ * @return Ref
+ */
+inline Ref ref(const Set& set){
+    return Ref(set);
+}
+
+template <typename Left, typename Right>
+Union<Left, Right> operator + (const Expression<Left>& left, const Expression<Right>& right){
+    return Union<Left, Right>(left.self(), right.self());
+}
+
+template <typename Left, typename Right>
+Intersection<Left, Right> operator * (const Expression<Left>& left, const Expression<Right>& right){
+    return Intersection<Left, Right>(left.self(), right.self());
+}
+
+template <typename Left, typename Right>
+Difference<Left, Right> operator - (const Expression<Left>& left, const Expression<Right>& right){
+    return Difference<Left, Right>(left.self(), right.self());
+}
+
+/**
+ * @brief Function to evaluate an expression into a new set
+ *
+ * @param expression expression to evaluate
+ * @return Set
+ */
+template <typename Node>
+Set evaluate(const Expression<Node>& expression){
+    return Set(expression);
+}
+}
+
+template <typename Node>
+Set::Set(const setexpr::Expression<Node>& expression){
+    const Node& root = expression.self();
+    elInSet.reserve(root.sizeHint());
+    root.forEachMember([this](ElementId id, const std::string& element){
+        elInSet.insert(id, std::string(element)); // каждый элемент выдается один раз и уже проверен
+    });
+}
@@ -0,0 +1,217 @@
+/**
+ * @file SetStorage.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the SetStorage class - backing store of the Set class
+ * @version 0.1
+ * @date 2025-10-20
+ *
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "OpenHashIndex.hpp"
+#include "ElementPool.hpp"
+
+/**
+ * @brief Index used by the set storage for membership queries
+ *
+ */
+enum class StorageMode{
+    Hashed, ///< open addressing hash index over element identifiers, O(1) membership
+    Sorted  ///< positions sorted by element identifier, O(log n) membership
+};
+
+/**
+ * @class SetStorage
+ * @brief Backing store of the Set class
+ *
+ * Keeps elements in insertion order (this order is used for output; erasing moves the
+ * last element into the freed place) together with
+ * their identifiers from the shared ElementPool, and maintains an index over the
+ * identifiers chosen by StorageMode. Nested elements equal as sets ({a,b} and {b,a})
+ * share an identifier, so all comparisons inside the storage are integer ones.
+ * Union, intersection and difference are linear in the sizes of the operands.
+ */
+class SetStorage{
+    StorageMode mode;
+    std::vector<std::string> elements;          ///< Elements in insertion order (as first written)
+    std::vector<ElementId> ids;                 ///< Interned identifiers of elements
+    OpenHashIndex hashIndex;                    ///< Index for StorageMode::Hashed
+    std::vector<std::uint32_t> sortedOrder;     ///< Positions ordered by element for StorageMode::Sorted
+
+    /**
+     * @brief Private constant method to find the position of an element by its identifier
+     *
+     * @param id identifier of the element
+     * @return std::size_t position or OpenHashIndex::npos
+     */
+    std::size_t locate(ElementId id) const;
+
+    /**
+     * @brief Private constant method to find the place of an identifier in sortedOrder
+     *
+     * @param id identifier of the element
+     * @return std::vector<std::uint32_t>::const_iterator first position whose identifier is not less than id
+     */
+    std::vector<std::uint32_t>::const_iterator lowerBound(ElementId id) const;
+
+    /**
+     * @brief Private method to rebuild the index of the current mode from scratch
+     *
+     */
+    void rebuildIndex();
+
+    /**
+     * @brief Private method to keep only elements for which keep[position] is true
+     *
+     * @param keep flags of kept elements, one per position
+     */
+    void compact(const std::vector<char>& keep);
+
+    public:
+    /**
+     * @brief Construct a new empty SetStorage object
+     *
+     * @param mode index used for membership queries
+     */
+    explicit SetStorage(StorageMode mode = StorageMode::Hashed);
+
+    /**
+     * @brief Public constant method to get the current index mode
+     *
+     * @return StorageMode
+     */
+    StorageMode getMode() const;
+
+    /**
+     * @brief Public method to switch the index mode, the index is rebuilt in O(n log n) at most
+     *
+     * @param newMode new index mode
+     */
+    void setMode(StorageMode newMode);
+
+    /**
+     * @brief Public constant method to check whether an element is stored
+     *
+     * @param element element to check
+     * @return true
+     * @return false
+     */
+    bool contains(std::string_view element) const;
+
+    /**
+     * @brief Public constant method to check whether an element with the given identifier is stored
+     *
+     * @param id identifier of the element
+     * @return true
+     * @return false
+     */
+    bool contains(ElementId id) const;
+
+    /**
+     * @brief Public method to insert an element, the string is copied only if the element is new
+     *
+     * @param element element to insert (without spaces)
+     * @return true if the element was inserted
+     * @return false if the element is already stored
+     */
+    bool insert(std::string_view element);
+
+    /**
+     * @brief Public method to insert an element taking ownership of the string
+     *
+     * @param element element to insert (without spaces)
+     * @return true if the element was inserted
+     * @return false if the element is already stored
+     */
+    bool insert(std::string&& element);
+
+    /**
+     * @brief Public method to insert an already interned element
+     *
+     * @param id identifier of the element
+     * @param element text of the element used for output
+     * @return true if the element was inserted
+     * @return false if the element is already stored
+     */
+    bool insert(ElementId id, std::string&& element);
+
+    /**
+     * @brief Public method to erase an element
+     *
+     * The last element takes the place of the erased one: erasure is O(1) in StorageMode::Hashed
+     * and O(n) in StorageMode::Sorted, where sortedOrder is shifted.
+     *
+     * @param element element to erase
+     * @return true if the element was erased
+     * @return false if the element was not stored
+     */
+    bool erase(std::string_view element);
+
+    /**
+     * @brief Public method to add all elements of another storage (union)
+     *
+     * @param other storage whose elements are added
+     */
+    void unite(const SetStorage& other);
+
+    /**
+     * @brief Public method to keep only elements stored in another storage (intersection)
+     *
+     * @param other storage to intersect with
+     */
+    void intersect(const SetStorage& other);
+
+    /**
+     * @brief Public method to remove elements stored in another storage (difference)
+     *
+     * @param other storage to subtract
+     */
+    void subtract(const SetStorage& other);
+
+    /**
+     * @brief Public method to reserve space for the given number of elements
+     *
+     * @param count expected number of elements
+     */
+    void reserve(std::size_t count);
+
+    /**
+     * @brief Public method to remove all elements
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Public constant method to get the number of elements
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Public constant method to check whether the storage is empty
+     *
+     * @return true
+     * @return false
+     */
+    bool empty() const;
+
+    /**
+     * @brief Public constant method to get elements in insertion order
+     *
+     * @return const std::vector<std::string>&
+     */
+    const std::vector<std::string>& items() const;
+
+    /**
+     * @brief Public constant method to get identifiers of elements in insertion order
+     *
+     * @return const std::vector<ElementId>&
+     */
+    const std::vector<ElementId>& identifiers() const;
+};
@@ -8,20 +8,31 @@
  * 
  */
 
+#pragma once
+#include <cstdint>
 #include <vector>
 #include <string>
+#include "SetLiteralParser.hpp"
+#include "SetStorage.hpp"
+#include "PowerSet.hpp"
+
+namespace setexpr{
+template <typename Node> struct Expression;
+}
 
 /**
  * @class Set
  * @brief Class for working with sets
  * 
- * Stores elements as strings.
+ * Stores elements as strings in a SetStorage with a hash (or sorted) index
+ * over interned element identifiers, so membership testing is O(1), set operations
+ * are linear and nested elements are compared as sets ({a,b} equals {b,a}).
  * Supports set operations: union, 
  * intersection, difference, membership testing, 
  * and boolean creation
  */
 class Set{
-    std::vector<std::string> elInSet;
+    SetStorage elInSet;
     /**
      * @brief Private method to add one element to a set
      * 
@@ -34,15 +45,17 @@ class Set{
     bool add(const std::string& element);
 
     /**
-     * @brief Private method for parsing a string to bring it to the desired form
+     * @brief Private method to insert already validated elements in one bulk pass
+     * 
+     * Elements are taken as views into the parsed literal, a string is allocated
+     * only for the stored element itself, no per-element revalidation is done.
      * 
-     * @param &string constant reference of the string to parse
-     * @return std::vector<std::string> 
+     * @param elements constant reference to the vector of element spans
      */
-    std::vector<std::string> parseSetString(const std::string& string);
+    void insertParsed(const std::vector<ElementSpan>& elements);
 
     /**
-     * @brief Private method to check if a string is valid
+     * @brief Private method to check if a string is valid (delegates to SetLiteralParser)
      * 
      * @param &string constant reference of the string being checked
      * @return true 
@@ -57,51 +70,25 @@ class Set{
      */
     std::string toString() const;
 
+    public:
     /**
-     * @brief Private intermediate method to remove all 
-     * spaces in a string
-     * 
-     * @param &str constant reference of the image string to form the output 
-     * prototype string after removing spaces
-     * @return std::string 
-     */
-    std::string removeSpaces(const std::string& str);
-    
-    /**
-     * @brief Private method to validate element content (letters and digits only)
-     * 
-     * @param str string to validate
-     * @param start starting index of the element
-     * @return int end index of the element
-     */
-    int validateElement(const std::string& str, size_t start) const;
-    
-    /**
-     * @brief Private method to handle bracket characters
-     * 
-     * @param c current character
-     * @param balance reference to bracket balance counter
-     * @param expectElement reference to element expectation flag
-     * @param afterComma reference to comma flag
-     * @return bool true if valid, false otherwise
+     * @brief Largest number of subsets getBoolean() materialises
+     *
      */
-    bool handleBracket(char c, int& balance, bool& expectElement, bool& afterComma) const;
-    
+    static constexpr std::uint64_t maxBooleanSubsets = std::uint64_t(1) << 24;
+
     /**
-     * @brief Private method to handle comma character
+     * @brief Construct a new Set object
      * 
-     * @param expectElement reference to element expectation flag
-     * @param afterComma reference to comma flag
-     * @return bool true if valid, false otherwise
      */
-    bool handleComma(bool& expectElement, bool& afterComma) const;
-    
-    public:
+    Set();
+
     /**
-     * @brief Construct a new Set object
+     * @brief Construct a new empty Set object with the given storage index
      * 
+     * @param mode index used for membership queries
      */
-    Set();
+    explicit Set(StorageMode mode);
 
     /**
      * @brief Construct a new Set object
@@ -119,6 +106,9 @@ class Set{
     /**
      * @brief Public method to remove an element from a set
      * 
+     * Removal is O(1): the last element takes the place of the removed one, so the order
+     * of getElInSet() and of the output is insertion order only up to the first removal.
+     * 
      * @param &element constant reference of the string to remove element from set
      * @return true 
      * @return false 
@@ -138,6 +128,20 @@ class Set{
      */
     int getCardinality() const;
 
+    /**
+     * @brief Public constant method to get the index used by the set storage
+     * 
+     * @return StorageMode 
+     */
+    StorageMode getStorageMode() const;
+
+    /**
+     * @brief Public method to switch the index used by the set storage
+     * 
+     * @param mode new index mode
+     */
+    void setStorageMode(StorageMode mode);
+
     /**
      * @brief Public constant method for determining whether a set is empty
      * 
@@ -149,18 +153,61 @@ class Set{
     /**
      * @brief Public method for creating a boolean from a set
      * 
-     * @return Set 
+     * Materialises every subset, use getSubsets() or the guarded overload for large sets.
+     * 
+     * @return Set
+     * @throw std::length_error if the boolean would have more than maxBooleanSubsets subsets
+     * (more than 24 elements), checked before anything is built
      */
     Set getBoolean();
 
+    /**
+     * @brief Public constant method for creating a boolean with a guard on its size
+     * 
+     * @param result reference to the set receiving the boolean
+     * @param maxSubsets largest number of subsets that may be materialised
+     * @return true if the boolean was built
+     * @return false if it would contain more than maxSubsets subsets (result is left unchanged)
+     */
+    bool getBoolean(Set& result, std::uint64_t maxSubsets) const;
+
+    /**
+     * @brief Public constant method to get a lazy range over all subsets of the set
+     * 
+     * Subsets are produced in Gray code order as bitmasks over a snapshot of the elements,
+     * the range can be split with PowerSetRange::chunk for parallel processing.
+     * 
+     * @return PowerSetRange 
+     * @throw std::length_error if the set has more than PowerSetRange::maxElements elements
+     */
+    PowerSetRange getSubsets() const;
+
     /**
      * @brief Constant method to get a constant reference to a string vector 
-     * of elements in a set
+     * of elements in a set (insertion order, see remove() for how removal changes it)
      * 
      * @return const std::vector<std::string>& 
      */
     const std::vector<std::string>& getElInSet() const;
 
+    /**
+     * @brief Constant method to get the backing storage (used by setexpr to read identifiers)
+     * 
+     * @return const SetStorage& 
+     */
+    const SetStorage& getStorage() const;
+
+    /**
+     * @brief Construct a new Set object by evaluating a set expression in one pass
+     * 
+     * Defined in SetExpression.hpp, e.g. Set result = setexpr::ref(a) + setexpr::ref(b) * setexpr::ref(c);
+     * 
+     * @tparam Node type of the root node of the expression
+     * @param expression expression to evaluate
+     */
+    template <typename Node>
+    Set(const setexpr::Expression<Node>& expression);
+
     /**
      * @brief Copy constructor
      * 
@@ -176,6 +223,21 @@ class Set{
      */
     Set& operator = (const Set& other);
 
+    /**
+     * @brief Move constructor, takes over the storage without copying elements
+     * 
+     * @param other rvalue reference to the set being moved (left empty)
+     */
+    Set(Set&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator
+     * 
+     * @param other rvalue reference to the set being moved (left empty)
+     * @return Set& 
+     */
+    Set& operator = (Set&& other) noexcept;
+
     /**
      * @brief Public operator for filling a set with a string
      * 
@@ -249,7 +311,16 @@ class Set{
      * @param other constant reference to the set to unite with
      * @return Set
      */
-    Set operator + (const Set& other);
+    Set operator + (const Set& other) const &;
+
+    /**
+     * @brief Public operator for union of two sets when the left operand is a temporary,
+     * the result reuses its storage instead of copying it
+     * 
+     * @param other constant reference to the set to unite with
+     * @return Set
+     */
+    Set operator + (const Set& other) &&;
 
     /**
      * @brief Public operator for intersection of two sets
@@ -257,7 +328,16 @@ class Set{
      * @param other constant reference to the set to intersect with
      * @return Set
      */
-    Set operator * (const Set& other);
+    Set operator * (const Set& other) const &;
+
+    /**
+     * @brief Public operator for intersection of two sets when the left operand is a temporary,
+     * the result reuses its storage instead of copying it
+     * 
+     * @param other constant reference to the set to intersect with
+     * @return Set
+     */
+    Set operator * (const Set& other) &&;
 
     /**
      * @brief Public operator for intersection with assignment
@@ -281,7 +361,16 @@ class Set{
      * @param other constant reference to the set to subtract
      * @return Set
      */
-    Set operator - (const Set& other);
+    Set operator - (const Set& other) const &;
+
+    /**
+     * @brief Public operator for difference of two sets when the left operand is a temporary,
+     * the result reuses its storage instead of copying it
+     * 
+     * @param other constant reference to the set to subtract
+     * @return Set
+     */
+    Set operator - (const Set& other) &&;
 
     /**
      * @brief Friend operator for outputting set to output stream
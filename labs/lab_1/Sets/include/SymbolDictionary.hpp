@@ -0,0 +1,95 @@
+/**
+ * @file SymbolDictionary.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the SymbolDictionary class - universe of elements for UniverseSet
+ * @version 0.1
+ * @date 2025-10-24
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "ElementPool.hpp"
+
+/**
+ * @class SymbolDictionary
+ * @brief Dense numbering of the elements of a bounded universe
+ *
+ * Every element of the universe gets a bit number 0..size()-1. Elements are
+ * identified through the shared ElementPool, so nested elements written in a
+ * different order get the same bit. A frozen dictionary rejects new elements.
+ */
+class SymbolDictionary{
+    std::vector<ElementId> symbols;                     ///< Element identifier of every bit
+    std::unordered_map<ElementId, std::size_t> bits;    ///< Bit number of every element identifier
+    bool frozen;                                        ///< True if the universe may not grow
+
+    public:
+    /**
+     * @brief Construct a new empty SymbolDictionary object
+     *
+     */
+    SymbolDictionary();
+
+    /**
+     * @brief Construct a new SymbolDictionary object from a set literal listing the universe
+     *
+     * @param universe set literal with all elements of the universe, e.g. "{a, b, {c, d}}"
+     */
+    explicit SymbolDictionary(const std::string& universe);
+
+    /**
+     * @brief Public method to get the bit of an element, adding it to the universe if needed
+     *
+     * @param element valid element text
+     * @param bit reference receiving the bit number
+     * @return true if the element belongs (or was added) to the universe
+     * @return false if the element is new and the dictionary is frozen
+     */
+    bool add(std::string_view element, std::size_t& bit);
+
+    /**
+     * @brief Public constant method to get the bit of an element without adding it
+     *
+     * @param element element text
+     * @param bit reference receiving the bit number
+     * @return true if the element belongs to the universe
+     * @return false otherwise
+     */
+    bool find(std::string_view element, std::size_t& bit) const;
+
+    /**
+     * @brief Public constant method to get the canonical text of the element of a bit
+     *
+     * @param bit bit number
+     * @return std::string
+     */
+    std::string symbol(std::size_t bit) const;
+
+    /**
+     * @brief Public constant method to get the size of the universe
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Public method to forbid or allow growing the universe
+     *
+     * @param value true to freeze the dictionary
+     */
+    void setFrozen(bool value);
+
+    /**
+     * @brief Public constant method to check whether the dictionary is frozen
+     *
+     * @return true
+     * @return false
+     */
+    bool isFrozen() const;
+};
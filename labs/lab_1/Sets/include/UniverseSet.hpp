@@ -0,0 +1,161 @@
+/**
+ * @file UniverseSet.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the UniverseSet class - dense bitset representation of sets over a bounded universe
+ * @version 0.1
+ * @date 2025-10-24
+ *
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+#include "SymbolDictionary.hpp"
+
+class Set;
+
+/**
+ * @class UniverseSet
+ * @brief Set stored as a dense bitset over a shared SymbolDictionary
+ *
+ * Bit i is set when the i-th element of the dictionary belongs to the set.
+ * Union, intersection and difference are word-parallel OR / AND / ANDNOT
+ * (AVX2 if the CPU supports it, chosen at run time, otherwise SSE2 on x86-64),
+ * cardinality is a popcount.
+ * Strings are produced only when converting to Set or printing.
+ * Operands of binary operations must share the same dictionary.
+ */
+class UniverseSet{
+    std::shared_ptr<SymbolDictionary> dictionary;   ///< Universe of the set
+    std::vector<std::uint64_t> words;               ///< Bits of the set, 64 elements per word
+
+    /**
+     * @brief Private method to make sure the bit of the given number exists
+     *
+     * @param bit bit number
+     */
+    void ensureBit(std::size_t bit);
+
+    /**
+     * @brief Private constant method to check that another set uses the same dictionary
+     *
+     * @param other set being checked
+     * @throw std::invalid_argument if dictionaries differ
+     */
+    void checkUniverse(const UniverseSet& other) const;
+
+    public:
+    /**
+     * @brief Construct a new empty UniverseSet object
+     *
+     * @param dictionary universe of the set
+     */
+    explicit UniverseSet(std::shared_ptr<SymbolDictionary> dictionary);
+
+    /**
+     * @brief Construct a new UniverseSet object from a set literal
+     *
+     * @param dictionary universe of the set
+     * @param elements set literal
+     */
+    UniverseSet(std::shared_ptr<SymbolDictionary> dictionary, const std::string& elements);
+
+    /**
+     * @brief Construct a new UniverseSet object from a Set
+     *
+     * @param dictionary universe of the set
+     * @param set set being converted
+     */
+    UniverseSet(std::shared_ptr<SymbolDictionary> dictionary, const Set& set);
+
+    /**
+     * @brief Public method to add one element
+     *
+     * @param element constant reference to the element
+     * @return true if the element was added
+     * @return false if it is invalid, already present or outside a frozen universe
+     */
+    bool add(const std::string& element);
+
+    /**
+     * @brief Public method to remove one element
+     *
+     * @param element constant reference to the element
+     * @return true
+     * @return false
+     */
+    bool remove(const std::string& element);
+
+    /**
+     * @brief Public method to clear the set
+     *
+     */
+    void clear();
+
+    /**
+     * @brief Public constant method for getting the cardinality of the set (popcount)
+     *
+     * @return int
+     */
+    int getCardinality() const;
+
+    /**
+     * @brief Public constant method for determining whether the set is empty
+     *
+     * @return true
+     * @return false
+     */
+    bool isVoid() const;
+
+    /**
+     * @brief Public constant method to get the dictionary of the set
+     *
+     * @return const std::shared_ptr<SymbolDictionary>&
+     */
+    const std::shared_ptr<SymbolDictionary>& getDictionary() const;
+
+    /**
+     * @brief Public constant method to convert the set to the string form
+     *
+     * @return Set
+     */
+    Set toSet() const;
+
+    /**
+     * @brief Public constant method to convert the set to a set literal
+     *
+     * @return std::string
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Public operator for filling the set with a literal
+     *
+     * @param elements set literal, the set is unchanged if it is invalid or
+     * contains elements outside a frozen universe
+     * @return UniverseSet&
+     */
+    UniverseSet& operator = (const std::string& elements);
+
+    bool operator == (const UniverseSet& other) const;
+    bool operator [] (const std::string& isHere) const;
+    UniverseSet& operator += (const UniverseSet& other);
+    UniverseSet& operator *= (const UniverseSet& other);
+    UniverseSet& operator -= (const UniverseSet& other);
+    UniverseSet operator + (const UniverseSet& other) const;
+    UniverseSet operator * (const UniverseSet& other) const;
+    UniverseSet operator - (const UniverseSet& other) const;
+
+    /**
+     * @brief Friend operator for outputting the set to output stream
+     *
+     * @param os reference to output stream
+     * @param set constant reference to the set to output
+     * @return std::ostream&
+     */
+    friend std::ostream& operator<<(std::ostream& os, const UniverseSet& set);
+};
@@ -0,0 +1,159 @@
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include "ElementPool.hpp"
+#include "SetLiteralParser.hpp"
+
+std::size_t ElementPool::ChildrenHash::operator()(const std::vector<ElementId>& children) const{
+    std::size_t hash = children.size();
+    for(ElementId id : children){
+        hash ^= id + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+ElementPool& ElementPool::instance(){
+    static ElementPool pool;
+    return pool;
+}
+
+template <typename Pool>
+bool ElementPool::resolve(Pool& pool, std::string_view element, ElementId& id){
+    constexpr bool insert = !std::is_const<Pool>::value;
+    // стек незакрытых множеств: снизу вверх собираем идентификаторы вложенных элементов
+    std::vector<std::vector<ElementId>> open;
+    bool haveResult = false;
+    for(std::size_t i = 0; i < element.size(); ++i){
+        char c = element[i];
+        if(c == ' ' || c == ',') continue;
+        ElementId current;
+        if(c == '{'){
+            open.emplace_back();
+            continue;
+        }
+        if(c == '}'){
+            if(open.empty()) return false;
+            std::vector<ElementId> children = std::move(open.back());
+            open.pop_back();
+            std::sort(children.begin(), children.end());
+            children.erase(std::unique(children.begin(), children.end()), children.end());
+            auto found = pool.sets.find(children);
+            if(found != pool.sets.end()){
+                current = found->second;
+            } else {
+                if constexpr (insert){
+                    current = pool.addNode({true, std::string_view(), children});
+                    pool.sets.emplace(std::move(children), current);
+                } else {
+                    return false;
+                }
+            }
+        } else {
+            std::size_t end = i;
+            while(end < element.size() && SetLiteralParser::isAtomChar(element[end])) end++;
+            if(end == i) return false;
+            std::string_view atom = element.substr(i, end - i);
+            i = end - 1;
+            auto found = pool.atoms.find(atom);
+            if(found != pool.atoms.end()){
+                current = found->second;
+            } else {
+                if constexpr (insert){
+                    std::string_view stored = pool.atomTexts.emplace_back(atom); // атом хранится один раз
+                    current = pool.addNode({false, stored, {}});
+                    pool.atoms.emplace(stored, current);
+                } else {
+                    return false;
+                }
+            }
+        }
+        if(open.empty()){
+            if(haveResult) return false; // на верхнем уровне должен быть ровно один элемент
+            id = current;
+            haveResult = true;
+        } else {
+            open.back().push_back(current);
+        }
+    }
+    return haveResult && open.empty();
+}
+
+ElementId ElementPool::addNode(Node node){
+    if(nodes.size() > std::numeric_limits<ElementId>::max()){
+        throw std::length_error("ElementPool: too many distinct elements");
+    }
+    nodes.push_back(std::move(node));
+    return static_cast<ElementId>(nodes.size() - 1);
+}
+
+ElementId ElementPool::intern(std::string_view element){
+    ElementId id;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex); // обычно элемент уже известен
+        if(resolve(*static_cast<const ElementPool*>(this), element, id)) return id;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if(!resolve(*this, element, id)){
+        throw std::invalid_argument("ElementPool: malformed element " + std::string(element));
+    }
+    return id;
+}
+
+bool ElementPool::lookup(std::string_view element, ElementId& id) const{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return resolve(*this, element, id);
+}
+
+ElementId ElementPool::internSet(std::vector<ElementId> children){
+    std::sort(children.begin(), children.end());
+    children.erase(std::unique(children.begin(), children.end()), children.end());
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        auto found = sets.find(children);
+        if(found != sets.end()) return found->second;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto found = sets.find(children); // мог добавить другой поток
+    if(found != sets.end()) return found->second;
+    ElementId id = addNode({true, std::string_view(), children});
+    sets.emplace(std::move(children), id);
+    return id;
+}
+
+bool ElementPool::isSet(ElementId id) const{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return nodes[id].isSet;
+}
+
+const std::vector<ElementId>& ElementPool::getChildren(ElementId id) const{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return nodes[id].children; // узлы deque не перемещаются и не меняются
+}
+
+std::string ElementPool::toString(ElementId id) const{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::string result;
+    appendText(id, result);
+    return result;
+}
+
+void ElementPool::appendText(ElementId id, std::string& result) const{
+    const Node& node = nodes[id];
+    if(!node.isSet){
+        result += node.atom;
+        return;
+    }
+    result += '{';
+    for(std::size_t i = 0; i < node.children.size(); ++i){
+        if(i != 0) result += ',';
+        appendText(node.children[i], result);
+    }
+    result += '}';
+}
+
+std::size_t ElementPool::size() const{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return nodes.size();
+}
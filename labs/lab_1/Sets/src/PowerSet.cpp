@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <stdexcept>
+#include "PowerSet.hpp"
+
+namespace {
+std::uint64_t grayCode(std::uint64_t rank){
+    return rank ^ (rank >> 1);
+}
+
+std::size_t countBits(std::uint64_t mask){
+    std::size_t count = 0;
+    for(; mask != 0; mask &= mask - 1) count++;
+    return count;
+}
+
+std::size_t lowestBit(std::uint64_t mask){
+    std::size_t index = 0;
+    while((mask & 1) == 0){
+        mask >>= 1;
+        index++;
+    }
+    return index;
+}
+}
+
+Subset::Subset(const std::vector<std::string>& table, std::uint64_t mask)
+    : table(&table), mask(mask) {}
+
+std::uint64_t Subset::getMask() const{
+    return mask;
+}
+
+std::size_t Subset::getCardinality() const{
+    return countBits(mask);
+}
+
+bool Subset::contains(std::size_t index) const{
+    return index < table->size() && (mask >> index) & 1;
+}
+
+std::vector<std::string> Subset::getElements() const{
+    std::vector<std::string> result;
+    result.reserve(getCardinality());
+    for(std::uint64_t rest = mask; rest != 0; rest &= rest - 1){
+        result.push_back((*table)[lowestBit(rest)]);
+    }
+    return result;
+}
+
+std::string Subset::toString() const{
+    std::size_t length = 2;
+    for(std::uint64_t rest = mask; rest != 0; rest &= rest - 1){
+        length += (*table)[lowestBit(rest)].size() + 1;
+    }
+    std::string result;
+    result.reserve(length); // одна аллокация на подмножество
+    result += '{';
+    for(std::uint64_t rest = mask; rest != 0; rest &= rest - 1){
+        if(result.size() > 1) result += ',';
+        result += (*table)[lowestBit(rest)];
+    }
+    result += '}';
+    return result;
+}
+
+PowerSetRange::Iterator::Iterator(const PowerSetRange* range, std::uint64_t rank) : range(range), rank(rank) {}
+
+std::uint64_t PowerSetRange::Iterator::mask() const{
+    return grayCode(rank);
+}
+
+std::size_t PowerSetRange::Iterator::toggled() const{
+    if(rank == 0) return PowerSetRange::maxElements;
+    return lowestBit(rank); // gray(r) и gray(r - 1) отличаются младшим единичным битом r
+}
+
+Subset PowerSetRange::Iterator::operator*() const{
+    return Subset(*range->table, mask()); // без копии shared_ptr: потоки не делят счетчик ссылок
+}
+
+PowerSetRange::Iterator& PowerSetRange::Iterator::operator++(){
+    rank++;
+    return *this;
+}
+
+PowerSetRange::Iterator PowerSetRange::Iterator::operator++(int){
+    Iterator previous = *this;
+    rank++;
+    return previous;
+}
+
+bool PowerSetRange::Iterator::operator==(const Iterator& other) const{
+    return rank == other.rank;
+}
+
+bool PowerSetRange::Iterator::operator!=(const Iterator& other) const{
+    return rank != other.rank;
+}
+
+PowerSetRange::PowerSetRange(std::vector<std::string> elements){
+    if(elements.size() > maxElements){
+        throw std::length_error("PowerSetRange: too many elements to enumerate subsets");
+    }
+    last = std::uint64_t(1) << elements.size();
+    first = 0;
+    table = std::make_shared<const std::vector<std::string>>(std::move(elements));
+}
+
+std::uint64_t PowerSetRange::size() const{
+    return last - first;
+}
+
+const std::vector<std::string>& PowerSetRange::getElements() const{
+    return *table;
+}
+
+PowerSetRange PowerSetRange::chunk(std::size_t index, std::size_t count) const{
+    PowerSetRange part = *this;
+    if(count == 0 || index >= count){
+        part.first = part.last; // пустой кусок
+        return part;
+    }
+    std::uint64_t total = size();
+    std::uint64_t step = total / count;
+    std::uint64_t extra = total % count;
+    // первые extra кусков на один элемент длиннее
+    part.first = first + step * index + std::min<std::uint64_t>(index, extra);
+    part.last = part.first + step + (index < extra ? 1 : 0);
+    return part;
+}
+
+PowerSetRange::Iterator PowerSetRange::begin() const{
+    return Iterator(this, first);
+}
+
+PowerSetRange::Iterator PowerSetRange::end() const{
+    return Iterator(this, last);
+}
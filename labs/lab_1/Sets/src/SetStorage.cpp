@@ -0,0 +1,216 @@
+#include <algorithm>
+#include "SetStorage.hpp"
+
+SetStorage::SetStorage(StorageMode mode) : mode(mode) {}
+
+StorageMode SetStorage::getMode() const{
+    return mode;
+}
+
+void SetStorage::setMode(StorageMode newMode){
+    if(mode == newMode) return;
+    mode = newMode;
+    rebuildIndex();
+}
+
+std::vector<std::uint32_t>::const_iterator SetStorage::lowerBound(ElementId id) const{
+    return std::lower_bound(sortedOrder.begin(), sortedOrder.end(), id,
+        [this](std::uint32_t position, ElementId value){
+            return ids[position] < value;
+        });
+}
+
+std::size_t SetStorage::locate(ElementId id) const{
+    if(mode == StorageMode::Hashed){
+        return hashIndex.find(id, [this, id](std::size_t position){
+            return ids[position] == id; // сравнение целых, а не строк
+        });
+    }
+    auto it = lowerBound(id);
+    if(it != sortedOrder.end() && ids[*it] == id) return *it;
+    return OpenHashIndex::npos;
+}
+
+void SetStorage::rebuildIndex(){
+    hashIndex.clear();
+    sortedOrder.clear();
+    if(mode == StorageMode::Hashed){
+        hashIndex.rebuild(std::vector<std::size_t>(ids.begin(), ids.end()));
+        return;
+    }
+    sortedOrder.resize(ids.size());
+    for(std::size_t i = 0; i < ids.size(); ++i){
+        sortedOrder[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(sortedOrder.begin(), sortedOrder.end(), [this](std::uint32_t a, std::uint32_t b){
+        return ids[a] < ids[b];
+    });
+}
+
+bool SetStorage::contains(std::string_view element) const{
+    ElementId id;
+    if(!ElementPool::instance().lookup(element, id)) return false; // неизвестный пулу элемент точно не хранится
+    return contains(id);
+}
+
+bool SetStorage::contains(ElementId id) const{
+    return locate(id) != OpenHashIndex::npos;
+}
+
+bool SetStorage::insert(std::string_view element){
+    ElementId id = ElementPool::instance().intern(element);
+    if(contains(id)) return false;
+    return insert(id, std::string(element)); // копируем только новый элемент
+}
+
+bool SetStorage::insert(std::string&& element){
+    ElementId id = ElementPool::instance().intern(element);
+    return insert(id, std::move(element));
+}
+
+bool SetStorage::insert(ElementId id, std::string&& element){
+    if(mode == StorageMode::Hashed){
+        if(locate(id) != OpenHashIndex::npos) return false;
+        hashIndex.append(id);
+    } else {
+        auto it = lowerBound(id);
+        if(it != sortedOrder.end() && ids[*it] == id) return false;
+        sortedOrder.insert(it, static_cast<std::uint32_t>(ids.size()));
+    }
+    ids.push_back(id);
+    elements.push_back(std::move(element));
+    return true;
+}
+
+bool SetStorage::erase(std::string_view element){
+    ElementId id;
+    if(!ElementPool::instance().lookup(element, id)) return false;
+    std::size_t position = locate(id);
+    if(position == OpenHashIndex::npos) return false;
+    // последний элемент переезжает на место удаленного, сдвига нет
+    const std::size_t last = ids.size() - 1;
+    if(mode == StorageMode::Hashed){
+        hashIndex.erase(position);
+    } else {
+        sortedOrder.erase(lowerBound(id));
+        if(position != last){
+            auto moved = sortedOrder.begin() + (lowerBound(ids[last]) - sortedOrder.cbegin());
+            *moved = static_cast<std::uint32_t>(position);
+        }
+    }
+    if(position != last){
+        ids[position] = ids[last];
+        elements[position] = std::move(elements[last]);
+    }
+    ids.pop_back();
+    elements.pop_back();
+    return true;
+}
+
+void SetStorage::unite(const SetStorage& other){
+    if(&other == this) return;
+    reserve(ids.size() + other.ids.size());
+    if(mode == StorageMode::Hashed){
+        for(std::size_t i = 0; i < other.ids.size(); ++i){
+            if(locate(other.ids[i]) != OpenHashIndex::npos) continue;
+            hashIndex.append(other.ids[i]);
+            ids.push_back(other.ids[i]);
+            elements.push_back(other.elements[i]);
+        }
+        return;
+    }
+    // новые элементы дописываем в конец и сливаем их упорядоченные позиции с sortedOrder
+    std::vector<std::uint32_t> added;
+    for(std::size_t i = 0; i < other.ids.size(); ++i){
+        auto it = lowerBound(other.ids[i]);
+        if(it != sortedOrder.end() && ids[*it] == other.ids[i]) continue;
+        added.push_back(static_cast<std::uint32_t>(ids.size()));
+        ids.push_back(other.ids[i]);
+        elements.push_back(other.elements[i]);
+    }
+    if(added.empty()) return;
+    auto byId = [this](std::uint32_t a, std::uint32_t b){ return ids[a] < ids[b]; };
+    std::sort(added.begin(), added.end(), byId);
+    std::size_t middle = sortedOrder.size();
+    sortedOrder.insert(sortedOrder.end(), added.begin(), added.end());
+    std::inplace_merge(sortedOrder.begin(), sortedOrder.begin() + middle, sortedOrder.end(), byId);
+}
+
+void SetStorage::intersect(const SetStorage& other){
+    if(&other == this) return;
+    std::vector<char> keep(ids.size());
+    for(std::size_t i = 0; i < ids.size(); ++i){
+        keep[i] = other.contains(ids[i]);
+    }
+    compact(keep);
+}
+
+void SetStorage::subtract(const SetStorage& other){
+    if(&other == this){
+        clear();
+        return;
+    }
+    std::vector<char> keep(ids.size());
+    for(std::size_t i = 0; i < ids.size(); ++i){
+        keep[i] = !other.contains(ids[i]);
+    }
+    compact(keep);
+}
+
+void SetStorage::compact(const std::vector<char>& keep){
+    std::vector<std::uint32_t> newPosition(mode == StorageMode::Sorted ? ids.size() : 0);
+    std::size_t kept = 0;
+    for(std::size_t i = 0; i < ids.size(); ++i){ // сдвигаем оставшиеся элементы на месте, без новых векторов строк
+        if(!keep[i]) continue;
+        if(mode == StorageMode::Sorted) newPosition[i] = static_cast<std::uint32_t>(kept);
+        if(kept != i){
+            ids[kept] = ids[i];
+            elements[kept] = std::move(elements[i]);
+        }
+        kept++;
+    }
+    ids.resize(kept);
+    elements.resize(kept);
+    if(mode == StorageMode::Hashed){
+        hashIndex.rebuild(std::vector<std::size_t>(ids.begin(), ids.end()));
+        return;
+    }
+    std::size_t write = 0;
+    for(std::uint32_t position : sortedOrder){
+        if(keep[position]) sortedOrder[write++] = newPosition[position];
+    }
+    sortedOrder.resize(write);
+}
+
+void SetStorage::reserve(std::size_t count){
+    elements.reserve(count);
+    ids.reserve(count);
+    if(mode == StorageMode::Hashed){
+        hashIndex.reserve(count);
+    } else {
+        sortedOrder.reserve(count);
+    }
+}
+
+void SetStorage::clear(){
+    elements.clear();
+    ids.clear();
+    hashIndex.clear();
+    sortedOrder.clear();
+}
+
+std::size_t SetStorage::size() const{
+    return elements.size();
+}
+
+bool SetStorage::empty() const{
+    return elements.empty();
+}
+
+const std::vector<std::string>& SetStorage::items() const{
+    return elements;
+}
+
+const std::vector<ElementId>& SetStorage::identifiers() const{
+    return ids;
+}
@@ -1,122 +1,33 @@
+#include <cstdint>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include "Sets.hpp"
 
 bool Set::isValid(const std::string& str) const {
-    int balance = 0;
-    bool expectElement = true;
-    bool afterComma = false;
-    
-    for (size_t i = 0; i < str.size(); ++i) {
-        char tmp = str[i];
-        if (tmp == ' ') continue;
-        
-        if (tmp == '{' || tmp == '}') {
-            if (!handleBracket(tmp, balance, expectElement, afterComma)) {
-                return false;
-            }
-        } 
-        else if (tmp == ',') {
-            if (!handleComma(expectElement, afterComma)) {
-                return false;
-            }
-        }   
-        else {
-            if (!expectElement) return false;
-            
-            int endIndex = validateElement(str, i);
-            if (endIndex == -1) return false;
-            
-            i = endIndex - 1;
-            expectElement = false;
-            afterComma = false;
-        }
-    }
-    
-    return (balance == 0) && !expectElement && !afterComma;
-}
-
-int Set::validateElement(const std::string& str, size_t start) const {
-    size_t j = start;
-    while (j < str.size() && str[j] != ' ' && str[j] != ',' && str[j] != '}') {
-        char symbol = str[j];
-        if (!(isdigit(symbol) || (symbol >= 'a' && symbol <= 'z') || (symbol >= 'A' && symbol <= 'Z'))) {
-            return -1;
-        }
-        j++;
-    }
-    return j;
-}
-
-bool Set::handleBracket(char c, int& balance, bool& expectElement, bool& afterComma) const {
-    if (c == '{') {
-        if (!expectElement) return false;
-        balance++;
-        expectElement = true;
-        afterComma = false;
-    } 
-    else if (c == '}') {
-        if (balance <= 0 || afterComma) return false;
-        balance--;
-        expectElement = false;
-        afterComma = false;
-    }
-    return true;
+    return SetLiteralParser::isValid(str);
 }
 
-bool Set::handleComma(bool& expectElement, bool& afterComma) const {
-    if (expectElement || afterComma) return false;
-    expectElement = true;
-    afterComma = true;
-    return true;
-}
-
-std::vector<std::string> Set::parseSetString(const std::string& string){
-    std::vector<std::string> elements;
-    if (!isValid(string)) return elements; // проверка валдиности
-    std::string strWithoutSpace = removeSpaces(string);
-    //избавляемся от скобочек
-    if (strWithoutSpace.front() == '{' && strWithoutSpace.back() == '}') {
-        strWithoutSpace = strWithoutSpace.substr(1, strWithoutSpace.size() - 2);
-    }
-    int balance = 0;
-    std::string element;
-    for (char c : strWithoutSpace) {
-        if (c == '{') {
-            balance++;
-            element += c;
-        } else if (c == '}') {
-            balance--;
-            element += c;
-        } else if (c == ',' && balance == 0) {
-            // запятая разделяет эелементы
-            elements.push_back(element);
-            element.clear();
+void Set::insertParsed(const std::vector<ElementSpan>& elements){
+    elInSet.reserve(elInSet.size() + elements.size());
+    for(const ElementSpan& element : elements){
+        if(element.hasSpaces){
+            elInSet.insert(SetLiteralParser::normalize(element)); // строку без пробелов забирает хранилище
         } else {
-            element += c;
+            elInSet.insert(element.text); // копия только если элемент новый
         }
     }
-    if (!element.empty()) {
-        elements.push_back(element); // last элемент
-    }
-    return elements;
 }
 
 bool Set::add(const std::string& element){
     if(!isValid(element)) return false;
-    if((*this)[element]) return false;
-    elInSet.push_back(element); //если нету - добавляем
-    return true;
+    return elInSet.insert(std::string_view(element)); //если нету - добавляем
 }
 
 bool Set::remove(const std::string& element){
     if(!isValid(element)) return false;
-    for(std::vector<std::string>::iterator it = elInSet.begin(); it!=elInSet.end(); ++it){
-        if(*it == element){
-            elInSet.erase(it); // обновлять вектор не надо, т.к. дальше выходим
-            return true;
-        }
-    }
-    return false;
+    return elInSet.erase(element);
 }
 
 void Set::clear(){
@@ -127,48 +38,68 @@ int Set::getCardinality() const{
     return elInSet.size(); //мощность
 }
 
+StorageMode Set::getStorageMode() const{
+    return elInSet.getMode();
+}
+
+void Set::setStorageMode(StorageMode mode){
+    elInSet.setMode(mode);
+}
+
 bool Set::isVoid() const{
     return elInSet.empty(); //пусто
 }
 
 Set Set::getBoolean(){ // всего будет 2^n подможеств
     Set newSet;
-    int n = elInSet.size();
-    int total = 1 << n; // 2^n
-
-    for (int mask = 0; mask < total; ++mask) {
-        Set subsetTemp; // множество-подможество
-        for (int i = 0; i < n; ++i) {
-            if (mask & (1 << i)) {
-                subsetTemp.add(elInSet[i]); // элементы во множество-подмножество
-            }
-        }
-        std::string subsetTempStr = subsetTemp.toString(); // делаем в строку
-        newSet.add(subsetTemp.toString()); // элемент в булеан
+    if(!getBoolean(newSet, maxBooleanSubsets)){
+        throw std::length_error("Set: boolean of " + std::to_string(elInSet.size()) + " elements is too large, use getSubsets()");
     }
     return newSet;
 }
 
+bool Set::getBoolean(Set& result, std::uint64_t maxSubsets) const{
+    if(elInSet.size() > PowerSetRange::maxElements) return false;
+    PowerSetRange subsets = getSubsets();
+    if(subsets.size() > maxSubsets) return false;
+    const std::vector<ElementId>& ids = elInSet.identifiers();
+    ElementPool& pool = ElementPool::instance();
+    Set newSet;
+    newSet.elInSet.reserve(subsets.size());
+    std::vector<ElementId> children;
+    for(const Subset& subset : subsets){
+        children.clear();
+        for(std::size_t i = 0; i < ids.size(); ++i){
+            if(subset.contains(i)) children.push_back(ids[i]);
+        }
+        // подмножество интернируется по идентификаторам, строка сразу уходит в хранилище
+        newSet.elInSet.insert(pool.internSet(children), subset.toString());
+    }
+    result = std::move(newSet);
+    return true;
+}
+
+PowerSetRange Set::getSubsets() const{
+    return PowerSetRange(elInSet.items());
+}
+
 std::string Set::toString() const {
-    if (elInSet.empty()) return "{}"; // возвращаем пустое
+    const std::vector<std::string>& elements = elInSet.items();
+    if (elements.empty()) return "{}"; // возвращаем пустое
     std::string newStr = "{";
-    for (size_t i = 0; i < elInSet.size(); ++i) {
-        newStr += elInSet[i];
-        if (i != elInSet.size() - 1) newStr += ",";
+    for (size_t i = 0; i < elements.size(); ++i) {
+        newStr += elements[i];
+        if (i != elements.size() - 1) newStr += ",";
     }
     newStr += "}";
     return newStr;
 }
 
-std::string Set::removeSpaces(const std::string& str) {
-    std::string newStr;
-    for (char c : str) {
-        if (c != ' ') newStr += c;
-    }
-    return newStr;
+const std::vector<std::string>& Set::getElInSet() const{
+    return elInSet.items();
 }
 
-const std::vector<std::string>& Set::getElInSet() const{
+const SetStorage& Set::getStorage() const{
     return elInSet;
 }
 
@@ -183,13 +114,23 @@ Set& Set::operator = (const Set& other){
     return *this;
 }
 
+Set::Set(Set&& other) noexcept : elInSet(std::move(other.elInSet)) {
+    other.elInSet.clear(); // исходное множество остается пустым и пригодным
+}
+
+Set& Set::operator = (Set&& other) noexcept{
+    if(this != &other){
+        elInSet = std::move(other.elInSet);
+        other.elInSet.clear();
+    }
+    return *this;
+}
+
 Set& Set::operator = (const std::string& elements){
-    if(!isValid(elements)) return *this;
+    std::vector<ElementSpan> parsed;
+    if(!SetLiteralParser::parse(elements, parsed)) return *this; // проверка и разбор за один проход
     clear(); // перед заданием множества чистим
-    std::vector<std::string> parsed = parseSetString(elements);
-    for(const std::string& elem : parsed){
-        add(elem);
-    }
+    insertParsed(parsed);
     return *this;
 }
 
@@ -199,18 +140,15 @@ Set& Set::operator = (const char* elements){
 
 bool Set::operator == (const Set& other){
     if(other.getCardinality() != this->getCardinality()) return false;
-    for(const std::string& elem : other.getElInSet()){
-        if(!(*this)[elem]) return false;
+    for(ElementId id : other.elInSet.identifiers()){
+        if(!elInSet.contains(id)) return false; // сравниваем идентификаторы, а не строки
     }
     return true;
 }
 
 bool Set::operator [] (const std::string& isHere) const{
     if(!isValid(isHere)) return false;
-    for(std::vector<std::string>::const_iterator it = elInSet.begin(); it != elInSet.end(); ++it){
-        if(*it == isHere) return true;
-    }
-    return false;
+    return elInSet.contains(isHere);
 }
 
 bool Set::operator [] (const char* isHere) const{
@@ -218,18 +156,14 @@ bool Set::operator [] (const char* isHere) const{
 }
 
 Set& Set::operator += (const Set& other){
-    for(const std::string& elem : other.getElInSet()){
-        add(elem);
-    }
+    elInSet.unite(other.elInSet); // элементы other уже прошли валидацию
     return *this;
 }
 
 Set& Set::operator += (const std::string& string){
-    if(!isValid(string)) return *this;
-    std::vector<std::string> parsed = parseSetString(string);
-    for(const std::string& elem : parsed){
-        add(elem);
-    }
+    std::vector<ElementSpan> parsed;
+    if(!SetLiteralParser::parse(string, parsed)) return *this;
+    insertParsed(parsed);
     return *this;
 }
 
@@ -237,46 +171,49 @@ Set& Set::operator += (const char* elements){
     return *this += std::string(elements);
 }
 
-Set Set::operator + (const Set& other){
+Set Set::operator + (const Set& other) const &{
     Set newSet = *this;
     newSet += other;
     return newSet;
 }
 
-Set Set::operator * (const Set& other){
+Set Set::operator + (const Set& other) &&{
+    *this += other; // временный левый операнд меняем на месте, без копии
+    return std::move(*this);
+}
+
+Set Set::operator * (const Set& other) const &{
     Set newSet = *this;
     newSet *= other;
     return newSet;
 }
 
+Set Set::operator * (const Set& other) &&{
+    *this *= other; // временный левый операнд меняем на месте, без копии
+    return std::move(*this);
+}
+
 Set& Set::operator *= (const Set& other){
-    std::vector<std::string> tempSet;
-    for(const std::string& elem : elInSet){
-        if(other[elem]){
-            tempSet.push_back(elem);
-        }
-    }
-    elInSet = tempSet;
+    elInSet.intersect(other.elInSet);
     return *this;
 }
 
 Set& Set::operator -= (const Set& other){
-    std::vector<std::string> tempSet;
-    for(const std::string& elem : elInSet){
-        if(!other[elem]){
-            tempSet.push_back(elem);
-        }
-    }
-    elInSet = tempSet;
+    elInSet.subtract(other.elInSet);
     return *this;
 }
 
-Set Set::operator - (const Set& other){
+Set Set::operator - (const Set& other) const &{
     Set newSet = *this;
-    newSet-= other;
+    newSet -= other;
     return newSet;
 }
 
+Set Set::operator - (const Set& other) &&{
+    *this -= other; // временный левый операнд меняем на месте, без копии
+    return std::move(*this);
+}
+
 std::ostream& operator<<(std::ostream& os, const Set& set) {
     os << set.toString();
     return os;
@@ -286,12 +223,14 @@ std::istream& operator>>(std::istream& is, Set& set) {
     std::string line;
     std::getline(is, line); // считываем
     
-    if (!set.isValid(line)) { // проходит ли валидацию
+    std::vector<ElementSpan> parsed;
+    if (!SetLiteralParser::parse(line, parsed)) { // проходит ли валидацию
         is.setstate(std::ios::failbit); // выбрасываем ошибку
         return is;
     }
     
-    set = line;
+    set.clear();
+    set.insertParsed(parsed);
     return is;
 }
 
@@ -299,5 +238,7 @@ Set::Set(const std::string str){
     operator=(str);
 }
 
+Set::Set(StorageMode mode) : elInSet(mode) {}
+
 Set::Set() = default;
 Set::~Set() = default;
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "SymbolDictionary.hpp"
+#include "SetLiteralParser.hpp"
+
+SymbolDictionary::SymbolDictionary() : frozen(false) {}
+
+SymbolDictionary::SymbolDictionary(const std::string& universe) : frozen(false){
+    std::vector<ElementSpan> elements;
+    if(!SetLiteralParser::parse(universe, elements)) return;
+    symbols.reserve(elements.size());
+    bits.reserve(elements.size());
+    std::size_t bit;
+    for(const ElementSpan& element : elements){
+        add(element.text, bit);
+    }
+}
+
+bool SymbolDictionary::add(std::string_view element, std::size_t& bit){
+    ElementId id = ElementPool::instance().intern(element);
+    auto found = bits.find(id);
+    if(found != bits.end()){
+        bit = found->second;
+        return true;
+    }
+    if(frozen) return false;
+    bit = symbols.size();
+    symbols.push_back(id);
+    bits.emplace(id, bit);
+    return true;
+}
+
+bool SymbolDictionary::find(std::string_view element, std::size_t& bit) const{
+    ElementId id;
+    if(!ElementPool::instance().lookup(element, id)) return false;
+    auto found = bits.find(id);
+    if(found == bits.end()) return false;
+    bit = found->second;
+    return true;
+}
+
+std::string SymbolDictionary::symbol(std::size_t bit) const{
+    return ElementPool::instance().toString(symbols[bit]);
+}
+
+std::size_t SymbolDictionary::size() const{
+    return symbols.size();
+}
+
+void SymbolDictionary::setFrozen(bool value){
+    frozen = value;
+}
+
+bool SymbolDictionary::isFrozen() const{
+    return frozen;
+}
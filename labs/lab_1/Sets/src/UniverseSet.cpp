@@ -0,0 +1,271 @@
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define SETS_X86_SIMD 1
+#endif
+#include "UniverseSet.hpp"
+#include "Sets.hpp"
+#include "SetLiteralParser.hpp"
+
+namespace {
+// пословные операции dst op= src: скалярная форма и формы для 128 и 256 бит
+struct OrWords{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b){ return a | b; }
+#if defined(SETS_X86_SIMD)
+    static __m128i apply(__m128i a, __m128i b){ return _mm_or_si128(a, b); }
+    __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b){ return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct AndWords{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b){ return a & b; }
+#if defined(SETS_X86_SIMD)
+    static __m128i apply(__m128i a, __m128i b){ return _mm_and_si128(a, b); }
+    __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b){ return _mm256_and_si256(a, b); }
+#endif
+};
+
+struct AndNotWords{
+    static std::uint64_t apply(std::uint64_t a, std::uint64_t b){ return a & ~b; }
+#if defined(SETS_X86_SIMD)
+    static __m128i apply(__m128i a, __m128i b){ return _mm_andnot_si128(b, a); } // ~b & a
+    __attribute__((target("avx2"))) static __m256i apply(__m256i a, __m256i b){ return _mm256_andnot_si256(b, a); }
+#endif
+};
+
+#if defined(SETS_X86_SIMD)
+// AVX2 компилируется всегда (target), а выбирается по процессору во время выполнения
+template <typename Op>
+__attribute__((target("avx2"))) void applyWordsAvx2(std::uint64_t* dst, const std::uint64_t* src, std::size_t n){
+    std::size_t i = 0;
+    for(; i + 4 <= n; i += 4){
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dst + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), Op::apply(a, b));
+    }
+    for(; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+}
+
+template <typename Op>
+void applyWordsSse2(std::uint64_t* dst, const std::uint64_t* src, std::size_t n){
+    std::size_t i = 0;
+    for(; i + 2 <= n; i += 2){
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), Op::apply(a, b));
+    }
+    for(; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+}
+
+bool hasAvx2(){
+#if defined(SETS_NO_AVX2)
+    return false; // сборка с -DSETS_AVX2=OFF проверяет путь SSE2
+#else
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#endif
+}
+#endif
+
+template <typename Op>
+void applyWords(std::uint64_t* dst, const std::uint64_t* src, std::size_t n){
+#if defined(SETS_X86_SIMD)
+    if(hasAvx2()) applyWordsAvx2<Op>(dst, src, n);
+    else applyWordsSse2<Op>(dst, src, n);
+#else
+    for(std::size_t i = 0; i < n; ++i) dst[i] = Op::apply(dst[i], src[i]);
+#endif
+}
+
+std::size_t lowestBit(std::uint64_t word){
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    std::size_t index = 0;
+    for(; (word & 1) == 0; word >>= 1) index++;
+    return index;
+#endif
+}
+
+int popcount(std::uint64_t word){
+#if defined(__GNUC__)
+    return __builtin_popcountll(word);
+#else
+    int count = 0;
+    for(; word != 0; word &= word - 1) count++;
+    return count;
+#endif
+}
+}
+
+UniverseSet::UniverseSet(std::shared_ptr<SymbolDictionary> dictionary) : dictionary(std::move(dictionary)) {
+    if(!this->dictionary) throw std::invalid_argument("UniverseSet: dictionary is not set");
+}
+
+UniverseSet::UniverseSet(std::shared_ptr<SymbolDictionary> dictionary, const std::string& elements)
+    : UniverseSet(std::move(dictionary)){
+    *this = elements;
+}
+
+UniverseSet::UniverseSet(std::shared_ptr<SymbolDictionary> dictionary, const Set& set)
+    : UniverseSet(std::move(dictionary)){
+    std::size_t bit;
+    for(const std::string& element : set.getElInSet()){ // граница ввода: строки переводим в биты один раз
+        if(this->dictionary->add(element, bit)){
+            ensureBit(bit);
+            words[bit / 64] |= std::uint64_t(1) << (bit % 64);
+        }
+    }
+}
+
+void UniverseSet::ensureBit(std::size_t bit){
+    if(words.size() <= bit / 64) words.resize(bit / 64 + 1, 0);
+}
+
+void UniverseSet::checkUniverse(const UniverseSet& other) const{
+    if(dictionary != other.dictionary){
+        throw std::invalid_argument("UniverseSet: operands belong to different universes");
+    }
+}
+
+bool UniverseSet::add(const std::string& element){
+    if(!SetLiteralParser::isElement(element)) return false;
+    std::size_t bit;
+    if(!dictionary->add(element, bit)) return false;
+    ensureBit(bit);
+    std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+    if(words[bit / 64] & mask) return false;
+    words[bit / 64] |= mask;
+    return true;
+}
+
+bool UniverseSet::remove(const std::string& element){
+    std::size_t bit;
+    if(!dictionary->find(element, bit) || bit / 64 >= words.size()) return false;
+    std::uint64_t mask = std::uint64_t(1) << (bit % 64);
+    if(!(words[bit / 64] & mask)) return false;
+    words[bit / 64] &= ~mask;
+    return true;
+}
+
+void UniverseSet::clear(){
+    words.clear();
+}
+
+int UniverseSet::getCardinality() const{
+    int count = 0;
+    for(std::uint64_t word : words) count += popcount(word);
+    return count;
+}
+
+bool UniverseSet::isVoid() const{
+    for(std::uint64_t word : words){
+        if(word != 0) return false;
+    }
+    return true;
+}
+
+const std::shared_ptr<SymbolDictionary>& UniverseSet::getDictionary() const{
+    return dictionary;
+}
+
+Set UniverseSet::toSet() const{
+    return Set(toString());
+}
+
+std::string UniverseSet::toString() const{
+    std::string result = "{";
+    for(std::size_t w = 0; w < words.size(); ++w){
+        for(std::uint64_t rest = words[w]; rest != 0; rest &= rest - 1){
+            std::size_t bit = w * 64 + lowestBit(rest);
+            if(result.size() > 1) result += ',';
+            result += dictionary->symbol(bit);
+        }
+    }
+    result += '}';
+    return result;
+}
+
+UniverseSet& UniverseSet::operator = (const std::string& elements){
+    std::vector<ElementSpan> parsed;
+    if(!SetLiteralParser::parse(elements, parsed)) return *this;
+    std::vector<std::size_t> newBits;
+    newBits.reserve(parsed.size());
+    std::size_t bit;
+    for(const ElementSpan& element : parsed){
+        if(!dictionary->add(element.text, bit)) return *this; // элемент вне замороженного универсума
+        newBits.push_back(bit);
+    }
+    words.clear();
+    for(std::size_t newBit : newBits){
+        ensureBit(newBit);
+        words[newBit / 64] |= std::uint64_t(1) << (newBit % 64);
+    }
+    return *this;
+}
+
+bool UniverseSet::operator == (const UniverseSet& other) const{
+    checkUniverse(other);
+    std::size_t common = std::min(words.size(), other.words.size());
+    for(std::size_t i = 0; i < common; ++i){
+        if(words[i] != other.words[i]) return false;
+    }
+    for(std::size_t i = common; i < words.size(); ++i){
+        if(words[i] != 0) return false;
+    }
+    for(std::size_t i = common; i < other.words.size(); ++i){
+        if(other.words[i] != 0) return false;
+    }
+    return true;
+}
+
+bool UniverseSet::operator [] (const std::string& isHere) const{
+    std::size_t bit;
+    if(!dictionary->find(isHere, bit) || bit / 64 >= words.size()) return false;
+    return (words[bit / 64] >> (bit % 64)) & 1;
+}
+
+UniverseSet& UniverseSet::operator += (const UniverseSet& other){
+    checkUniverse(other);
+    if(words.size() < other.words.size()) words.resize(other.words.size(), 0);
+    applyWords<OrWords>(words.data(), other.words.data(), other.words.size());
+    return *this;
+}
+
+UniverseSet& UniverseSet::operator *= (const UniverseSet& other){
+    checkUniverse(other);
+    if(words.size() > other.words.size()) words.resize(other.words.size()); // за пределами other битов нет
+    applyWords<AndWords>(words.data(), other.words.data(), words.size());
+    return *this;
+}
+
+UniverseSet& UniverseSet::operator -= (const UniverseSet& other){
+    checkUniverse(other);
+    applyWords<AndNotWords>(words.data(), other.words.data(), std::min(words.size(), other.words.size()));
+    return *this;
+}
+
+UniverseSet UniverseSet::operator + (const UniverseSet& other) const{
+    UniverseSet newSet = *this;
+    newSet += other;
+    return newSet;
+}
+
+UniverseSet UniverseSet::operator * (const UniverseSet& other) const{
+    UniverseSet newSet = *this;
+    newSet *= other;
+    return newSet;
+}
+
+UniverseSet UniverseSet::operator - (const UniverseSet& other) const{
+    UniverseSet newSet = *this;
+    newSet -= other;
+    return newSet;
+}
+
+std::ostream& operator<<(std::ostream& os, const UniverseSet& set){
+    os << set.toString();
+    return os;
+}
@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 #include "Sets.hpp"
+#include "SetExpression.hpp"
+#include "UniverseSet.hpp"
 
 // Конструкторы и базовые состояния
 TEST(SetDefault, DefaultConstructorCreatesEmptySet) { //1
@@ -221,4 +228,293 @@ TEST(SetBoolean, BooleanOfLargeSetHasCorrectCardinality) { //30
     set = "{a, b, c, d, e, f, g, h}";
     Set boolean = set.getBoolean();
     EXPECT_EQ(boolean.getCardinality(), 1 << 8);
-}
\ No newline at end of file
+}
+// Хранилище множества
+TEST(SetStorage, SortedModeSupportsAllOperations) { //31
+    Set setOne(StorageMode::Sorted);
+    setOne = "{d, a, c, b}";
+    Set setTwo;
+    setTwo = "{b, c, e}";
+    Set unionSet = setOne + setTwo;
+    Set intersection = setOne * setTwo;
+    Set difference = setOne - setTwo;
+    EXPECT_TRUE(unionSet.getCardinality() == 5 && unionSet["e"] && unionSet["a"]);
+    EXPECT_TRUE(intersection.getCardinality() == 2 && intersection["b"] && intersection["c"]);
+    EXPECT_TRUE(difference.getCardinality() == 2 && difference["a"] && difference["d"]);
+}
+
+TEST(SetStorage, SwitchingModeKeepsElementsAndOrder) { //32
+    Set set;
+    set = "{c, a, {b, a}, b}";
+    set.setStorageMode(StorageMode::Sorted);
+    EXPECT_TRUE(set.getStorageMode() == StorageMode::Sorted);
+    EXPECT_TRUE(set["a"] && set["{b,a}"] && set.remove("c") && !set["c"]);
+    set.setStorageMode(StorageMode::Hashed);
+    EXPECT_EQ(set.getElInSet(), std::vector<std::string>({"b", "a", "{b,a}"})); // последний занял место удаленного
+}
+
+TEST(SetStorage, EraseKeepsIndexConsistent) { //33
+    for (StorageMode mode : {StorageMode::Hashed, StorageMode::Sorted}) {
+        std::string literal = "{";
+        for (int i = 0; i < 2000; ++i) {
+            literal += "e" + std::to_string(i) + ",";
+        }
+        literal.back() = '}';
+        Set set;
+        set.setStorageMode(mode);
+        set = literal;
+        for (int i = 0; i < 2000; i += 3) {
+            EXPECT_TRUE(set.remove("e" + std::to_string(i)));
+        }
+        EXPECT_FALSE(set.remove("e0"));
+        int kept = 0;
+        for (int i = 0; i < 2000; ++i) {
+            bool stored = set["e" + std::to_string(i)];
+            EXPECT_EQ(stored, i % 3 != 0);
+            kept += stored;
+        }
+        EXPECT_EQ(set.getCardinality(), kept);
+    }
+}
+
+TEST(SetStorage, RemoveMovesLastElementIntoPlace) { //34
+    for (StorageMode mode : {StorageMode::Hashed, StorageMode::Sorted}) {
+        Set set;
+        set.setStorageMode(mode);
+        set = "{a, b, c, d, e}";
+        EXPECT_TRUE(set.remove("b") && set.remove("e"));
+        EXPECT_EQ(set.getElInSet(), std::vector<std::string>({"a", "d", "c"}));
+        std::ostringstream out;
+        out << set;
+        EXPECT_EQ(out.str(), "{a,d,c}");
+    }
+}
+
+TEST(SetStorage, LargeSetOperationsAreLinear) { //35
+    Set setOne;
+    Set setTwo;
+    std::string first = "{";
+    std::string second = "{";
+    for (int i = 0; i < 200000; ++i) {
+        first += "e" + std::to_string(i) + ",";
+        second += "e" + std::to_string(i + 100000) + ",";
+    }
+    first.back() = '}';
+    second.back() = '}';
+    setOne = first;
+    setTwo = second;
+    EXPECT_EQ((setOne + setTwo).getCardinality(), 300000);
+    EXPECT_EQ((setOne * setTwo).getCardinality(), 100000);
+    EXPECT_EQ((setOne - setTwo).getCardinality(), 100000);
+}
+
+// Разбор строки множества
+TEST(SetParsing, NestedElementsAreStoredWithoutSpaces) { //36
+    Set set;
+    set = "{ a ,  { b ,  { c , d } } , e }";
+    EXPECT_EQ(set.getElInSet(), std::vector<std::string>({"a", "{b,{c,d}}", "e"}));
+}
+
+TEST(SetParsing, BareListOfSetsKeepsEachSet) { //37
+    Set set;
+    set = "{x, y}, {z}";
+    EXPECT_TRUE(set.getCardinality() == 2 && set["{x,y}"] && set["{z}"]);
+}
+
+TEST(SetParsing, InvalidLiteralDoesNotChangeSet) { //38
+    Set set;
+    set = "{a, b}";
+    set = "{a, b c}";
+    EXPECT_TRUE(set.getCardinality() == 2 && set["a"] && set["b"]);
+}
+
+TEST(SetParsing, StreamInputFailsOnInvalidLiteral) { //39
+    Set set;
+    std::istringstream input("{a, {b,}}");
+    input >> set;
+    EXPECT_TRUE(input.fail() && set.isVoid());
+}
+
+// Ленивый булеан
+TEST(SetSubsets, GrayCodeNeighboursDifferByOneElement) { //40
+    Set set;
+    set = "{a, b, c, d}";
+    PowerSetRange subsets = set.getSubsets();
+    EXPECT_EQ(subsets.size(), 16u);
+    std::uint64_t previous = 0;
+    std::set<std::uint64_t> seen;
+    for (PowerSetRange::Iterator it = subsets.begin(); it != subsets.end(); ++it) {
+        std::uint64_t mask = it.mask();
+        if (mask != 0) {
+            EXPECT_EQ(mask ^ previous, std::uint64_t(1) << it.toggled());
+        }
+        seen.insert(mask);
+        previous = mask;
+    }
+    EXPECT_EQ(seen.size(), 16u);
+}
+
+TEST(SetSubsets, ChunksCoverWholeRangeOfLargeSet) { //41
+    Set set;
+    std::string literal = "{";
+    for (int i = 0; i < 40; ++i) literal += "e" + std::to_string(i) + (i < 39 ? "," : "}");
+    set = literal;
+    PowerSetRange subsets = set.getSubsets();
+    std::uint64_t total = 0;
+    for (std::size_t i = 0; i < 7; ++i) total += subsets.chunk(i, 7).size();
+    EXPECT_EQ(total, std::uint64_t(1) << 40);
+    PowerSetRange last = subsets.chunk(6, 7);
+    EXPECT_EQ((*last.begin()).getCardinality() > 0, true);
+}
+
+TEST(SetSubsets, GuardedBooleanRefusesTooLargeResult) { //42
+    Set set;
+    set = "{a, b, c, d, e}";
+    Set boolean;
+    EXPECT_FALSE(set.getBoolean(boolean, 31));
+    EXPECT_TRUE(boolean.isVoid());
+    EXPECT_TRUE(set.getBoolean(boolean, 32));
+    EXPECT_TRUE(boolean.getCardinality() == 32 && boolean["{a,c,e}"] && boolean["{}"]);
+}
+
+TEST(SetSubsets, BooleanOfTooLargeSetThrows) { //43
+    Set set;
+    std::string literal = "{";
+    for (int i = 0; i < 25; ++i) literal += "e" + std::to_string(i) + ",";
+    literal.back() = '}';
+    set = literal;
+    EXPECT_THROW(set.getBoolean(), std::length_error);
+    EXPECT_EQ(set.getSubsets().size(), std::uint64_t(1) << 25);
+}
+
+// Интернирование вложенных элементов
+TEST(SetInterning, NestedElementsAreComparedAsSets) { //44
+    Set set;
+    set = "{a, {b, a}, {{c, d}, e}}";
+    EXPECT_TRUE(set["{a,b}"] && set["{a,b,a}"] && set["{e,{d,c}}"]);
+    EXPECT_FALSE(set["{a,b,c}"]);
+    set += "{{b, a}}";
+    EXPECT_TRUE(set.getCardinality() == 3);
+    EXPECT_TRUE(set.remove("{e, {c, d}}") && set.getCardinality() == 2);
+}
+
+TEST(SetInterning, SetsWithReorderedNestedElementsAreEqual) { //45
+    Set setOne;
+    setOne = "{x, {1, 2, {3, 4}}}";
+    Set setTwo;
+    setTwo = "{{{4, 3}, 2, 1}, x}";
+    EXPECT_TRUE(setOne == setTwo);
+    EXPECT_TRUE((setOne * setTwo).getCardinality() == 2 && (setOne - setTwo).isVoid());
+}
+
+TEST(SetInterning, PoolStoresEqualSubstructuresOnce) { //46
+    ElementPool pool;
+    ElementId first = pool.intern("{{a,b},{c,{a,b}}}");
+    std::size_t size = pool.size();
+    ElementId second = pool.intern("{{{b,a},c},{b,a}}");
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(pool.size(), size);
+    EXPECT_EQ(pool.internSet({pool.intern("b"), pool.intern("a"), pool.intern("a")}), pool.intern("{a,b}"));
+    ElementId unknown;
+    EXPECT_FALSE(pool.lookup("{a,z}", unknown));
+    EXPECT_THROW(pool.intern("{a,"), std::invalid_argument);
+    EXPECT_THROW(pool.intern("a b"), std::invalid_argument);
+}
+
+TEST(SetInterning, SharedPoolIsSafeForConcurrentSets) { //47
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([t, &mismatches]() {
+            for (int i = 0; i < 2000; ++i) {
+                std::string atom = "p" + std::to_string((i * 7 + t) % 500);
+                Set first("{" + atom + ", {q" + std::to_string(i % 50) + ", " + atom + "}}");
+                Set second("{{" + atom + ", q" + std::to_string(i % 50) + "}, " + atom + "}");
+                if (!(first == second)) mismatches[t]++;
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    EXPECT_EQ(mismatches, std::vector<int>(4, 0));
+}
+
+// Множества над ограниченным универсумом
+TEST(UniverseSetTest, BitsetOperationsMatchSetOperations) { //48
+    std::shared_ptr<SymbolDictionary> universe = std::make_shared<SymbolDictionary>();
+    Set first;
+    Set second;
+    std::string firstLiteral = "{";
+    std::string secondLiteral = "{";
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 2 == 0) firstLiteral += "t" + std::to_string(i) + ",";
+        if (i % 3 == 0) secondLiteral += "t" + std::to_string(i) + ",";
+    }
+    firstLiteral.back() = '}';
+    secondLiteral.back() = '}';
+    first = firstLiteral;
+    second = secondLiteral;
+    UniverseSet bitsFirst(universe, first);
+    UniverseSet bitsSecond(universe, second);
+    EXPECT_EQ((bitsFirst + bitsSecond).getCardinality(), (first + second).getCardinality());
+    EXPECT_EQ((bitsFirst * bitsSecond).getCardinality(), (first * second).getCardinality());
+    EXPECT_EQ((bitsFirst - bitsSecond).getCardinality(), (first - second).getCardinality());
+    EXPECT_TRUE((bitsFirst * bitsSecond).toSet() == first * second);
+    EXPECT_TRUE(bitsFirst["t998"] && !bitsFirst["t999"] && !bitsFirst["unknown"]);
+}
+
+TEST(UniverseSetTest, FrozenUniverseRejectsUnknownElements) { //49
+    std::shared_ptr<SymbolDictionary> universe = std::make_shared<SymbolDictionary>("{a, b, c, {a, b}}");
+    universe->setFrozen(true);
+    UniverseSet set(universe, "{a, {b, a}}");
+    EXPECT_TRUE(set.getCardinality() == 2 && set["{a,b}"]);
+    set = "{a, d}";
+    EXPECT_TRUE(set.getCardinality() == 2 && !set["d"]);
+    EXPECT_FALSE(set.add("d"));
+    EXPECT_FALSE(set.add("b, c"));
+    EXPECT_TRUE(set.add("c") && set.remove("a") && set.getCardinality() == 2);
+    EXPECT_EQ(universe->size(), 4u);
+}
+
+TEST(UniverseSetTest, OperandsFromDifferentUniversesAreRejected) { //50
+    UniverseSet first(std::make_shared<SymbolDictionary>(), "{a}");
+    UniverseSet second(std::make_shared<SymbolDictionary>(), "{a}");
+    EXPECT_THROW(first += second, std::invalid_argument);
+}
+
+// Перемещение и слияние выражений
+TEST(SetMove, MoveLeavesSourceEmpty) { //51
+    Set source("{a, b, {c}}");
+    Set moved(std::move(source));
+    EXPECT_TRUE(moved.getCardinality() == 3 && moved["{c}"]);
+    EXPECT_TRUE(source.isVoid() && !source["a"]);
+    source = "{d}";
+    moved = std::move(source);
+    EXPECT_TRUE(moved.getCardinality() == 1 && moved["d"] && source.isVoid());
+}
+
+TEST(SetMove, TemporaryChainMatchesCopies) { //52
+    const Set first("{a, b, c}");
+    const Set second("{c, d}");
+    const Set third("{a, d, e}");
+    Set result = first + second * third - Set("{a}");
+    std::ostringstream out;
+    out << result;
+    EXPECT_EQ(out.str(), "{b,c,d}");
+    EXPECT_TRUE(first.getCardinality() == 3 && second.getCardinality() == 2);
+}
+
+TEST(SetExpression, FusedEvaluationMatchesOperators) { //53
+    Set first("{a, b, {x, y}, c}");
+    Set second("{c, d, {y, x}}");
+    Set third("{a, d, e, c}");
+    Set fourth("{c}");
+    Set fused = setexpr::ref(first) + setexpr::ref(second) * setexpr::ref(third) - setexpr::ref(fourth);
+    Set chained = first + second * third - fourth;
+    std::ostringstream fusedOut, chainedOut;
+    fusedOut << fused;
+    chainedOut << chained;
+    EXPECT_EQ(fusedOut.str(), chainedOut.str());
+    EXPECT_EQ(fusedOut.str(), "{a,b,{x,y},d}");
+    Set both = setexpr::evaluate(setexpr::ref(first) * (setexpr::ref(second) + setexpr::ref(third)));
+    EXPECT_TRUE(both == first * (second + third));
+}
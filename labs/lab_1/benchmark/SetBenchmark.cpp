@@ -0,0 +1,166 @@
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include <string>
+#include "Sets.hpp"
+#include "SetExpression.hpp"
+#include "MultiSets.hpp"
+
+// Литерал из count атомов prefix0..prefix(count-1), начиная с first
+static std::string makeLiteral(const std::string& prefix, long first, long count){
+    std::string literal = "{";
+    for(long i = first; i < first + count; ++i){
+        literal += prefix;
+        literal += std::to_string(i);
+        literal += ',';
+    }
+    if(count == 0) literal += '}';
+    else literal.back() = '}';
+    return literal;
+}
+
+// Разбор и вывод
+static void BM_SetParseFormat(benchmark::State& state){
+    std::string literal = makeLiteral("e", 0, state.range(0));
+    for(auto _ : state){
+        Set set;
+        set = literal;
+        std::ostringstream out;
+        out << set;
+        benchmark::DoNotOptimize(out.str().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetBytesProcessed(state.iterations() * static_cast<long>(literal.size()));
+}
+BENCHMARK(BM_SetParseFormat)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+static void BM_MultiSetParseFormat(benchmark::State& state){
+    std::string literal = makeLiteral("e", 0, state.range(0));
+    for(auto _ : state){
+        MultiSet set;
+        set = literal;
+        std::ostringstream out;
+        out << set;
+        benchmark::DoNotOptimize(out.str().size());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_MultiSetParseFormat)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMillisecond);
+
+// Проверка принадлежности
+static void BM_SetLookup(benchmark::State& state){
+    Set set(makeLiteral("e", 0, state.range(0)));
+    std::vector<std::string> probes;
+    for(long i = 0; i < 1024; ++i){
+        probes.push_back("e" + std::to_string((i * 7919) % (2 * state.range(0)))); // половина промахов
+    }
+    std::size_t i = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(set[probes[i++ & 1023]]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SetLookup)->RangeMultiplier(10)->Range(100, 1000000);
+
+static void BM_MultiSetCount(benchmark::State& state){
+    MultiSet set(makeLiteral("e", 0, state.range(0)));
+    std::vector<std::string> probes;
+    for(long i = 0; i < 1024; ++i){
+        probes.push_back("e" + std::to_string((i * 7919) % (2 * state.range(0))));
+    }
+    std::size_t i = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(set.getCount(probes[i++ & 1023]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MultiSetCount)->RangeMultiplier(10)->Range(100, 1000000);
+
+// Объединение, пересечение, разность: операнды пересекаются наполовину
+template <typename Container, typename Operation>
+static void runBinary(benchmark::State& state, Operation operation){
+    Container first(makeLiteral("e", 0, state.range(0)));
+    Container second(makeLiteral("e", state.range(0) / 2, state.range(0)));
+    for(auto _ : state){
+        Container result = operation(first, second);
+        benchmark::DoNotOptimize(result.getCardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+static void BM_SetUnion(benchmark::State& state){
+    runBinary<Set>(state, [](Set& a, Set& b){ return a + b; });
+}
+static void BM_SetIntersection(benchmark::State& state){
+    runBinary<Set>(state, [](Set& a, Set& b){ return a * b; });
+}
+static void BM_SetDifference(benchmark::State& state){
+    runBinary<Set>(state, [](Set& a, Set& b){ return a - b; });
+}
+static void BM_MultiSetUnion(benchmark::State& state){
+    runBinary<MultiSet>(state, [](MultiSet& a, MultiSet& b){ return a + b; });
+}
+static void BM_MultiSetIntersection(benchmark::State& state){
+    runBinary<MultiSet>(state, [](MultiSet& a, MultiSet& b){ return a * b; });
+}
+static void BM_MultiSetDifference(benchmark::State& state){
+    runBinary<MultiSet>(state, [](MultiSet& a, MultiSet& b){ return a - b; });
+}
+BENCHMARK(BM_SetUnion)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SetIntersection)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SetDifference)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MultiSetUnion)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MultiSetIntersection)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_MultiSetDifference)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+
+// Цепочка A + B * C - D: промежуточные множества против слитого выражения
+static void BM_SetChained(benchmark::State& state){
+    Set a(makeLiteral("e", 0, state.range(0)));
+    Set b(makeLiteral("e", state.range(0) / 2, state.range(0)));
+    Set c(makeLiteral("e", state.range(0), state.range(0)));
+    Set d(makeLiteral("e", 0, state.range(0) / 4));
+    for(auto _ : state){
+        Set result = a + b * c - d;
+        benchmark::DoNotOptimize(result.getCardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+static void BM_SetFused(benchmark::State& state){
+    Set a(makeLiteral("e", 0, state.range(0)));
+    Set b(makeLiteral("e", state.range(0) / 2, state.range(0)));
+    Set c(makeLiteral("e", state.range(0), state.range(0)));
+    Set d(makeLiteral("e", 0, state.range(0) / 4));
+    for(auto _ : state){
+        Set result = setexpr::ref(a) + setexpr::ref(b) * setexpr::ref(c) - setexpr::ref(d);
+        benchmark::DoNotOptimize(result.getCardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * 4);
+}
+BENCHMARK(BM_SetChained)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SetFused)->RangeMultiplier(10)->Range(100, 1000000)->Unit(benchmark::kMicrosecond);
+
+// Булеан
+static void BM_SetBoolean(benchmark::State& state){
+    Set set(makeLiteral("e", 0, state.range(0)));
+    for(auto _ : state){
+        Set boolean = set.getBoolean();
+        benchmark::DoNotOptimize(boolean.getCardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * (1L << state.range(0)));
+}
+BENCHMARK(BM_SetBoolean)->DenseRange(4, 20, 4)->Unit(benchmark::kMillisecond);
+
+static void BM_SetSubsetsLazy(benchmark::State& state){
+    Set set(makeLiteral("e", 0, state.range(0)));
+    for(auto _ : state){
+        std::uint64_t checksum = 0;
+        PowerSetRange subsets = set.getSubsets();
+        for(auto it = subsets.begin(); it != subsets.end(); ++it){
+            checksum += it.mask();
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    state.SetItemsProcessed(state.iterations() * (1L << state.range(0)));
+}
+BENCHMARK(BM_SetSubsetsLazy)->DenseRange(4, 20, 4)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
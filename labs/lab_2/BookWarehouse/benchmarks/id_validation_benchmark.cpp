@@ -0,0 +1,94 @@
+/**
+ * @file id_validation_benchmark.cpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Micro-benchmark of identifier validation on the object construction path
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ * Compares the former per-call std::regex validation with IdValidation, alone
+ * and inside StorageLocation/Shelf construction. Build from BookWarehouse:
+ *
+ *   g++ -std=c++17 -O2 -Imodules -Imodules/warehouse/include -Imodules/books/include \
+ *       benchmarks/id_validation_benchmark.cpp modules/warehouse/src/StorageLocation.cpp \
+ *       modules/warehouse/src/Shelf.cpp -o id_validation_benchmark
+ */
+
+#include <chrono>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+#include "Shelf.hpp"
+#include "StorageLocation.hpp"
+#include "utils/IdValidation.hpp"
+
+namespace {
+// Validation as it was done before IdValidation: the regex is built on every call
+bool regexLocationId(const std::string& locationId) {
+    std::regex pattern("^[A-Z]-\\d{2}-[A-Z]-\\d{2}$");
+    return std::regex_match(locationId, pattern);
+}
+
+bool regexShelfId(const std::string& shelfId) {
+    std::regex pattern("^[A-Z]-\\d{2}$");
+    return std::regex_match(shelfId, pattern);
+}
+
+bool regexMovementId(const std::string& movementId) {
+    std::regex pattern("^(MOV|REC|WO|TRF|DEL)-\\d{4}-\\d{3}$");
+    return std::regex_match(movementId, pattern);
+}
+
+template <typename Function>
+double nanosecondsPerCall(std::size_t calls, Function function) {
+    auto begin = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < calls; ++i) {
+        function(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    return elapsed.count() / static_cast<double>(calls);
+}
+
+void report(const char* name, double before, double after) {
+    std::cout << name << ": regex " << before << " ns, IdValidation " << after << " ns, x" << before / after << "\n";
+}
+}
+
+int main() {
+    const std::size_t calls = 200000;
+    std::vector<std::string> locationIds;
+    std::vector<std::string> movementIds;
+    for (char row = 'A'; row <= 'Z'; ++row) {
+        for (int cell = 0; cell < 100; ++cell) {
+            std::string number = (cell < 10 ? "0" : "") + std::to_string(cell);
+            locationIds.push_back(std::string("A-01-") + row + "-" + number);
+            movementIds.push_back("REC-2025-0" + number);
+        }
+    }
+    locationIds.push_back("A-01-b-05"); // one invalid ID of each kind
+    movementIds.push_back("REC-2025-01");
+
+    volatile std::size_t valid = 0;
+    double regexLocation = nanosecondsPerCall(calls, [&](std::size_t i) { valid += regexLocationId(locationIds[i % locationIds.size()]); });
+    double fastLocation = nanosecondsPerCall(calls, [&](std::size_t i) { valid += IdValidation::isValidLocationId(locationIds[i % locationIds.size()]); });
+    report("location ID            ", regexLocation, fastLocation);
+
+    double regexMovement = nanosecondsPerCall(calls, [&](std::size_t i) { valid += regexMovementId(movementIds[i % movementIds.size()]); });
+    double fastMovement = nanosecondsPerCall(calls, [&](std::size_t i) { valid += IdValidation::isValidMovementId(movementIds[i % movementIds.size()]); });
+    report("movement ID            ", regexMovement, fastMovement);
+
+    // Whole constructors: the former path is the regex checks plus the current constructors
+    const std::size_t objects = calls / 4;
+    auto construct = [&](std::size_t i) {
+        StorageLocation location(locationIds[i % (locationIds.size() - 1)], 100);
+        Shelf shelf("A-01", 10);
+        valid += location.getCapacity() > 0 && shelf.getMaxLocations() > 0;
+    };
+    double regexConstruct = nanosecondsPerCall(objects, [&](std::size_t i) {
+        valid += regexLocationId(locationIds[i % (locationIds.size() - 1)]) && regexShelfId("A-01");
+        construct(i);
+    });
+    double fastConstruct = nanosecondsPerCall(objects, construct);
+    report("StorageLocation + Shelf", regexConstruct, fastConstruct);
+    return valid > 0 ? 0 : 1;
+}
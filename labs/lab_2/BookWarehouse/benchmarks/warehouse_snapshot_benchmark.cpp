@@ -0,0 +1,113 @@
+/**
+ * @file warehouse_snapshot_benchmark.cpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Benchmark of saving and restoring a large warehouse with WarehouseSnapshot
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ * Builds a warehouse of 26 sections, 26000 locations, 100000 books and 1000000 inventory
+ * items through the public API (the way it is built without snapshots), then saves it
+ * and loads it back. Build from BookWarehouse:
+ *
+ *   g++ -std=c++17 -O2 -Imodules -Imodules/warehouse/include -Imodules/books/include \
+ *       benchmarks/warehouse_snapshot_benchmark.cpp modules/warehouse/src/?*.cpp \
+ *       modules/books/src/?*.cpp -pthread -o warehouse_snapshot_benchmark
+ *
+ * (?* stands for the usual glob, written so that it does not open a comment.)
+ *
+ * Usage: warehouse_snapshot_benchmark [snapshot path]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Warehouse.hpp"
+#include "WarehouseSnapshot.hpp"
+
+namespace {
+double secondsSince(std::chrono::steady_clock::time_point begin) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+std::string twoDigits(int value) {
+    return (value < 10 ? "0" : "") + std::to_string(value);
+}
+
+std::string isbnOf(int number) {
+    std::string digits = std::to_string(978000000000LL + number);
+    int sum = 0;
+    for (int i = 0; i < 12; i++) {
+        sum += (digits[i] - '0') * (i % 2 == 0 ? 1 : 3);
+    }
+    return digits + std::to_string((10 - sum % 10) % 10);
+}
+}
+
+int main(int argc, char** argv) {
+    const std::string path = argc > 1 ? argv[1] : "warehouse_snapshot_benchmark.bin";
+    const int shelvesPerSection = 20;
+    const int locationsPerShelf = 50;
+    const int bookCount = 100000;
+    const int itemCount = 1000000;
+
+    auto begin = std::chrono::steady_clock::now();
+    Warehouse warehouse("Benchmark Warehouse", "Minsk, Nezavisimosti 4");
+    std::vector<std::shared_ptr<StorageLocation>> locations;
+    for (char sectionId = 'A'; sectionId <= 'Z'; ++sectionId) {
+        auto section = std::make_shared<WarehouseSection>(std::string(1, sectionId), std::string("Section ") + sectionId);
+        for (int shelfNumber = 1; shelfNumber <= shelvesPerSection; ++shelfNumber) {
+            std::string shelfId = std::string(1, sectionId) + "-" + twoDigits(shelfNumber);
+            auto shelf = std::make_shared<Shelf>(shelfId, locationsPerShelf);
+            for (int cell = 0; cell < locationsPerShelf; ++cell) {
+                auto location = std::make_shared<StorageLocation>(
+                    shelfId + "-" + static_cast<char>('A' + cell / 10) + "-" + twoDigits(cell % 10), 1000);
+                shelf->addLocation(location);
+                locations.push_back(location);
+            }
+            section->addShelf(shelf);
+        }
+        warehouse.addSection(section);
+    }
+    auto publisher = std::make_shared<Publisher>("Benchmark Press", "press@example.com", 1990);
+    std::vector<std::shared_ptr<Book>> books;
+    for (int number = 0; number < bookCount; ++number) {
+        books.push_back(std::make_shared<Book>(
+            ISBN(isbnOf(number)), BookTitle("Book " + std::to_string(number), "", "EN"), BookMetadata(2000 + number % 25, "EN"),
+            PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+            Genre(Genre::Type::OTHER), publisher, BookCondition(BookCondition::Condition::NEW), 10.0 + number % 50));
+    }
+    // Every (book, location) pair is distinct: lcm(26000, 100000) is above the item count
+    for (int number = 0; number < itemCount; ++number) {
+        warehouse.addInventoryItem(std::make_shared<InventoryItem>(
+            books[number % bookCount], 1 + number % 20, locations[number % locations.size()], "2025-12-12"));
+    }
+    double build = secondsSince(begin);
+
+    begin = std::chrono::steady_clock::now();
+    WarehouseSnapshot::save(warehouse, path);
+    double save = secondsSince(begin);
+
+    begin = std::chrono::steady_clock::now();
+    std::shared_ptr<Warehouse> restored = WarehouseSnapshot::load(path);
+    double load = secondsSince(begin);
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    long size = 0;
+    if (file) {
+        std::fseek(file, 0, SEEK_END);
+        size = std::ftell(file);
+        std::fclose(file);
+    }
+    std::cout << "items: " << itemCount << ", books: " << bookCount << ", locations: " << locations.size() << "\n"
+              << "build through the API: " << build << " s\n"
+              << "save:                  " << save << " s (" << size / (1024 * 1024) << " MiB)\n"
+              << "load:                  " << load << " s\n";
+
+    bool same = restored->getCurrentLoad() == warehouse.getCurrentLoad() &&
+                restored->getBookTotalQuantity(isbnOf(42)) == warehouse.getBookTotalQuantity(isbnOf(42));
+    std::remove(path.c_str());
+    return same ? 0 : 1;
+}
@@ -22,6 +22,8 @@
 #include <vector>
 #include <memory>
 
+class WarehouseSnapshot;
+
 /**
  * @class Book
  * @brief Main class for working with books
@@ -31,6 +33,8 @@
  * logic for stock management, pricing, and book analysis.
  */
 class Book {
+    friend class WarehouseSnapshot;   ///< Restores the state saved in a snapshot without revalidation
+
 private:
     ISBN isbn;                                      ///< International Standard Book Number
     BookTitle title;                                ///< Book title information
@@ -0,0 +1,147 @@
+/**
+ * @file CatalogueImporter.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the CatalogueImporter class for bulk loading of books from catalogue files
+ * @version 0.1
+ * @date 2025-12-11
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "Book.hpp"
+#include "BookSeries.hpp"
+#include "Publisher.hpp"
+
+/**
+ * @class CatalogueImporter
+ * @brief Class for loading publisher catalogues of many books at once
+ *
+ * A catalogue has one book per line, either as CSV or as a flat JSON object (JSON lines),
+ * both formats may be mixed. CSV columns and JSON keys are:
+ *
+ *   isbn, title, subtitle, language, year, edition, genre, condition, price,
+ *   publisher, publisherEmail, publisherYear, series, weight, height, width,
+ *   thickness, pages, cover, material
+ *
+ * isbn, title, language, year, publisher and publisherYear are required, other fields may be
+ * empty or omitted and get the defaults of Book(isbn, title). Genre, condition and cover are
+ * enumerator names (e.g. SCIENCE_FICTION, LIKE_NEW, PAPERBACK). A CSV line starting with
+ * "isbn," is a header, empty lines and lines starting with '#' are skipped. CSV fields may be
+ * quoted, but no value may contain a line break.
+ *
+ * A file is memory-mapped and split into chunks at line boundaries that are parsed by
+ * separate threads. Publishers (by name, email and year) and series (by name) are interned:
+ * all books of one publisher or series share one object, also across imports with the same
+ * importer. A row that fails validation, or repeats an ISBN of an earlier row, is reported
+ * with its line number and skipped, the other rows are still imported.
+ */
+class CatalogueImporter {
+public:
+    /**
+     * @brief Validation error of one catalogue line
+     */
+    struct RowError {
+        std::size_t line;       ///< Line number, starting from 1
+        std::string message;    ///< Message of the validation exception
+    };
+
+    /**
+     * @brief Result of one import
+     */
+    struct Result {
+        std::vector<std::shared_ptr<Book>> books;   ///< Imported books in file order
+        std::vector<RowError> errors;               ///< Rejected lines in file order
+    };
+
+private:
+    std::size_t threads;                                                        ///< Number of parsing threads
+    mutable std::mutex internMutex;                                             ///< Guards the interning tables
+    std::unordered_map<std::string, std::shared_ptr<Publisher>> publishers;     ///< Interned publishers by key
+    std::unordered_map<std::string, std::shared_ptr<BookSeries>> series;        ///< Interned series by name
+
+    struct ChunkResult;     ///< Books and errors of one chunk
+    class ChunkParser;      ///< Parser of one chunk, keeps a local cache of interned objects
+
+    /**
+     * @brief Private method to parse a text split into chunks by several threads
+     *
+     * @param text catalogue text
+     *
+     * @return Result containing books and errors of all chunks
+     */
+    Result parse(std::string_view text);
+
+    /**
+     * @brief Private method to get the shared publisher, creating it on first use
+     *
+     * @param name constant reference to the string containing publisher name
+     * @param email constant reference to the string containing contact email
+     * @param foundationYear integer value containing foundation year
+     *
+     * @return std::shared_ptr<Publisher> containing interned publisher
+     *
+     * @throws DataValidationException if publisher data are invalid
+     */
+    std::shared_ptr<Publisher> internPublisher(const std::string& name, const std::string& email, int foundationYear);
+
+    /**
+     * @brief Private method to get the shared series, creating it on first use
+     *
+     * @param name constant reference to the string containing series name
+     *
+     * @return std::shared_ptr<BookSeries> containing interned series
+     *
+     * @throws DataValidationException if series name is invalid
+     */
+    std::shared_ptr<BookSeries> internSeries(const std::string& name);
+
+public:
+    /**
+     * @brief Construct a new CatalogueImporter object
+     *
+     * @param threads number of parsing threads, 0 - all cores
+     */
+    explicit CatalogueImporter(std::size_t threads = 0);
+
+    /**
+     * @brief Import a catalogue file
+     *
+     * @param path constant reference to the string containing file path
+     *
+     * @return Result containing imported books and rejected lines
+     *
+     * @throws WarehouseException if the file cannot be opened or mapped
+     */
+    Result importFile(const std::string& path);
+
+    /**
+     * @brief Import a catalogue already in memory
+     *
+     * @param text catalogue text
+     *
+     * @return Result containing imported books and rejected lines
+     */
+    Result importText(std::string_view text);
+
+    /**
+     * @brief Get the number of interned publishers
+     *
+     * @return std::size_t containing number of distinct publishers seen so far
+     */
+    std::size_t getPublisherCount() const noexcept;
+
+    /**
+     * @brief Get the number of interned series
+     *
+     * @return std::size_t containing number of distinct series seen so far
+     */
+    std::size_t getSeriesCount() const noexcept;
+};
@@ -9,7 +9,14 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
+
+class WarehouseSnapshot;
 
 /**
  * @class ISBN
@@ -17,10 +24,28 @@
  * 
  * Handles ISBN validation, normalization, formatting and comparison.
  * Supports both ISBN-10 and ISBN-13 formats with check digit verification.
+ * The code is stored packed: as the ISBN-13 number, an ISBN-10 is converted
+ * on construction (978 prefix). Comparison and hashing use this number only,
+ * so an ISBN-10 is equal to its ISBN-13 form, and the hash is computed once.
  */
 class ISBN{
+    friend class WarehouseSnapshot;   ///< Restores the state saved in a snapshot without revalidation
+
+    public:
+    static constexpr std::uint64_t INVALID_CODE = UINT64_MAX;   ///< Result of pack() for an invalid ISBN
+
     private:
-    std::string code;   ///< Normalized ISBN code without formatting
+    std::uint64_t code;     ///< ISBN-13 as a number
+    std::size_t hash;       ///< Precomputed hash of code
+    bool thirteen;          ///< true if ISBN was given in 13-digit format
+
+    /**
+     * @brief Private constructor from an already validated packed code
+     * 
+     * @param code ISBN-13 as a number
+     * @param thirteen true if ISBN was given in 13-digit format
+     */
+    ISBN(std::uint64_t code, bool thirteen) noexcept;
 
     /**
      * @brief Private method to validate ISBN format
@@ -50,6 +75,14 @@ class ISBN{
      */
     char calculateCheckDigit(const std::string& str) const;
 
+    /**
+     * @brief Private method to convert the first nine digits of ISBN-10 to packed ISBN-13
+     * 
+     * @param firstNine first nine digits of ISBN-10 as a number
+     * @return std::uint64_t containing ISBN-13 as a number
+     */
+    static std::uint64_t fromTenDigits(std::uint64_t firstNine) noexcept;
+
     public:
     /**
      * @brief Construct a new ISBN object
@@ -58,13 +91,62 @@ class ISBN{
      */
     explicit ISBN(const std::string& str);
 
+    /**
+     * @brief Create ISBN from a packed ISBN-13 number
+     * 
+     * @param code ISBN-13 as a number (e.g., 9783161484100)
+     * 
+     * @return ISBN in 13-digit format
+     * 
+     * @throws InvalidISBNException if code is not a valid ISBN-13
+     */
+    static ISBN fromPacked(std::uint64_t code);
+
+    /**
+     * @brief Validate ISBN string and pack it without constructing an object
+     * 
+     * Accepts the same strings as the constructor.
+     * 
+     * @param str ISBN-10 or ISBN-13, hyphens allowed
+     * 
+     * @return std::uint64_t containing ISBN-13 as a number or INVALID_CODE
+     */
+    static std::uint64_t pack(std::string_view str) noexcept;
+
+    /**
+     * @brief Validate and pack many ISBN strings at once
+     * 
+     * Intended for catalogue imports. Codes are normalized into digit columns
+     * in blocks, and check sums of a whole block are computed in loops the
+     * compiler vectorizes.
+     * 
+     * @param codes ISBN-10 or ISBN-13 strings, hyphens allowed
+     * 
+     * @return std::vector<std::uint64_t> containing ISBN-13 number or INVALID_CODE per string
+     */
+    static std::vector<std::uint64_t> packAll(const std::vector<std::string_view>& codes);
+
     /**
      * @brief Get the normalized ISBN code
      * 
-     * @return std::string containing normalized ISBN code
+     * @return std::string containing normalized ISBN code in its original format
      */
     std::string getCode() const noexcept;
 
+    /**
+     * @brief Get the packed ISBN code
+     * 
+     * @return std::uint64_t containing ISBN-13 as a number
+     */
+    std::uint64_t getPackedCode() const noexcept;
+
+    /**
+     * @brief Get the precomputed hash
+     * 
+     * @return std::size_t containing hash of the packed code
+     */
+    std::size_t getHash() const noexcept;
+
     /**
      * @brief Get the formatted ISBN code
      * 
@@ -83,6 +165,8 @@ class ISBN{
     /**
      * @brief Equality comparison operator for ISBN codes
      * 
+     * ISBN-10 is equal to its ISBN-13 form.
+     * 
      * @param other constant reference to the ISBN to compare with
      * 
      * @return true if ISBN codes are equal
@@ -99,4 +183,16 @@ class ISBN{
      * @return false if ISBN codes are equal
      */
     bool operator!=(const ISBN& other) const noexcept;
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Hash of ISBN for unordered containers, uses the precomputed value
+ */
+namespace std {
+template <>
+struct hash<ISBN> {
+    std::size_t operator()(const ISBN& isbn) const noexcept {
+        return isbn.getHash();
+    }
+};
+}
@@ -0,0 +1,470 @@
+#include "CatalogueImporter.hpp"
+#include "exceptions/WarehouseExceptions.hpp"
+#include "config/BookConfig.hpp"
+#include "utils/MappedFile.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <exception>
+#include <thread>
+#include <unordered_set>
+
+namespace {
+enum Field : std::size_t {
+    ISBN_FIELD, TITLE, SUBTITLE, LANGUAGE, YEAR, EDITION, GENRE, CONDITION, PRICE,
+    PUBLISHER, PUBLISHER_EMAIL, PUBLISHER_YEAR, SERIES, WEIGHT, HEIGHT, WIDTH,
+    THICKNESS, PAGES, COVER, MATERIAL, FIELD_COUNT
+};
+
+constexpr std::array<std::string_view, FIELD_COUNT> FIELD_NAMES = {
+    "isbn", "title", "subtitle", "language", "year", "edition", "genre", "condition", "price",
+    "publisher", "publisherEmail", "publisherYear", "series", "weight", "height", "width",
+    "thickness", "pages", "cover", "material"
+};
+
+using Fields = std::array<std::string, FIELD_COUNT>; // empty string - field is absent
+
+void splitCsv(std::string_view line, Fields& fields) {
+    std::size_t field = 0;
+    std::size_t pos = 0;
+    while (true) {
+        if (field == FIELD_COUNT) {
+            throw DataValidationException("Too many CSV columns");
+        }
+        std::string& value = fields[field++];
+        if (pos < line.size() && line[pos] == '"') {
+            for (++pos; ; ++pos) {
+                if (pos == line.size()) {
+                    throw DataValidationException("Unterminated quoted CSV field");
+                }
+                if (line[pos] == '"') {
+                    if (pos + 1 < line.size() && line[pos + 1] == '"') {
+                        value += '"';
+                        ++pos;
+                    } else {
+                        break;
+                    }
+                } else {
+                    value += line[pos];
+                }
+            }
+            ++pos;
+            if (pos < line.size() && line[pos] != ',') {
+                throw DataValidationException("Unexpected character after quoted CSV field");
+            }
+        } else {
+            std::size_t end = std::min(line.find(',', pos), line.size());
+            value.assign(line.substr(pos, end - pos));
+            pos = end;
+        }
+        if (pos == line.size()) {
+            return;
+        }
+        ++pos; // comma
+    }
+}
+
+void appendUtf8(std::string& out, unsigned long codePoint) {
+    if (codePoint < 0x80) {
+        out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+/**
+ * @brief Parser of one flat JSON object: string, number and null values
+ */
+class JsonLine {
+public:
+    explicit JsonLine(std::string_view line) : line(line) {}
+
+    void parse(Fields& fields) {
+        expect('{');
+        skipSpaces();
+        if (peek() == '}') {
+            ++pos;
+        } else {
+            while (true) {
+                std::string key = parseString();
+                expect(':');
+                skipSpaces();
+                std::string value = parseValue();
+                auto name = std::find(FIELD_NAMES.begin(), FIELD_NAMES.end(), key);
+                if (name != FIELD_NAMES.end()) { // other keys are ignored
+                    fields[name - FIELD_NAMES.begin()] = std::move(value);
+                }
+                skipSpaces();
+                if (peek() == ',') {
+                    ++pos;
+                    skipSpaces();
+                    continue;
+                }
+                expect('}');
+                break;
+            }
+        }
+        skipSpaces();
+        if (pos != line.size()) {
+            fail("Unexpected characters after JSON object");
+        }
+    }
+
+private:
+    std::string_view line;
+    std::size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& message) const {
+        throw DataValidationException(message + " at column " + std::to_string(pos + 1));
+    }
+
+    char peek() const noexcept {
+        return pos < line.size() ? line[pos] : '\0';
+    }
+
+    void skipSpaces() noexcept {
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+    }
+
+    void expect(char c) {
+        skipSpaces();
+        if (peek() != c) {
+            fail(std::string("Expected '") + c + "'");
+        }
+        ++pos;
+    }
+
+    unsigned long parseHex4() {
+        if (pos + 4 > line.size()) fail("Invalid \\u escape");
+        unsigned long value = 0;
+        auto result = std::from_chars(line.data() + pos, line.data() + pos + 4, value, 16);
+        if (result.ptr != line.data() + pos + 4) fail("Invalid \\u escape");
+        pos += 4;
+        return value;
+    }
+
+    std::string parseString() {
+        if (peek() != '"') fail("Expected string");
+        std::string value;
+        for (++pos; ; ) {
+            if (pos >= line.size()) fail("Unterminated JSON string");
+            char c = line[pos++];
+            if (c == '"') return value;
+            if (c != '\\') {
+                value += c;
+                continue;
+            }
+            if (pos >= line.size()) fail("Unterminated JSON string");
+            switch (line[pos++]) {
+                case '"': value += '"'; break;
+                case '\\': value += '\\'; break;
+                case '/': value += '/'; break;
+                case 'b': value += '\b'; break;
+                case 'f': value += '\f'; break;
+                case 'n': value += '\n'; break;
+                case 'r': value += '\r'; break;
+                case 't': value += '\t'; break;
+                case 'u': {
+                    unsigned long codePoint = parseHex4();
+                    if (codePoint >= 0xD800 && codePoint < 0xDC00 && line.substr(pos, 2) == "\\u") { // surrogate pair
+                        pos += 2;
+                        unsigned long low = parseHex4();
+                        if (low < 0xDC00 || low >= 0xE000) fail("Invalid surrogate pair");
+                        codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(value, codePoint);
+                    break;
+                }
+                default: fail("Invalid escape in JSON string");
+            }
+        }
+    }
+
+    std::string parseValue() {
+        if (peek() == '"') return parseString();
+        if (line.substr(pos, 4) == "null") {
+            pos += 4;
+            return "";
+        }
+        std::size_t begin = pos;
+        while (pos < line.size() && std::string_view("+-.0123456789eE").find(line[pos]) != std::string_view::npos) ++pos;
+        if (pos == begin) fail("Expected string, number or null");
+        return std::string(line.substr(begin, pos - begin));
+    }
+};
+
+int toInt(const Fields& fields, Field field, int defaultValue, bool required) {
+    const std::string& text = fields[field];
+    if (text.empty()) {
+        if (required) {
+            throw DataValidationException("Missing " + std::string(FIELD_NAMES[field]));
+        }
+        return defaultValue;
+    }
+    int value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        throw DataValidationException("Invalid " + std::string(FIELD_NAMES[field]) + ": '" + text + "'");
+    }
+    return value;
+}
+
+double toDouble(const Fields& fields, Field field, double defaultValue) {
+    const std::string& text = fields[field];
+    if (text.empty()) return defaultValue;
+    double value = 0;
+    auto result = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (result.ec != std::errc() || result.ptr != text.data() + text.size()) {
+        throw DataValidationException("Invalid " + std::string(FIELD_NAMES[field]) + ": '" + text + "'");
+    }
+    return value;
+}
+
+const std::string& required(const Fields& fields, Field field) {
+    if (fields[field].empty()) {
+        throw DataValidationException("Missing " + std::string(FIELD_NAMES[field]));
+    }
+    return fields[field];
+}
+
+// Enumerator by its name, case-insensitive
+template <typename Enum, std::size_t N>
+Enum toEnum(const Fields& fields, Field field, const std::array<std::pair<std::string_view, Enum>, N>& names, Enum defaultValue) {
+    const std::string& text = fields[field];
+    if (text.empty()) return defaultValue;
+    for (const auto& name : names) {
+        if (name.first.size() == text.size() &&
+            std::equal(text.begin(), text.end(), name.first.begin(), [](char a, char b) {
+                return std::toupper(static_cast<unsigned char>(a)) == b;
+            })) {
+            return name.second;
+        }
+    }
+    throw DataValidationException("Unknown " + std::string(FIELD_NAMES[field]) + ": '" + text + "'");
+}
+
+const std::array<std::pair<std::string_view, Genre::Type>, 12> GENRES = {{
+    {"MYSTERY", Genre::Type::MYSTERY}, {"THRILLER", Genre::Type::THRILLER},
+    {"FANTASY", Genre::Type::FANTASY}, {"SCIENCE_FICTION", Genre::Type::SCIENCE_FICTION},
+    {"ROMANCE", Genre::Type::ROMANCE}, {"HISTORICAL_FICTION", Genre::Type::HISTORICAL_FICTION},
+    {"HORROR", Genre::Type::HORROR}, {"FOR_CHILDREN", Genre::Type::FOR_CHILDREN},
+    {"AUTOBIOGRAPHY", Genre::Type::AUTOBIOGRAPHY}, {"DRAMA", Genre::Type::DRAMA},
+    {"POETRY", Genre::Type::POETRY}, {"OTHER", Genre::Type::OTHER}
+}};
+
+const std::array<std::pair<std::string_view, BookCondition::Condition>, 6> CONDITIONS = {{
+    {"NEW", BookCondition::Condition::NEW}, {"LIKE_NEW", BookCondition::Condition::LIKE_NEW},
+    {"VERY_GOOD", BookCondition::Condition::VERY_GOOD}, {"GOOD", BookCondition::Condition::GOOD},
+    {"FAIR", BookCondition::Condition::FAIR}, {"POOR", BookCondition::Condition::POOR}
+}};
+
+const std::array<std::pair<std::string_view, PhysicalProperties::CoverType>, 2> COVERS = {{
+    {"HARDCOVER", PhysicalProperties::CoverType::HARDCOVER}, {"PAPERBACK", PhysicalProperties::CoverType::PAPERBACK}
+}};
+}
+
+struct CatalogueImporter::ChunkResult {
+    std::vector<std::shared_ptr<Book>> books;
+    std::vector<std::size_t> bookLines;     // line of each book within the chunk
+    std::vector<RowError> errors;           // line numbers within the chunk
+    std::size_t lines = 0;
+};
+
+/**
+ * @brief Parses the lines of one chunk into books
+ *
+ * Interned objects are looked up in a local cache first, so the shared
+ * tables are locked only when a chunk meets a publisher or series for the first time.
+ */
+class CatalogueImporter::ChunkParser {
+public:
+    explicit ChunkParser(CatalogueImporter& importer) : importer(importer) {}
+
+    void parse(std::string_view chunk, ChunkResult& result) {
+        Fields fields;
+        std::size_t pos = 0;
+        while (pos < chunk.size()) {
+            std::size_t end = std::min(chunk.find('\n', pos), chunk.size());
+            std::string_view line = chunk.substr(pos, end - pos);
+            pos = end + 1;
+            result.lines++;
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.empty() || line[0] == '#' || line.substr(0, 5) == "isbn,") continue;
+            try {
+                for (auto& field : fields) field.clear();
+                if (line[0] == '{') {
+                    JsonLine(line).parse(fields);
+                } else {
+                    splitCsv(line, fields);
+                }
+                result.books.push_back(build(fields));
+                result.bookLines.push_back(result.lines);
+            } catch (const WarehouseException& e) {
+                result.errors.push_back({result.lines, e.what()});
+            }
+        }
+    }
+
+private:
+    CatalogueImporter& importer;
+    std::unordered_map<std::string, std::shared_ptr<Publisher>> publishers;
+    std::unordered_map<std::string, std::shared_ptr<BookSeries>> series;
+
+    std::shared_ptr<Book> build(const Fields& fields) {
+        ISBN isbn(required(fields, ISBN_FIELD));
+        const std::string& language = required(fields, LANGUAGE);
+        BookTitle title(required(fields, TITLE), fields[SUBTITLE], language);
+        BookMetadata metadata(toInt(fields, YEAR, 0, true), language, toInt(fields, EDITION, 1, false));
+        PhysicalProperties physicalProps(toInt(fields, WEIGHT, 1, false), toInt(fields, HEIGHT, 1, false),
+                                         toInt(fields, WIDTH, 1, false), toInt(fields, THICKNESS, 1, false),
+                                         toInt(fields, PAGES, 1, false),
+                                         toEnum(fields, COVER, COVERS, PhysicalProperties::CoverType::HARDCOVER),
+                                         fields[MATERIAL].empty() ? "NO" : fields[MATERIAL]);
+        Genre genre(toEnum(fields, GENRE, GENRES, Genre::Type::OTHER));
+        BookCondition condition(toEnum(fields, CONDITION, CONDITIONS, BookCondition::Condition::NEW));
+        double price = toDouble(fields, PRICE, 0.0);
+        std::shared_ptr<Publisher> publisher = internPublisher(required(fields, PUBLISHER), fields[PUBLISHER_EMAIL],
+                                                               toInt(fields, PUBLISHER_YEAR, 0, true));
+        std::shared_ptr<BookSeries> bookSeries = fields[SERIES].empty() ? nullptr : internSeries(fields[SERIES]);
+        return std::make_shared<Book>(isbn, title, metadata, physicalProps, genre, publisher, condition, price, bookSeries);
+    }
+
+    std::shared_ptr<Publisher> internPublisher(const std::string& name, const std::string& email, int foundationYear) {
+        std::string key = name + '\n' + email + '\n' + std::to_string(foundationYear);
+        auto found = publishers.find(key);
+        if (found != publishers.end()) return found->second;
+        auto publisher = importer.internPublisher(name, email, foundationYear);
+        publishers.emplace(std::move(key), publisher);
+        return publisher;
+    }
+
+    std::shared_ptr<BookSeries> internSeries(const std::string& name) {
+        auto found = series.find(name);
+        if (found != series.end()) return found->second;
+        auto bookSeries = importer.internSeries(name);
+        series.emplace(name, bookSeries);
+        return bookSeries;
+    }
+};
+
+CatalogueImporter::CatalogueImporter(std::size_t threads) : threads(threads) {
+    if (this->threads == 0) {
+        this->threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+}
+
+std::shared_ptr<Publisher> CatalogueImporter::internPublisher(const std::string& name, const std::string& email, int foundationYear) {
+    std::string key = name + '\n' + email + '\n' + std::to_string(foundationYear);
+    std::lock_guard<std::mutex> lock(internMutex);
+    auto found = publishers.find(key);
+    if (found != publishers.end()) return found->second;
+    auto publisher = std::make_shared<Publisher>(name, email, foundationYear); // invalid data throw, nothing is stored
+    publishers.emplace(std::move(key), publisher);
+    return publisher;
+}
+
+std::shared_ptr<BookSeries> CatalogueImporter::internSeries(const std::string& name) {
+    std::lock_guard<std::mutex> lock(internMutex);
+    auto found = series.find(name);
+    if (found != series.end()) return found->second;
+    auto bookSeries = std::make_shared<BookSeries>(name);
+    series.emplace(name, bookSeries);
+    return bookSeries;
+}
+
+CatalogueImporter::Result CatalogueImporter::parse(std::string_view text) {
+    // Chunks end after a line break, so no line is split between threads
+    std::size_t chunkCount = std::max<std::size_t>(1, std::min(threads, text.size() / BookConfig::CatalogueImporter::MIN_CHUNK_SIZE));
+    std::vector<std::string_view> chunks;
+    std::size_t begin = 0;
+    for (std::size_t k = 1; k <= chunkCount; ++k) {
+        std::size_t end = text.size();
+        if (k < chunkCount) {
+            end = std::max(begin, k * text.size() / chunkCount);
+            end = std::min(text.find('\n', end), text.size());
+            end = std::min(end + 1, text.size());
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+
+    std::vector<ChunkResult> results(chunks.size());
+    std::vector<std::exception_ptr> failures(chunks.size());
+    auto work = [&](std::size_t k) {
+        try {
+            ChunkParser(*this).parse(chunks[k], results[k]);
+        } catch (...) { // not a validation error, e.g. std::bad_alloc
+            failures[k] = std::current_exception();
+        }
+    };
+    std::vector<std::thread> workers;
+    for (std::size_t k = 1; k < chunks.size(); ++k) {
+        workers.emplace_back(work, k);
+    }
+    work(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    for (const auto& failure : failures) {
+        if (failure) std::rethrow_exception(failure);
+    }
+
+    Result result;
+    std::size_t totalBooks = 0;
+    for (const auto& chunk : results) {
+        totalBooks += chunk.books.size();
+    }
+    result.books.reserve(totalBooks);
+    std::unordered_set<ISBN> seen;
+    seen.reserve(totalBooks);
+    std::size_t firstLine = 0;
+    for (auto& chunk : results) {
+        std::size_t error = 0;
+        for (std::size_t i = 0; i < chunk.books.size(); ++i) { // merge books and errors in line order
+            std::size_t line = chunk.bookLines[i];
+            for (; error < chunk.errors.size() && chunk.errors[error].line < line; ++error) {
+                result.errors.push_back({firstLine + chunk.errors[error].line, std::move(chunk.errors[error].message)});
+            }
+            if (seen.insert(chunk.books[i]->getISBN()).second) {
+                result.books.push_back(std::move(chunk.books[i]));
+            } else {
+                result.errors.push_back({firstLine + line, "Duplicate ISBN: " + chunk.books[i]->getISBN().getCode()});
+            }
+        }
+        for (; error < chunk.errors.size(); ++error) {
+            result.errors.push_back({firstLine + chunk.errors[error].line, std::move(chunk.errors[error].message)});
+        }
+        firstLine += chunk.lines;
+    }
+    return result;
+}
+
+CatalogueImporter::Result CatalogueImporter::importFile(const std::string& path) {
+    MappedFile file(path);
+    return parse(file.text());
+}
+
+CatalogueImporter::Result CatalogueImporter::importText(std::string_view text) {
+    return parse(text);
+}
+
+std::size_t CatalogueImporter::getPublisherCount() const noexcept {
+    std::lock_guard<std::mutex> lock(internMutex);
+    return publishers.size();
+}
+
+std::size_t CatalogueImporter::getSeriesCount() const noexcept {
+    std::lock_guard<std::mutex> lock(internMutex);
+    return series.size();
+}
@@ -1,5 +1,51 @@
 #include "ISBN.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
+#include <algorithm>
+
+namespace {
+constexpr std::size_t MAX_DIGITS = 13;
+constexpr std::size_t BLOCK = 256;   // codes per column block of packAll()
+
+// Digit values of str without separators (X as 10) written with the given stride,
+// positions after the last digit are zeroed. Returns 10 or 13, or 0 (all zeroed) for an invalid format
+std::size_t normalizeDigits(std::string_view str, std::uint8_t* digits, std::size_t stride) noexcept {
+    std::size_t length = 0;
+    bool hasX = false;
+    bool valid = true;
+    for (char c : str) {
+        bool isDigit = c >= '0' && c <= '9';
+        if (!isDigit && c != 'X' && c != 'x') continue;
+        if (length == MAX_DIGITS || hasX) { // too long or X not last
+            valid = false;
+            break;
+        }
+        hasX = !isDigit;
+        digits[length++ * stride] = isDigit ? static_cast<std::uint8_t>(c - '0') : 10;
+    }
+    valid = valid && (length == 10 || (length == MAX_DIGITS && !hasX)); // X is only the check digit of ISBN-10
+    if (!valid) length = 0;
+    for (std::size_t position = length; position < MAX_DIGITS; ++position) {
+        digits[position * stride] = 0;
+    }
+    return length;
+}
+
+// Weights of the check sums: a valid ISBN-13 has sum % 10 == 0, a valid ISBN-10 has sum % 11 == 0
+constexpr std::uint32_t weightThirteen(std::size_t position) noexcept {
+    return position % 2 == 0 ? 1 : 3;
+}
+
+constexpr std::uint32_t weightTen(std::size_t position) noexcept {
+    return position < 10 ? static_cast<std::uint32_t>(10 - position) : 0;
+}
+
+// SplitMix64 finalizer, spreads consecutive ISBNs over buckets
+std::size_t mix(std::uint64_t value) noexcept {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<std::size_t>(value ^ (value >> 31));
+}
+}
 
 bool ISBN::isValidFormat(const std::string& str) const{
     std::string normalized = normalizeISBN(str);
@@ -50,6 +96,17 @@ char ISBN::calculateCheckDigit(const std::string& str) const {
     }
 }
 
+std::uint64_t ISBN::fromTenDigits(std::uint64_t firstNine) noexcept {
+    std::uint64_t firstTwelve = 978000000000ULL + firstNine;
+    std::uint32_t sum = 0;
+    std::uint64_t rest = firstTwelve;
+    for (std::size_t position = 12; position-- > 0; rest /= 10) {
+        sum += weightThirteen(position) * static_cast<std::uint32_t>(rest % 10);
+    }
+    return firstTwelve * 10 + (10 - sum % 10) % 10;
+}
+
+ISBN::ISBN(std::uint64_t code, bool thirteen) noexcept : code(code), hash(mix(code)), thirteen(thirteen) {}
 
 ISBN::ISBN(const std::string& str) {
     std::string normalized = normalizeISBN(str);
@@ -61,14 +118,104 @@ ISBN::ISBN(const std::string& str) {
     if (actualCheckDigit != calculatedCheckDigit) {
         throw InvalidISBNException("Check digit mismatch: " + str);
     }
-    code = normalized;
+    thirteen = normalized.length() == 13;
+    code = thirteen ? std::stoull(normalized) : fromTenDigits(std::stoull(normalized.substr(0, 9)));
+    hash = mix(code);
+}
+
+ISBN ISBN::fromPacked(std::uint64_t code) {
+    if (code > 9999999999999ULL) {
+        throw InvalidISBNException("Invalid packed code: " + std::to_string(code));
+    }
+    std::uint32_t sum = 0;
+    std::uint64_t rest = code;
+    for (std::size_t position = MAX_DIGITS; position-- > 0; rest /= 10) {
+        sum += weightThirteen(position) * static_cast<std::uint32_t>(rest % 10);
+    }
+    if (sum % 10 != 0) {
+        throw InvalidISBNException("Check digit mismatch: " + std::to_string(code));
+    }
+    return ISBN(code, true);
+}
+
+std::uint64_t ISBN::pack(std::string_view str) noexcept {
+    std::uint8_t digits[MAX_DIGITS];
+    std::size_t length = normalizeDigits(str, digits, 1);
+    std::uint32_t sumThirteen = 0;
+    std::uint32_t sumTen = 0;
+    std::uint64_t value = 0;
+    for (std::size_t position = 0; position < MAX_DIGITS; ++position) {
+        sumThirteen += weightThirteen(position) * digits[position];
+        sumTen += weightTen(position) * digits[position];
+        value = value * 10 + digits[position];
+    }
+    if (length == MAX_DIGITS && sumThirteen % 10 == 0) {
+        return value;
+    }
+    if (length == 10 && sumTen % 11 == 0) {
+        return fromTenDigits((value - digits[9] * 1000ULL) / 10000);
+    }
+    return INVALID_CODE;
+}
+
+std::vector<std::uint64_t> ISBN::packAll(const std::vector<std::string_view>& codes) {
+    std::vector<std::uint64_t> packed(codes.size(), INVALID_CODE);
+    // Digit j of code i is digits[j][i]: the loops over i below have no dependencies and vectorize
+    std::uint8_t digits[MAX_DIGITS][BLOCK];
+    std::size_t lengths[BLOCK];
+    std::uint32_t sumThirteen[BLOCK];
+    std::uint32_t sumTen[BLOCK];
+    std::uint64_t value[BLOCK];
+    for (std::size_t first = 0; first < codes.size(); first += BLOCK) {
+        std::size_t count = std::min(BLOCK, codes.size() - first);
+        for (std::size_t i = 0; i < BLOCK; ++i) { // unused lanes of the last block are zeroed
+            lengths[i] = normalizeDigits(i < count ? codes[first + i] : std::string_view(), &digits[0][i], BLOCK);
+        }
+        std::fill(sumThirteen, sumThirteen + BLOCK, 0);
+        std::fill(sumTen, sumTen + BLOCK, 0);
+        std::fill(value, value + BLOCK, 0);
+        for (std::size_t position = 0; position < MAX_DIGITS; ++position) {
+            const std::uint8_t* column = digits[position];
+            const std::uint32_t weight13 = weightThirteen(position);
+            const std::uint32_t weight10 = weightTen(position);
+            for (std::size_t i = 0; i < BLOCK; ++i) { // fixed trip count, vectorized at -O2
+                sumThirteen[i] += weight13 * column[i];
+                sumTen[i] += weight10 * column[i];
+                value[i] = value[i] * 10 + column[i];
+            }
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            if (lengths[i] == MAX_DIGITS && sumThirteen[i] % 10 == 0) {
+                packed[first + i] = value[i];
+            } else if (lengths[i] == 10 && sumTen[i] % 11 == 0) {
+                packed[first + i] = fromTenDigits((value[i] - digits[9][i] * 1000ULL) / 10000);
+            }
+        }
+    }
+    return packed;
 }
 
 std::string ISBN::getCode() const noexcept{
+    if (thirteen) {
+        std::string digits = std::to_string(code);
+        return std::string(MAX_DIGITS - digits.length(), '0') + digits;
+    }
+    std::string firstNine = std::to_string(code / 10 % 1000000000ULL);
+    std::string result = std::string(9 - firstNine.length(), '0') + firstNine + "0";
+    result.back() = calculateCheckDigit(result);
+    return result;
+}
+
+std::uint64_t ISBN::getPackedCode() const noexcept{
     return code;
 }
 
+std::size_t ISBN::getHash() const noexcept{
+    return hash;
+}
+
 std::string ISBN::getFormattedCode() const noexcept{
+    std::string code = getCode();
     if (!isISBNThirteen()) {
         return code.substr(0, 1) + "-" + code.substr(1, 3) + "-" + 
                code.substr(4, 5) + "-" + code.substr(9, 1);
@@ -81,7 +228,7 @@ std::string ISBN::getFormattedCode() const noexcept{
 }
 
 bool ISBN::isISBNThirteen() const{
-    return code.length() == 13;
+    return thirteen;
 }
 
 bool ISBN::operator==(const ISBN& other) const noexcept{
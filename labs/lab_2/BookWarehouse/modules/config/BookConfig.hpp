@@ -101,6 +101,14 @@ namespace BookConfig {
         static constexpr size_t MAX_DESCRIPTION_LENGTH = 500; ///< Maximum allowed collection description length
     }
 
+    /**
+     * @namespace CatalogueImporter
+     * @brief Configuration constants for CatalogueImporter class
+     */
+    namespace CatalogueImporter {
+        static constexpr size_t MIN_CHUNK_SIZE = 1 << 20;     ///< Smallest part of a file parsed by one thread, bytes
+    }
+
     /**
      * @namespace StringValidation
      * @brief Configuration constants for StringValidation utilities
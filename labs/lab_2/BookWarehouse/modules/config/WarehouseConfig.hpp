@@ -90,6 +90,15 @@ namespace WarehouseConfig {
         static constexpr double MIN_TOTAL_COST = 0.0;           ///< Minimum total cost
     }
 
+    /**
+     * @namespace StockJournal
+     * @brief Configuration constants for StockJournal class
+     */
+    namespace StockJournal {
+        static constexpr int COMMIT_INTERVAL_MS = 10;          ///< Default interval between group commits (fsync)
+        static constexpr int MAX_COMMIT_INTERVAL_MS = 10000;   ///< Maximum interval between group commits
+    }
+
     /**
      * @namespace StringValidation
      * @brief Configuration constants for StringValidation utilities
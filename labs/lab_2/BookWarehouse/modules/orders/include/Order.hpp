@@ -120,9 +120,9 @@ public:
     /**
      * @brief Get all order items
      * 
-     * @return std::vector<std::shared_ptr<OrderItem>> containing all order items
+     * @return const std::vector<std::shared_ptr<OrderItem>>& containing all order items (valid until the order changes)
      */
-    std::vector<std::shared_ptr<OrderItem>> getItems() const noexcept;
+    const std::vector<std::shared_ptr<OrderItem>>& getItems() const noexcept;
 
     /**
      * @brief Set the order status
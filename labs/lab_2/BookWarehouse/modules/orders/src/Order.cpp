@@ -60,7 +60,7 @@ std::string Order::getNotes() const noexcept {
     return notes;
 }
 
-std::vector<std::shared_ptr<OrderItem>> Order::getItems() const noexcept {
+const std::vector<std::shared_ptr<OrderItem>>& Order::getItems() const noexcept {
     return items;
 }
 
@@ -79,10 +79,10 @@ void Order::addItem(std::shared_ptr<OrderItem> item) {
     if (!item) {
         throw DataValidationException("Order item cannot be null");
     }
-    std::string bookIsbn = item->getBook()->getISBN().getCode();
+    ISBN bookIsbn = item->getBook()->getISBN();
     for (const auto& existingItem : items) {
-        if (existingItem->getBook()->getISBN().getCode() == bookIsbn) {
-            throw DuplicateBookException("Book already exists in order: " + bookIsbn);
+        if (existingItem->getBook()->getISBN() == bookIsbn) {
+            throw DuplicateBookException("Book already exists in order: " + bookIsbn.getCode());
         }
     }
     items.push_back(item);
@@ -106,8 +106,9 @@ size_t Order::getItemCount() const noexcept {
 }
 
 bool Order::containsBook(const std::string& bookIsbn) const noexcept {
+    std::uint64_t code = ISBN::pack(bookIsbn); // compare packed codes, not strings
     for (const auto& item : items) {
-        if (item->getBook()->getISBN().getCode() == bookIsbn) {
+        if (item->getBook()->getISBN().getPackedCode() == code) {
             return true;
         }
     }
@@ -115,8 +116,9 @@ bool Order::containsBook(const std::string& bookIsbn) const noexcept {
 }
 
 int Order::getBookQuantity(const std::string& bookIsbn) const noexcept {
+    std::uint64_t code = ISBN::pack(bookIsbn);
     for (const auto& item : items) {
-        if (item->getBook()->getISBN().getCode() == bookIsbn) {
+        if (item->getBook()->getISBN().getPackedCode() == code) {
             return item->getQuantity();
         }
     }
@@ -0,0 +1,91 @@
+/**
+ * @file AtomicFile.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file with the AtomicFile class for replacing files without leaving partial contents
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ *
+ */
+
+#pragma once
+#include <cerrno>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <unistd.h>
+#include "exceptions/WarehouseExceptions.hpp"
+
+/**
+ * @class AtomicFile
+ * @brief Utility class for durable replacement of whole files
+ *
+ * The data are written to a temporary file next to the target, flushed to disk and
+ * renamed over the target, then the directory is flushed. After a crash the path holds
+ * either the old or the new contents, never a mix.
+ */
+class AtomicFile {
+public:
+    /**
+     * @brief Replace the contents of a file
+     *
+     * @param path constant reference to the string containing file path
+     * @param data bytes to write
+     *
+     * @throws WarehouseException if the file cannot be written
+     */
+    static void write(const std::string& path, std::string_view data) {
+        std::string temporaryPath = path + ".tmp";
+        int descriptor = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (descriptor < 0) {
+            throw WarehouseException("Cannot create file: " + temporaryPath);
+        }
+        bool complete = writeAll(descriptor, data) && ::fsync(descriptor) == 0;
+        complete = ::close(descriptor) == 0 && complete;
+        if (!complete || ::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+            ::unlink(temporaryPath.c_str());
+            throw WarehouseException("Cannot write file: " + path);
+        }
+        syncDirectory(path);
+    }
+
+    /**
+     * @brief Write all bytes to a descriptor, retrying short and interrupted writes
+     *
+     * @param descriptor open file descriptor
+     * @param data bytes to write
+     *
+     * @return true if all bytes were written
+     * @return false if writing failed
+     */
+    static bool writeAll(int descriptor, std::string_view data) noexcept {
+        std::size_t written = 0;
+        while (written < data.size()) {
+            ssize_t result = ::write(descriptor, data.data() + written, data.size() - written);
+            if (result < 0 && errno == EINTR) {
+                continue;
+            }
+            if (result <= 0) {
+                return false;
+            }
+            written += static_cast<std::size_t>(result);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Flush the directory holding a file, so that a created or renamed entry survives a crash
+     *
+     * @param path constant reference to the string containing file path
+     */
+    static void syncDirectory(const std::string& path) noexcept {
+        std::size_t slash = path.find_last_of('/');
+        std::string directory = slash == std::string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int descriptor = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if (descriptor >= 0) {
+            ::fsync(descriptor);
+            ::close(descriptor);
+        }
+    }
+};
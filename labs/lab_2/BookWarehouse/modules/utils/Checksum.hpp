@@ -0,0 +1,67 @@
+/**
+ * @file Checksum.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file with the Checksum class for detecting damaged files
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @class Checksum
+ * @brief Utility class for checksums of binary data
+ *
+ * FNV-1a applied to 64-bit words, with a shift after each step so that high bits
+ * also reach the low ones; the tail is padded with zeros. It detects truncated and
+ * corrupted files, it is not a protection against deliberate changes.
+ */
+class Checksum {
+public:
+    static constexpr std::uint64_t INITIAL = 0xcbf29ce484222325ULL;   ///< Checksum of no data
+
+    /**
+     * @brief Compute or continue a checksum
+     *
+     * @param data pointer to the first byte
+     * @param size number of bytes
+     * @param checksum checksum of the preceding data (a multiple of 8 bytes), INITIAL to start
+     *
+     * @return std::uint64_t containing checksum of the preceding data and this block
+     */
+    static std::uint64_t compute(const void* data, std::size_t size, std::uint64_t checksum = INITIAL) noexcept {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        std::size_t words = size / sizeof(std::uint64_t);
+        for (std::size_t i = 0; i < words; ++i) {
+            std::uint64_t word;
+            std::memcpy(&word, bytes + i * sizeof(word), sizeof(word));
+            checksum = mix(checksum ^ word);
+        }
+        std::size_t tail = size % sizeof(std::uint64_t);
+        if (tail != 0) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, bytes + words * sizeof(word), tail);
+            checksum = mix(checksum ^ word ^ (static_cast<std::uint64_t>(tail) << 56));
+        }
+        return checksum;
+    }
+
+private:
+    static constexpr std::uint64_t PRIME = 0x100000001b3ULL;   ///< FNV 64-bit prime
+
+    /**
+     * @brief Private method to mix the state after a word was added
+     *
+     * @param value state xor word
+     * @return std::uint64_t containing new state
+     */
+    static std::uint64_t mix(std::uint64_t value) noexcept {
+        value *= PRIME;
+        return value ^ (value >> 32);
+    }
+};
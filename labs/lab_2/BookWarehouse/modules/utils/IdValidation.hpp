@@ -0,0 +1,169 @@
+/**
+ * @file IdValidation.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file with compile-time matchers for the fixed identifier formats of the warehouse
+ * @version 0.1
+ * @date 2025-12-10
+ *
+ *
+ */
+
+#pragma once
+#include <string_view>
+
+/**
+ * @class IdValidation
+ * @brief Utility class for validating warehouse identifiers
+ *
+ * Every identifier of the warehouse has a fixed layout, so it is checked
+ * character by character against a format string instead of building
+ * a std::regex on each call. In a format '@' stands for an uppercase
+ * Latin letter, '#' for a decimal digit, any other character must match itself.
+ * All methods are constexpr and can be used in static_assert.
+ */
+class IdValidation {
+public:
+    /**
+     * @brief Check if identifier matches a fixed format
+     *
+     * @param id identifier to check
+     * @param format format string with '@' for a letter A-Z and '#' for a digit 0-9
+     *
+     * @return true if identifier has the same length and every character fits the format
+     * @return false otherwise
+     */
+    static constexpr bool matchesFormat(std::string_view id, std::string_view format) noexcept {
+        if (id.size() != format.size()) return false;
+        for (std::size_t i = 0; i < id.size(); i++) {
+            char c = id[i];
+            switch (format[i]) {
+                case '@':
+                    if (c < 'A' || c > 'Z') return false;
+                    break;
+                case '#':
+                    if (c < '0' || c > '9') return false;
+                    break;
+                default:
+                    if (c != format[i]) return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Validate document number in PREFIX-YYYY-NNN format
+     *
+     * @param id identifier to check (e.g., "REC-2025-001")
+     * @param prefix expected prefix (e.g., "REC")
+     *
+     * @return true if identifier is the prefix followed by "-####-###"
+     * @return false otherwise
+     */
+    static constexpr bool isValidDocumentNumber(std::string_view id, std::string_view prefix) noexcept {
+        return id.size() > prefix.size() && id.substr(0, prefix.size()) == prefix &&
+               matchesFormat(id.substr(prefix.size()), "-####-###");
+    }
+
+    /**
+     * @brief Validate stock movement ID (MOV, REC, WO, TRF or DEL prefix)
+     *
+     * @param id identifier to check (e.g., "REC-2025-001")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidMovementId(std::string_view id) noexcept {
+        return isValidDocumentNumber(id, "MOV") || isValidDocumentNumber(id, "REC") ||
+               isValidDocumentNumber(id, "WO") || isValidDocumentNumber(id, "TRF") ||
+               isValidDocumentNumber(id, "DEL");
+    }
+
+    /**
+     * @brief Validate delivery ID
+     *
+     * @param id identifier to check (e.g., "DEL-2025-001")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidDeliveryId(std::string_view id) noexcept {
+        return isValidDocumentNumber(id, "DEL");
+    }
+
+    /**
+     * @brief Validate purchase order number
+     *
+     * @param id identifier to check (e.g., "PO-2025-001")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidPurchaseOrderNumber(std::string_view id) noexcept {
+        return isValidDocumentNumber(id, "PO");
+    }
+
+    /**
+     * @brief Validate invoice number
+     *
+     * @param id identifier to check (e.g., "INV-2025-001")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidInvoiceNumber(std::string_view id) noexcept {
+        return isValidDocumentNumber(id, "INV");
+    }
+
+    /**
+     * @brief Validate employee ID
+     *
+     * @param id identifier to check (e.g., "EMP-001")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidEmployeeId(std::string_view id) noexcept {
+        return matchesFormat(id, "EMP-###");
+    }
+
+    /**
+     * @brief Validate warehouse section ID
+     *
+     * @param id identifier to check (e.g., "A")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidSectionId(std::string_view id) noexcept {
+        return matchesFormat(id, "@");
+    }
+
+    /**
+     * @brief Validate shelf ID
+     *
+     * @param id identifier to check (e.g., "A-01")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidShelfId(std::string_view id) noexcept {
+        return matchesFormat(id, "@-##");
+    }
+
+    /**
+     * @brief Validate storage location ID (Section-Shelf-Row-Cell)
+     *
+     * @param id identifier to check (e.g., "A-01-B-05")
+     *
+     * @return true if identifier is valid
+     * @return false otherwise
+     */
+    static constexpr bool isValidLocationId(std::string_view id) noexcept {
+        return matchesFormat(id, "@-##-@-##");
+    }
+};
+
+static_assert(IdValidation::isValidMovementId("REC-2025-001") && !IdValidation::isValidMovementId("REC-2025-01"),
+              "movement ID format");
+static_assert(IdValidation::isValidLocationId("A-01-B-05") && !IdValidation::isValidLocationId("a-01-B-05"),
+              "location ID format");
@@ -0,0 +1,84 @@
+/**
+ * @file MappedFile.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file with the MappedFile class for read-only memory mapping of files
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "exceptions/WarehouseExceptions.hpp"
+
+/**
+ * @class MappedFile
+ * @brief Read-only mapping of a whole file
+ *
+ * Pages are loaded by the OS on first access, so large files are read without
+ * copying them into buffers. The mapping is removed when the object is destroyed.
+ */
+class MappedFile {
+private:
+    const char* data = nullptr;   ///< First byte of the mapping, nullptr for an empty file
+    std::size_t size = 0;         ///< Size of the file in bytes
+
+public:
+    /**
+     * @brief Map a file
+     *
+     * @param path constant reference to the string containing file path
+     *
+     * @throws WarehouseException if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path) {
+        int descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) {
+            throw WarehouseException("Cannot open file: " + path);
+        }
+        struct stat info;
+        if (::fstat(descriptor, &info) != 0) {
+            ::close(descriptor);
+            throw WarehouseException("Cannot read file: " + path);
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (address == MAP_FAILED) {
+                ::close(descriptor);
+                throw WarehouseException("Cannot map file: " + path);
+            }
+            data = static_cast<const char*>(address);
+            ::madvise(address, size, MADV_SEQUENTIAL);
+        }
+        ::close(descriptor); // the mapping stays valid
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Unmap the file
+     */
+    ~MappedFile() {
+        if (data) {
+            ::munmap(const_cast<char*>(data), size);
+        }
+    }
+
+    /**
+     * @brief Get the contents of the file
+     *
+     * @return std::string_view containing all bytes of the file, valid while the object exists
+     */
+    std::string_view text() const noexcept {
+        return std::string_view(data, size);
+    }
+};
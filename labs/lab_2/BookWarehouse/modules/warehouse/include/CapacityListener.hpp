@@ -0,0 +1,136 @@
+/**
+ * @file CapacityListener.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the CapacityListener interface for propagating storage changes upward
+ * @version 0.1
+ * @date 2025-12-08
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class StorageLocation;
+
+/**
+ * @class CapacityListener
+ * @brief Interface for objects that follow changes of storage locations
+ *
+ * Storage locations notify their shelves, shelves notify their sections and sections
+ * notify the warehouse, so indexes and totals above a location are updated when
+ * it changes instead of being recomputed by scanning the whole structure.
+ */
+class CapacityListener {
+public:
+    /**
+     * @brief Destroy the CapacityListener object
+     */
+    virtual ~CapacityListener() = default;
+
+    /**
+     * @brief Called when a location becomes part of the observed structure
+     *
+     * @param location constant reference to the shared pointer of the added location
+     */
+    virtual void onLocationAttached(const std::shared_ptr<StorageLocation>& location) = 0;
+
+    /**
+     * @brief Called when a location is no longer part of the observed structure
+     *
+     * @param location constant reference to the removed location
+     */
+    virtual void onLocationDetached(const StorageLocation& location) = 0;
+
+    /**
+     * @brief Called after the load or the status of a location has changed
+     *
+     * @param location constant reference to the changed location
+     * @param loadDelta integer value containing change of the current load (0 if only the status changed)
+     */
+    virtual void onLocationChanged(const StorageLocation& location, int loadDelta) = 0;
+};
+
+/**
+ * @class CapacityListeners
+ * @brief List of listeners registered with one storage object
+ *
+ * A copy of an object is not registered anywhere, so copying the list yields an empty one.
+ */
+class CapacityListeners {
+private:
+    std::vector<CapacityListener*> listeners;   ///< Registered listeners, not owned
+
+public:
+    /**
+     * @brief Construct an empty list
+     */
+    CapacityListeners() = default;
+
+    /**
+     * @brief Construct an empty list instead of copying
+     */
+    CapacityListeners(const CapacityListeners&) noexcept {}
+
+    /**
+     * @brief Keep the current list instead of copying
+     *
+     * @return CapacityListeners& reference to this list
+     */
+    CapacityListeners& operator=(const CapacityListeners&) noexcept { return *this; }
+
+    /**
+     * @brief Register a listener
+     *
+     * @param listener pointer to the listener
+     */
+    void add(CapacityListener* listener) { listeners.push_back(listener); }
+
+    /**
+     * @brief Unregister one registration of a listener
+     *
+     * @param listener pointer to the listener
+     */
+    void remove(CapacityListener* listener) noexcept {
+        auto it = std::find(listeners.begin(), listeners.end(), listener);
+        if (it != listeners.end()) {
+            listeners.erase(it);
+        }
+    }
+
+    /**
+     * @brief Notify every listener about an added location
+     *
+     * @param location constant reference to the shared pointer of the added location
+     */
+    void notifyAttached(const std::shared_ptr<StorageLocation>& location) const {
+        for (auto* listener : listeners) {
+            listener->onLocationAttached(location);
+        }
+    }
+
+    /**
+     * @brief Notify every listener about a removed location
+     *
+     * @param location constant reference to the removed location
+     */
+    void notifyDetached(const StorageLocation& location) const {
+        for (auto* listener : listeners) {
+            listener->onLocationDetached(location);
+        }
+    }
+
+    /**
+     * @brief Notify every listener about a changed location
+     *
+     * @param location constant reference to the changed location
+     * @param loadDelta integer value containing change of the current load
+     */
+    void notifyChanged(const StorageLocation& location, int loadDelta) const {
+        for (auto* listener : listeners) {
+            listener->onLocationChanged(location, loadDelta);
+        }
+    }
+};
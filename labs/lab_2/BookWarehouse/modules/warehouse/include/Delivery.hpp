@@ -154,9 +154,9 @@ public:
     /**
      * @brief Get all books in delivery
      * 
-     * @return std::vector<std::shared_ptr<Book>> containing all books
+     * @return const std::vector<std::shared_ptr<Book>>& containing all books (valid until the delivery changes)
      */
-    std::vector<std::shared_ptr<Book>> getBooks() const noexcept;
+    const std::vector<std::shared_ptr<Book>>& getBooks() const noexcept;
 
     /**
      * @brief Get the associated stock receipt
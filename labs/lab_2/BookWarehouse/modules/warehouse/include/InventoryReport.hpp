@@ -9,6 +9,7 @@
  */
 
 #pragma once
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <vector>
@@ -40,8 +41,8 @@ private:
     // Stock analysis methods
     BookCounts calculateBookCounts(const std::vector<std::shared_ptr<InventoryItem>>& inventory) const;
     bool isValidInventoryItem(std::shared_ptr<InventoryItem> item) const;
-    BookCounts updateBookCounts(BookCounts counts, const std::string& currentIsbn, 
-                               const std::string& lastIsbn, int quantity) const;
+    BookCounts updateBookCounts(BookCounts counts, std::uint64_t currentIsbn, 
+                               std::uint64_t lastIsbn, int quantity) const;
 
     // Report building methods
     std::string buildBookHeader(const std::vector<std::shared_ptr<InventoryItem>>& items, 
@@ -56,14 +57,10 @@ private:
     
     // Location analysis methods
     std::string buildEmptyLocationsList(const std::vector<std::shared_ptr<StorageLocation>>& locations) const;
-    std::string buildEmptyLocationLine(std::shared_ptr<StorageLocation> location) const;
+    std::string buildEmptyLocationLine(const std::shared_ptr<StorageLocation>& location) const;
     std::vector<std::shared_ptr<StorageLocation>> findFullLocations() const;
-    void collectFullLocationsFromSection(std::shared_ptr<WarehouseSection> section,
-                                        std::vector<std::shared_ptr<StorageLocation>>& fullLocations) const;
-    void collectFullLocationsFromShelf(std::shared_ptr<Shelf> shelf,
-                                      std::vector<std::shared_ptr<StorageLocation>>& fullLocations) const;
     std::string buildFullLocationsList(const std::vector<std::shared_ptr<StorageLocation>>& fullLocations) const;
-    std::string buildFullLocationLine(std::shared_ptr<StorageLocation> location) const;
+    std::string buildFullLocationLine(const std::shared_ptr<StorageLocation>& location) const;
     
     // Statistics methods
     std::string buildBasicStatistics() const;
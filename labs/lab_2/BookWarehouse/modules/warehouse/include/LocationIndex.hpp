@@ -0,0 +1,214 @@
+/**
+ * @file LocationIndex.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the LocationIndex class - free space index of storage locations
+ * @version 0.1
+ * @date 2025-12-08
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "StorageLocation.hpp"
+#include "WarehouseSection.hpp"
+
+/**
+ * @class LocationIndex
+ * @brief Index of storage locations by free space for every section type
+ *
+ * A location takes part in searches while its status is FREE, with its available space
+ * as the key; other locations are kept with key -1. Locations are numbered in the order
+ * they were inserted. A segment tree over these numbers stores the largest key per
+ * section type and answers first-fit queries, ordered sets of (key, number) answer
+ * best-fit queries. Queries and updates are O(log n).
+ */
+class LocationIndex {
+public:
+    static constexpr std::size_t SECTION_TYPES = 5;   ///< Number of WarehouseSection::SectionType values
+    static constexpr std::size_t ANY_TYPE = SECTION_TYPES;   ///< Column for searches over all section types
+
+private:
+    using Keys = std::array<int, SECTION_TYPES + 1>;        ///< Largest key per section type and over all types
+
+    /**
+     * @brief Indexed location
+     */
+    struct Slot {
+        std::shared_ptr<StorageLocation> location;   ///< Location, nullptr once removed
+        std::size_t type;                            ///< Section type of the location
+        int freeSpace;                               ///< Current key
+        int references;                              ///< Number of insertions not yet removed
+    };
+
+    std::vector<Slot> slots;                                         ///< Locations in insertion order
+    std::unordered_map<const StorageLocation*, std::size_t> slotOf;  ///< Location -> slot number
+    std::size_t removedSlots = 0;                                    ///< Slots of removed locations
+    std::size_t leaves = 1;                                          ///< Leaves of the segment tree, power of two
+    std::vector<Keys> tree;                                          ///< Segment tree, node i has children 2i and 2i+1
+    std::array<std::set<std::pair<int, std::size_t>>, SECTION_TYPES + 1> byFreeSpace; ///< (key, slot) per section type
+
+    /**
+     * @brief Key of a location
+     *
+     * @param location constant reference to the location
+     *
+     * @return int containing available space of a FREE location or -1
+     */
+    static int freeSpaceOf(const StorageLocation& location) noexcept;
+
+    /**
+     * @brief Private method to write the key of a slot to the tree and the ordered sets
+     *
+     * @param slot index of the slot
+     * @param freeSpace new key
+     */
+    void setKey(std::size_t slot, int freeSpace);
+
+    /**
+     * @brief Private method to rebuild the tree, dropping removed slots
+     *
+     * @param minLeaves smallest number of leaves the tree must have
+     */
+    void rebuild(std::size_t minLeaves);
+
+    /**
+     * @brief Private method to find the first slot with a key of at least quantity
+     *
+     * @param quantity integer value containing the required free space
+     * @param column section type or ANY_TYPE
+     *
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> firstFit(int quantity, std::size_t column) const noexcept;
+
+    /**
+     * @brief Private method to find the slot with the smallest key of at least quantity
+     *
+     * @param quantity integer value containing the required free space
+     * @param column section type or ANY_TYPE
+     *
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> bestFit(int quantity, std::size_t column) const noexcept;
+
+public:
+    /**
+     * @brief Construct an empty index
+     */
+    LocationIndex();
+
+    /**
+     * @brief Add a location
+     *
+     * A location inserted several times stays indexed until it is removed as many times.
+     *
+     * @param location shared pointer to the location
+     * @param sectionType type of the section holding the location
+     */
+    void insert(std::shared_ptr<StorageLocation> location, WarehouseSection::SectionType sectionType);
+
+    /**
+     * @brief Remove a location
+     *
+     * @param location constant reference to the location
+     */
+    void erase(const StorageLocation& location);
+
+    /**
+     * @brief Re-read the key of a location after its load or status has changed
+     *
+     * @param location constant reference to the location
+     */
+    void update(const StorageLocation& location);
+
+    /**
+     * @brief Remove all locations
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief Get the number of indexed locations
+     *
+     * @return std::size_t containing number of locations
+     */
+    std::size_t size() const noexcept;
+
+    /**
+     * @brief Find the first inserted FREE location of a section type that can accommodate the books
+     *
+     * @param quantity integer value containing number of books
+     * @param sectionType type of the section
+     *
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> findFirstFit(int quantity, WarehouseSection::SectionType sectionType) const noexcept;
+
+    /**
+     * @brief Find the first inserted FREE location of any section type that can accommodate the books
+     *
+     * @param quantity integer value containing number of books
+     *
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> findFirstFit(int quantity) const noexcept;
+
+    /**
+     * @brief Find the FREE location of a section type with the least space that can accommodate the books
+     *
+     * @param quantity integer value containing number of books
+     * @param sectionType type of the section
+     *
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> findBestFit(int quantity, WarehouseSection::SectionType sectionType) const noexcept;
+
+    /**
+     * @brief Find the FREE location of any section type with the least space that can accommodate the books
+     *
+     * @param quantity integer value containing number of books
+     *
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> findBestFit(int quantity) const noexcept;
+
+    /**
+     * @brief Visit FREE locations that can accommodate the books, least free space first
+     *
+     * The first visited location is the one findBestFit() returns. Each step is O(log n).
+     *
+     * @tparam Visitor callable taking const std::shared_ptr<StorageLocation>& and the section
+     *         type number, returning true to stop
+     * @param quantity integer value containing number of books
+     * @param column section type as a number or ANY_TYPE
+     * @param visitor visitor called for locations in ascending order of free space
+     */
+    template <typename Visitor>
+    void forEachFit(int quantity, std::size_t column, Visitor&& visitor) const {
+        for (auto it = byFreeSpace[column].lower_bound({std::max(quantity, 0), 0}); it != byFreeSpace[column].end(); ++it) {
+            if (visitor(slots[it->second].location, slots[it->second].type)) return;
+        }
+    }
+
+    /**
+     * @brief Visit FREE locations with free space, most free space first
+     *
+     * @tparam Visitor callable taking const std::shared_ptr<StorageLocation>& and the section
+     *         type number, returning true to stop
+     * @param column section type as a number or ANY_TYPE
+     * @param visitor visitor called for locations in descending order of free space
+     */
+    template <typename Visitor>
+    void forEachLargest(std::size_t column, Visitor&& visitor) const {
+        for (auto it = byFreeSpace[column].rbegin(); it != byFreeSpace[column].rend() && it->first > 0; ++it) {
+            if (visitor(slots[it->second].location, slots[it->second].type)) return;
+        }
+    }
+};
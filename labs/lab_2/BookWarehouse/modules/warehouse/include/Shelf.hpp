@@ -14,6 +14,8 @@
 #include <memory>
 #include "StorageLocation.hpp"
 
+class WarehouseSnapshot;
+
 /**
  * @class Shelf
  * @brief Class for working with shelves in warehouse
@@ -21,12 +23,19 @@
  * Represents a shelf containing multiple storage locations.
  * Manages shelf capacity, organization, and provides operations
  * for finding available locations and managing shelf space.
+ * Changes of its locations are forwarded to the listeners of the shelf, capacity and
+ * load totals are kept up to date from them.
  */
-class Shelf {
+class Shelf : private CapacityListener {
+    friend class WarehouseSnapshot;   ///< Restores the state saved in a snapshot without revalidation
+
 private:
     std::string shelfId;                                     ///< Unique identifier for the shelf
     int maxLocations;                                        ///< Maximum number of storage locations on shelf
     std::vector<std::shared_ptr<StorageLocation>> locations; ///< Storage locations on this shelf
+    CapacityListeners listeners;                             ///< Sections holding this shelf
+    int totalCapacity = 0;                                   ///< Cached sum of location capacities
+    int currentLoad = 0;                                     ///< Cached sum of location loads, updated on every change
 
     /**
      * @brief Private method to validate shelf ID format
@@ -48,6 +57,10 @@ private:
      */
     bool isValidMaxLocations(int maxLocations) const;
 
+    void onLocationAttached(const std::shared_ptr<StorageLocation>& location) override;
+    void onLocationDetached(const StorageLocation& location) override;
+    void onLocationChanged(const StorageLocation& location, int loadDelta) override;
+
 public:
     /**
      * @brief Construct a new Shelf object
@@ -57,6 +70,43 @@ public:
      */
     Shelf(const std::string& shelfId, int maxLocations);
 
+    /**
+     * @brief Destroy the Shelf object and unregister it from its locations
+     */
+    ~Shelf() override;
+
+    /**
+     * @brief Construct a copy holding the same locations
+     * 
+     * The copy registers with the locations itself and has no listeners.
+     * 
+     * @param other constant reference to the shelf to copy
+     */
+    Shelf(const Shelf& other);
+
+    /**
+     * @brief Copy another shelf
+     * 
+     * @param other constant reference to the shelf to copy
+     * 
+     * @return Shelf& reference to this shelf
+     */
+    Shelf& operator=(const Shelf& other);
+
+    /**
+     * @brief Register a listener notified about added, removed and changed locations
+     * 
+     * @param listener pointer to the listener (normally the section holding this shelf)
+     */
+    void addListener(CapacityListener* listener);
+
+    /**
+     * @brief Unregister a listener
+     * 
+     * @param listener pointer to the listener
+     */
+    void removeListener(CapacityListener* listener) noexcept;
+
     /**
      * @brief Get the shelf identifier
      * 
@@ -81,9 +131,9 @@ public:
     /**
      * @brief Get all storage locations
      * 
-     * @return std::vector<std::shared_ptr<StorageLocation>> containing all locations on shelf
+     * @return const std::vector<std::shared_ptr<StorageLocation>>& containing all locations on shelf (valid until the shelf changes)
      */
-    std::vector<std::shared_ptr<StorageLocation>> getLocations() const noexcept;
+    const std::vector<std::shared_ptr<StorageLocation>>& getLocations() const noexcept;
 
     /**
      * @brief Add storage location to shelf
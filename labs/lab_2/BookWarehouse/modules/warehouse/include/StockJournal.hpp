@@ -0,0 +1,176 @@
+/**
+ * @file StockJournal.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the StockJournal class for durable recording of stock movements
+ * @version 0.1
+ * @date 2025-12-13
+ *
+ *
+ */
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "config/WarehouseConfig.hpp"
+
+class Warehouse;
+class StockMovement;
+
+/**
+ * @class StockJournal
+ * @brief Append-only journal of executed stock movements that follows a warehouse snapshot
+ *
+ * A warehouse with a journal (see Warehouse::setJournal) records every StockReceipt,
+ * StockWriteOff and StockTransfer it processes: the movement is captured before execution
+ * (affected items, their quantities and locations, books that are not in stock yet) and
+ * appended with its outcome after execution. Each record carries a checksum.
+ *
+ * Records are written to the file at once but flushed to disk by a background thread once
+ * per commit interval, so many movements share one fsync (group commit). sync() waits for the
+ * next commit. A crash loses at most the records of the last interval that nobody waited for.
+ *
+ * The journal belongs to one snapshot (WarehouseSnapshot): its header holds the snapshot
+ * checksum. recover() loads the snapshot and executes the journal records again, in order,
+ * through Warehouse::processStockMovement, which rebuilds the same state. checkpoint() saves
+ * a new snapshot and starts an empty journal; a journal left from an older snapshot is
+ * ignored, so a crash between the two steps does not apply records twice. A damaged or
+ * incomplete record at the end of the file (interrupted write) ends the journal.
+ *
+ * Books are matched by ISBN on replay and locations by ID; items must be placed into
+ * locations of the warehouse.
+ */
+class StockJournal {
+private:
+    std::string path;                           ///< Journal file
+    std::string snapshotPath;                   ///< Snapshot the journal follows
+    std::chrono::milliseconds commitInterval;   ///< Interval between group commits
+    int descriptor = -1;                        ///< Journal file opened for appending
+    std::uint64_t recordCount = 0;              ///< Records in the journal file
+    std::uint64_t appendedCount = 0;            ///< Records appended by this object
+    std::uint64_t durableCount = 0;             ///< Records appended by this object and flushed to disk
+    bool broken = false;                        ///< A write or flush failed, the journal accepts no records
+    bool stopping = false;                      ///< The flushing thread has to finish
+    std::mutex mutex;                           ///< Guards the state above
+    std::mutex flushMutex;                      ///< Held while the file is flushed or replaced, taken before mutex
+    std::condition_variable wakeFlusher;        ///< Wakes the flushing thread to stop
+    std::condition_variable committed;          ///< Notifies waiting threads about a finished commit
+    std::thread flusher;                        ///< Thread doing group commits
+
+    /**
+     * @brief Private method to replace the journal file by an empty journal of a snapshot
+     *
+     * Called with mutex held.
+     *
+     * @param snapshotChecksum checksum of the snapshot the journal follows
+     *
+     * @throws WarehouseException if the file cannot be written
+     */
+    void startJournal(std::uint64_t snapshotChecksum);
+
+    /**
+     * @brief Private method to flush appended records to disk
+     */
+    void flush();
+
+    /**
+     * @brief Private method run by the flushing thread
+     */
+    void flushLoop();
+
+public:
+    /**
+     * @brief Open the journal of a snapshot
+     *
+     * A journal that follows the snapshot is continued (after cutting off a damaged end),
+     * any other file at path is replaced by an empty journal. Call recover() first, the
+     * records of a continued journal are not applied by the constructor.
+     *
+     * @param path constant reference to the string containing journal file path
+     * @param snapshotPath constant reference to the string containing path of the snapshot
+     * @param commitIntervalMs integer value containing interval between group commits in milliseconds
+     *
+     * @throws DataValidationException if the interval is out of range
+     * @throws WarehouseException if the snapshot or the journal cannot be read or written
+     */
+    StockJournal(const std::string& path, const std::string& snapshotPath,
+                 int commitIntervalMs = WarehouseConfig::StockJournal::COMMIT_INTERVAL_MS);
+
+    /**
+     * @brief Flush remaining records, stop the flushing thread and close the journal
+     */
+    ~StockJournal();
+
+    StockJournal(const StockJournal&) = delete;
+    StockJournal& operator=(const StockJournal&) = delete;
+
+    /**
+     * @brief Capture a pending movement before its execution
+     *
+     * @param warehouse constant reference to the warehouse processing the movement
+     * @param movement constant reference to the movement
+     *
+     * @return std::string containing the record to pass to append() after execution
+     *
+     * @throws WarehouseException if the movement is not a receipt, write-off or transfer
+     */
+    static std::string capture(const Warehouse& warehouse, const StockMovement& movement);
+
+    /**
+     * @brief Append a captured movement with the outcome of its execution
+     *
+     * Returns once the record is written to the file, it reaches the disk with the next
+     * group commit.
+     *
+     * @param record constant reference to the string returned by capture()
+     * @param succeeded true if the movement was executed, false if execution failed
+     *
+     * @throws WarehouseException if the record cannot be written; the journal then accepts
+     *         no records and sync() fails until the next checkpoint()
+     */
+    void append(const std::string& record, bool succeeded);
+
+    /**
+     * @brief Wait until all records appended so far are on disk
+     *
+     * @throws WarehouseException if flushing failed or a record could not be appended since
+     *         the last checkpoint(); checkpoint() saves the current state and repairs the journal
+     */
+    void sync();
+
+    /**
+     * @brief Save a snapshot of the warehouse and start an empty journal
+     *
+     * @param warehouse constant reference to the warehouse, the one this journal is set to
+     *
+     * Also the way to continue after a write error: the snapshot includes the movements
+     * whose records were lost.
+     *
+     * @throws WarehouseException if the snapshot or the journal cannot be written
+     */
+    void checkpoint(const Warehouse& warehouse);
+
+    /**
+     * @brief Get the number of records in the journal file
+     *
+     * @return std::uint64_t containing number of records since the last checkpoint
+     */
+    std::uint64_t getRecordCount() noexcept;
+
+    /**
+     * @brief Restore a warehouse from a snapshot and its journal
+     *
+     * @param snapshotPath constant reference to the string containing snapshot path
+     * @param journalPath constant reference to the string containing journal path, the file may be missing
+     *
+     * @return std::shared_ptr<Warehouse> containing restored warehouse without a journal
+     *
+     * @throws WarehouseException if the snapshot cannot be loaded or a record cannot be replayed
+     */
+    static std::shared_ptr<Warehouse> recover(const std::string& snapshotPath, const std::string& journalPath);
+};
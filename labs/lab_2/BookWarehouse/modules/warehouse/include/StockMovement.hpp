@@ -12,6 +12,7 @@
 #include <string>
 #include <memory>
 #include <vector>
+#include <unordered_set>
 
 // Forward declaration to avoid circular dependency
 class Warehouse;
@@ -53,6 +54,7 @@ private:
     std::string movementDate;                       ///< Date when movement occurred
     std::string employeeId;                         ///< ID of employee who performed movement
     std::vector<std::shared_ptr<class InventoryItem>> affectedItems; ///< Inventory items affected by movement
+    std::unordered_set<const InventoryItem*> affectedItemSet;        ///< Same items for O(1) duplicate checks
     std::string notes;                              ///< Additional notes or comments
     std::weak_ptr<Warehouse> warehouse;             ///< Weak pointer to warehouse
 
@@ -144,9 +146,9 @@ public:
     /**
      * @brief Get the affected inventory items
      * 
-     * @return std::vector<std::shared_ptr<InventoryItem>> containing affected items
+     * @return const std::vector<std::shared_ptr<InventoryItem>>& containing affected items (valid until the movement changes)
      */
-    std::vector<std::shared_ptr<class InventoryItem>> getAffectedItems() const noexcept;
+    const std::vector<std::shared_ptr<class InventoryItem>>& getAffectedItems() const noexcept;
 
     /**
      * @brief Get the notes
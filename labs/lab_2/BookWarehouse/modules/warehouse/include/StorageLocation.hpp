@@ -10,6 +10,7 @@
 
 #pragma once
 #include <string>
+#include "CapacityListener.hpp"
 
 /**
  * @class StorageLocation
@@ -35,6 +36,7 @@ private:
     int capacity;            ///< Maximum number of books that can be stored
     int currentLoad;         ///< Current number of books stored
     LocationStatus status;   ///< Current status of the location
+    CapacityListeners listeners; ///< Shelves holding this location
 
     /**
      * @brief Private method to validate location ID format
@@ -145,6 +147,20 @@ public:
      */
     void setStatus(LocationStatus newStatus) noexcept;
 
+    /**
+     * @brief Register a listener notified after every change of load or status
+     * 
+     * @param listener pointer to the listener (normally the shelf holding this location)
+     */
+    void addListener(CapacityListener* listener);
+
+    /**
+     * @brief Unregister a listener
+     * 
+     * @param listener pointer to the listener
+     */
+    void removeListener(CapacityListener* listener) noexcept;
+
     /**
      * @brief Check if location is empty
      * 
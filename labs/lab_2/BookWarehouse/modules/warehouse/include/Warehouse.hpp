@@ -12,25 +12,56 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 #include "WarehouseSection.hpp"
+#include "LocationIndex.hpp"
 #include "InventoryItem.hpp"
 #include "StorageLocation.hpp"
 #include "StockMovement.hpp"
 #include "Book.hpp"
 
+class WarehouseSnapshot;
+class StockJournal;
+
 /**
  * @class Warehouse
  * @brief Class for managing the entire warehouse system
  * 
  * Represents the complete warehouse with all sections, shelves, and storage locations.
  * Provides comprehensive inventory management, search operations, and warehouse analytics.
+ * Inventory is indexed by book ISBN (packed, see ISBN) and by (ISBN, location ID) with
+ * a cached total quantity per ISBN; string ISBNs of the API are packed once per call, so lookups and stock operations do not scan the whole inventory.
+ * Storage locations are kept in a free space index updated by the sections on every
+ * change of a location, so placement queries do not scan the sections either. Capacity
+ * and load totals are updated from the same notifications and read in O(1).
  */
 class Warehouse {
+    friend class WarehouseSnapshot;   ///< Restores the state saved in a snapshot without revalidation
+
 private:
+    /**
+     * @brief Inventory of one book: its items, their locations and the total quantity
+     * 
+     */
+    struct BookStock {
+        int totalQuantity = 0;                                                          ///< Cached sum of item quantities
+        std::vector<std::shared_ptr<InventoryItem>> items;                              ///< Items in insertion order
+        std::unordered_map<std::string, std::shared_ptr<InventoryItem>> itemsByLocation; ///< Location ID -> item
+    };
+
     std::string name;                                           ///< Name of the warehouse
     std::string address;                                        ///< Physical address of the warehouse
     std::vector<std::shared_ptr<WarehouseSection>> sections;    ///< All sections in the warehouse
     std::vector<std::shared_ptr<InventoryItem>> inventory;      ///< All inventory items in the warehouse
+    std::unordered_map<ISBN, BookStock> stockByIsbn;           ///< ISBN -> inventory of the book
+    std::unordered_map<const InventoryItem*, std::size_t> inventoryPositions; ///< Item -> index in inventory
+
+    class SectionWatcher;                                       ///< Listener of one section, knows its type
+    std::vector<std::unique_ptr<SectionWatcher>> sectionWatchers; ///< Listeners registered with sections, parallel to sections
+    LocationIndex locationIndex;                                ///< Free space index of all locations
+    int totalCapacity = 0;                                      ///< Cached sum of section capacities
+    int currentLoad = 0;                                        ///< Cached sum of section loads, updated on every change
+    std::shared_ptr<StockJournal> journal;                      ///< Journal of processed stock movements, not copied
 
     /**
      * @brief Private method to validate warehouse name
@@ -52,6 +83,57 @@ private:
      */
     bool isValidAddress(const std::string& address) const;
 
+    /**
+     * @brief Private method to remove inventory item from inventory and all indexes
+     * 
+     * @param item shared pointer to the indexed InventoryItem object
+     */
+    void eraseInventoryItem(const std::shared_ptr<InventoryItem>& item);
+
+    /**
+     * @brief Private method to rebuild index and cached total of a book from its items
+     * 
+     * Used after stock movements that change quantities or locations of indexed items
+     * directly. Items with zero quantity are removed from the warehouse. An item moved onto
+     * a location that already holds the book is merged into the item found there first.
+     * 
+     * @param bookIsbn constant reference to the book ISBN
+     */
+    void refreshBookStock(const ISBN& bookIsbn);
+
+    /**
+     * @brief Private method to find the inventory of a book
+     * 
+     * @param bookIsbn constant reference to the book ISBN
+     * 
+     * @return const BookStock* containing inventory of the book or nullptr
+     */
+    const BookStock* findStock(const ISBN& bookIsbn) const noexcept;
+
+    /**
+     * @brief Private method to find the inventory of a book by ISBN string
+     * 
+     * @param bookIsbn constant reference to the string containing book ISBN in any accepted format
+     * 
+     * @return const BookStock* containing inventory of the book or nullptr (also for an invalid ISBN)
+     */
+    const BookStock* findStock(const std::string& bookIsbn) const noexcept;
+
+    /**
+     * @brief Private method to append a section, register with it and index its locations
+     * 
+     * If indexing or registration throws, the indexed locations are removed again and
+     * sections stays as it was, so sections and sectionWatchers remain parallel.
+     * 
+     * @param section constant reference to the shared pointer of the section
+     */
+    void attachSection(const std::shared_ptr<WarehouseSection>& section);
+
+    /**
+     * @brief Private method to unregister from all sections, clear the location index and the totals
+     */
+    void detachSections() noexcept;
+
 public:
     /**
      * @brief Construct a new Warehouse object
@@ -61,20 +143,67 @@ public:
      */
     Warehouse(const std::string& name, const std::string& address);
 
+    /**
+     * @brief Destroy the Warehouse object and unregister it from its sections
+     */
+    ~Warehouse();
+
+    /**
+     * @brief Construct a copy holding the same sections and inventory items
+     * 
+     * The copy registers with the sections itself and builds its own location index.
+     * 
+     * @param other constant reference to the warehouse to copy
+     */
+    Warehouse(const Warehouse& other);
+
+    /**
+     * @brief Copy another warehouse
+     * 
+     * @param other constant reference to the warehouse to copy
+     * 
+     * @return Warehouse& reference to this warehouse
+     */
+    Warehouse& operator=(const Warehouse& other);
+
     /**
      * @brief Clean up inventory items with zero quantity
      * 
      * Removes all inventory items that have zero quantity from the warehouse inventory
+     * and recomputes cached book totals from the quantities of the remaining items
      */
     void cleanupZeroQuantityItems();
 
     /**
      * @brief Process stock movement operation
      * 
+     * With a journal set, a pending movement is recorded in it together with the outcome.
+     * A journal write error does not change what the caller sees: an executed movement
+     * returns normally and a failed one throws its own error. The journal stays broken
+     * and StockJournal::sync() reports the lost record until StockJournal::checkpoint().
+     * 
      * @param movement shared pointer to StockMovement object to process
+     * 
+     * @throws WarehouseException if the movement fails or the journal cannot capture it before execution
      */
     void processStockMovement(std::shared_ptr<StockMovement> movement);
 
+    /**
+     * @brief Set the journal recording processed stock movements
+     * 
+     * Other changes of the warehouse are not journaled, save them with StockJournal::checkpoint().
+     * 
+     * @param journal shared pointer to the StockJournal object, nullptr to stop recording
+     */
+    void setJournal(std::shared_ptr<StockJournal> journal) noexcept;
+
+    /**
+     * @brief Get the journal recording processed stock movements
+     * 
+     * @return std::shared_ptr<StockJournal> containing the journal or nullptr
+     */
+    std::shared_ptr<StockJournal> getJournal() const noexcept;
+
     /**
      * @brief Get the warehouse name
      * 
@@ -92,9 +221,9 @@ public:
     /**
      * @brief Get all sections in warehouse
      * 
-     * @return std::vector<std::shared_ptr<WarehouseSection>> containing all sections
+     * @return const std::vector<std::shared_ptr<WarehouseSection>>& containing all sections (valid until the warehouse changes)
      */
-    std::vector<std::shared_ptr<WarehouseSection>> getSections() const noexcept;
+    const std::vector<std::shared_ptr<WarehouseSection>>& getSections() const noexcept;
 
     /**
      * @brief Get the number of sections in warehouse
@@ -136,6 +265,34 @@ public:
      */
     bool containsSection(const std::string& sectionId) const noexcept;
 
+    /**
+     * @brief Visit every storage location of the warehouse
+     * 
+     * Nothing is copied: the visitor gets references to the stored pointers.
+     * 
+     * @tparam Visitor callable taking const std::shared_ptr<StorageLocation>&
+     * @param visitor visitor called once per location
+     */
+    template <typename Visitor>
+    void forEachLocation(Visitor&& visitor) const {
+        for (const auto& section : sections) {
+            section->forEachLocation(visitor);
+        }
+    }
+
+    /**
+     * @brief Visit every inventory item of the warehouse
+     * 
+     * @tparam Visitor callable taking const std::shared_ptr<InventoryItem>&
+     * @param visitor visitor called once per item, in no particular order
+     */
+    template <typename Visitor>
+    void forEachInventoryItem(Visitor&& visitor) const {
+        for (const auto& item : inventory) {
+            visitor(item);
+        }
+    }
+
     /**
      * @brief Add inventory item to warehouse
      * 
@@ -179,9 +336,23 @@ public:
      */
     std::shared_ptr<InventoryItem> findInventoryItem(const std::string& bookIsbn, const std::string& locationId) const noexcept;
 
+    /**
+     * @brief Find specific inventory item by book ISBN object and location
+     * 
+     * @param bookIsbn constant reference to the book ISBN
+     * @param locationId constant reference to the string containing location ID
+     * 
+     * @return std::shared_ptr<InventoryItem> containing found inventory item or nullptr
+     */
+    std::shared_ptr<InventoryItem> findInventoryItem(const ISBN& bookIsbn, const std::string& locationId) const noexcept;
+
     /**
      * @brief Get total quantity of a book in warehouse
      * 
+     * Returns the cached total maintained by addInventoryItem, removeInventoryItem and
+     * processStockMovement. Quantities changed directly on InventoryItem objects are
+     * reflected after cleanupZeroQuantityItems.
+     * 
      * @param bookIsbn constant reference to the string containing book ISBN
      * 
      * @return int containing total quantity of the book
@@ -208,6 +379,10 @@ public:
     /**
      * @brief Find optimal location for new inventory
      * 
+     * First fit: the first free location (in the order locations were added to the warehouse)
+     * of the preferred section type that can accommodate the quantity, otherwise the first
+     * such location of any type. O(log n).
+     * 
      * @param quantity integer value containing quantity to store
      * @param preferredSectionType WarehouseSection::SectionType value containing preferred section type
      * 
@@ -215,6 +390,26 @@ public:
      */
     std::shared_ptr<StorageLocation> findOptimalLocation(int quantity, WarehouseSection::SectionType preferredSectionType = WarehouseSection::SectionType::GENERAL) const noexcept;
 
+    /**
+     * @brief Find the free location with the least space that can accommodate the quantity
+     * 
+     * Best fit: searches the preferred section type first, then all types. Keeps large
+     * locations for large quantities. O(log n).
+     * 
+     * @param quantity integer value containing quantity to store
+     * @param preferredSectionType WarehouseSection::SectionType value containing preferred section type
+     * 
+     * @return std::shared_ptr<StorageLocation> containing found location or nullptr
+     */
+    std::shared_ptr<StorageLocation> findBestFitLocation(int quantity, WarehouseSection::SectionType preferredSectionType = WarehouseSection::SectionType::GENERAL) const noexcept;
+
+    /**
+     * @brief Get the free space index of all locations of the warehouse
+     * 
+     * @return const LocationIndex& reference to the index, kept up to date with every change
+     */
+    const LocationIndex& getLocationIndex() const noexcept;
+
     /**
      * @brief Get total warehouse capacity
      * 
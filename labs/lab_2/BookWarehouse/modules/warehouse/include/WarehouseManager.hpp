@@ -28,6 +28,17 @@
  * coordinating between different components and simplifying complex workflows.
  */
 class WarehouseManager {
+public:
+    /**
+     * @brief One line of a putaway plan: quantity of a book received into a location
+     * 
+     */
+    struct PutawayPlacement {
+        std::shared_ptr<Book> book;                  ///< Received book
+        std::shared_ptr<StorageLocation> location;   ///< Planned location
+        int quantity;                                ///< Quantity received into the location
+    };
+
 private:
     std::shared_ptr<Warehouse> warehouse;  ///< Managed warehouse instance
 
@@ -70,9 +81,34 @@ public:
     void setWarehouse(std::shared_ptr<Warehouse> warehouse);
 
     // Stock Receipt Operations
+    /**
+     * @brief Plan where all lines of a receipt are stored
+     * 
+     * Lines of the same book are merged and kept together. Lines are placed largest first,
+     * each into the free location with the least room that takes it whole (best fit
+     * decreasing), preferring the given section type. A line that fits nowhere whole is
+     * split across the largest locations. Candidates come from the location index and room
+     * booked by the plan is tracked in an overlay, so no location is planned beyond its
+     * capacity. O(placements * log locations) plus skips of locations already booked.
+     * 
+     * @param items vector of pairs containing book and quantity
+     * @param preferredSectionType WarehouseSection::SectionType value containing preferred section type
+     * 
+     * @return std::vector<PutawayPlacement> containing planned placements
+     * @throws DataValidationException if a book is null or a quantity is not positive
+     * @throws WarehouseException if the free locations cannot hold all lines
+     */
+    std::vector<PutawayPlacement> planPutaway(
+        const std::vector<std::pair<std::shared_ptr<Book>, int>>& items,
+        WarehouseSection::SectionType preferredSectionType = WarehouseSection::SectionType::GENERAL
+    ) const;
+
     /**
      * @brief Process stock receipt from supplier
      * 
+     * All lines are placed with planPutaway() before the receipt is executed, so a receipt
+     * either fits as a whole or is rejected without changing the warehouse.
+     * 
      * @param supplierName constant reference to the string containing supplier name
      * @param purchaseOrderNumber constant reference to the string containing purchase order number
      * @param invoiceNumber constant reference to the string containing invoice number
@@ -14,6 +14,8 @@
 #include <memory>
 #include "Shelf.hpp"
 
+class WarehouseSnapshot;
+
 /**
  * @class WarehouseSection
  * @brief Class for working with warehouse sections
@@ -21,8 +23,12 @@
  * Represents a section of the warehouse containing multiple shelves.
  * Manages section organization, provides operations for finding available
  * storage space and managing section-wide inventory metrics.
+ * Changes of the locations on its shelves are forwarded to the listeners of the section,
+ * capacity and load totals are kept up to date from them.
  */
-class WarehouseSection {
+class WarehouseSection : private CapacityListener {
+    friend class WarehouseSnapshot;   ///< Restores the state saved in a snapshot without revalidation
+
 public:
     /**
      * @enum SectionType
@@ -42,6 +48,9 @@ private:
     std::string description;                        ///< Description of the section
     SectionType sectionType;                        ///< Type of the section
     std::vector<std::shared_ptr<Shelf>> shelves;    ///< Shelves in this section
+    CapacityListeners listeners;                    ///< Warehouses holding this section
+    int totalCapacity = 0;                          ///< Cached sum of shelf capacities
+    int currentLoad = 0;                            ///< Cached sum of shelf loads, updated on every change
     double temperature;                             ///< Current temperature in section (optional)
     double humidity;                                ///< Current humidity in section (optional)
 
@@ -85,6 +94,10 @@ private:
      */
     bool isValidHumidity(double humidity) const;
 
+    void onLocationAttached(const std::shared_ptr<StorageLocation>& location) override;
+    void onLocationDetached(const StorageLocation& location) override;
+    void onLocationChanged(const StorageLocation& location, int loadDelta) override;
+
 public:
     /**
      * @brief Construct a new WarehouseSection object
@@ -100,6 +113,43 @@ public:
                      const std::string& description = "", SectionType sectionType = SectionType::GENERAL,
                      double temperature = 20.0, double humidity = 50.0);
 
+    /**
+     * @brief Destroy the WarehouseSection object and unregister it from its shelves
+     */
+    ~WarehouseSection() override;
+
+    /**
+     * @brief Construct a copy holding the same shelves
+     * 
+     * The copy registers with the shelves itself and has no listeners.
+     * 
+     * @param other constant reference to the section to copy
+     */
+    WarehouseSection(const WarehouseSection& other);
+
+    /**
+     * @brief Copy another section
+     * 
+     * @param other constant reference to the section to copy
+     * 
+     * @return WarehouseSection& reference to this section
+     */
+    WarehouseSection& operator=(const WarehouseSection& other);
+
+    /**
+     * @brief Register a listener notified about added, removed and changed locations
+     * 
+     * @param listener pointer to the listener (normally the warehouse holding this section)
+     */
+    void addListener(CapacityListener* listener);
+
+    /**
+     * @brief Unregister a listener
+     * 
+     * @param listener pointer to the listener
+     */
+    void removeListener(CapacityListener* listener) noexcept;
+
     /**
      * @brief Get the section identifier
      * 
@@ -145,9 +195,9 @@ public:
     /**
      * @brief Get all shelves in section
      * 
-     * @return std::vector<std::shared_ptr<Shelf>> containing all shelves
+     * @return const std::vector<std::shared_ptr<Shelf>>& containing all shelves (valid until the section changes)
      */
-    std::vector<std::shared_ptr<Shelf>> getShelves() const noexcept;
+    const std::vector<std::shared_ptr<Shelf>>& getShelves() const noexcept;
 
     /**
      * @brief Get the number of shelves in section
@@ -189,6 +239,23 @@ public:
      */
     bool containsShelf(const std::string& shelfId) const noexcept;
 
+    /**
+     * @brief Visit every storage location on the shelves of the section
+     * 
+     * Nothing is copied: the visitor gets references to the stored pointers.
+     * 
+     * @tparam Visitor callable taking const std::shared_ptr<StorageLocation>&
+     * @param visitor visitor called once per location
+     */
+    template <typename Visitor>
+    void forEachLocation(Visitor&& visitor) const {
+        for (const auto& shelf : shelves) {
+            for (const auto& location : shelf->getLocations()) {
+                visitor(location);
+            }
+        }
+    }
+
     /**
      * @brief Find available storage locations in entire section
      * 
@@ -0,0 +1,104 @@
+/**
+ * @file WarehouseSnapshot.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the WarehouseSnapshot class for saving and restoring warehouse state
+ * @version 0.1
+ * @date 2025-12-12
+ *
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Warehouse.hpp"
+
+/**
+ * @class WarehouseSnapshot
+ * @brief Class for saving the whole warehouse into a binary file and loading it back
+ *
+ * A snapshot stores the warehouse with its sections, shelves, storage locations, inventory
+ * items and their books (with publishers, series and reviews). Every object is written once
+ * and referenced by index, so objects shared through std::shared_ptr (a book held by
+ * several inventory items, a location on two shelves) are shared again after loading.
+ *
+ * The file is a versioned header followed by tables of fixed-size records and one block
+ * of string data; the payload is protected by a checksum. It is memory-mapped on load and
+ * records are read in place. Loading is a trusted path: the file was written from a
+ * valid warehouse, so only the checks of value objects (IDs, dates, ranges) are done,
+ * while duplicate, capacity and placement checks of the containers, change notifications
+ * and repeated loading of locations by inventory items are skipped.
+ */
+class WarehouseSnapshot {
+private:
+    class Writer;   ///< Collects the object graph into tables, deduplicating shared objects
+    class Reader;   ///< Rebuilds the object graph from the tables of a mapped file
+
+public:
+    static constexpr std::uint32_t VERSION = 1;   ///< Version of the file format written by save()
+
+    /**
+     * @brief Save a warehouse
+     *
+     * The snapshot is written with AtomicFile, so an existing snapshot is replaced only
+     * by a complete one.
+     *
+     * @param warehouse constant reference to the warehouse to save
+     * @param path constant reference to the string containing file path
+     *
+     * @return std::uint64_t containing checksum of the snapshot, identifies the saved state
+     *
+     * @throws WarehouseException if the file cannot be written
+     */
+    static std::uint64_t save(const Warehouse& warehouse, const std::string& path);
+
+    /**
+     * @brief Load a warehouse
+     *
+     * @param path constant reference to the string containing file path
+     *
+     * @return std::shared_ptr<Warehouse> containing restored warehouse
+     *
+     * @throws WarehouseException if the file cannot be read, has another version or is damaged
+     */
+    static std::shared_ptr<Warehouse> load(const std::string& path);
+
+    /**
+     * @brief Get the checksum of a snapshot, as returned by save()
+     *
+     * @param path constant reference to the string containing file path
+     *
+     * @return std::uint64_t containing checksum of the snapshot
+     *
+     * @throws WarehouseException if the file cannot be read, has another version or is damaged
+     */
+    static std::uint64_t getChecksum(const std::string& path);
+
+    /**
+     * @brief Save books alone in the snapshot format
+     *
+     * @param books constant reference to the vector of books
+     *
+     * @return std::string containing the snapshot bytes
+     *
+     * @throws DataValidationException if a book is null
+     */
+    static std::string saveBooks(const std::vector<std::shared_ptr<Book>>& books);
+
+    /**
+     * @brief Load books saved by saveBooks()
+     *
+     * Books that shared publisher, series or review objects when saved share them again.
+     *
+     * @param image snapshot bytes, aligned to 8 bytes in memory
+     * @param source constant reference to the string naming the data in error messages
+     *
+     * @return std::vector<std::shared_ptr<Book>> containing books in the saved order
+     *
+     * @throws WarehouseException if the data have another version or are damaged
+     */
+    static std::vector<std::shared_ptr<Book>> loadBooks(std::string_view image, const std::string& source);
+};
@@ -2,12 +2,12 @@
 #include "exceptions/WarehouseExceptions.hpp"
 #include "config/WarehouseConfig.hpp"
 #include "utils/Utils.hpp"
-#include <regex>
+#include "utils/IdValidation.hpp"
+#include <algorithm>
 
 bool Delivery::isValidDeliveryId(const std::string& deliveryId) const {
     // "DEL-2025-001"
-    std::regex pattern("^DEL-\\d{4}-\\d{3}$");
-    return std::regex_match(deliveryId, pattern);
+    return IdValidation::isValidDeliveryId(deliveryId);
 }
 
 bool Delivery::isValidTrackingNumber(const std::string& trackingNumber) const {
@@ -82,7 +82,7 @@ double Delivery::getShippingCost() const noexcept {
     return shippingCost;
 }
 
-std::vector<std::shared_ptr<Book>> Delivery::getBooks() const noexcept {
+const std::vector<std::shared_ptr<Book>>& Delivery::getBooks() const noexcept {
     return books;
 }
 
@@ -71,8 +71,7 @@ std::string InventoryReport::generateCapacityReport() const {
 std::string InventoryReport::generateSectionUtilizationReport() const {
     validateWarehouse();
     std::string report = "=== SECTION UTILIZATION REPORT ===\n";
-    auto sections = warehouse->getSections();
-    for (const auto& section : sections) {
+    for (const auto& section : warehouse->getSections()) {
         if (section) {
             report += section->getInfo() + "\n";
         }
@@ -113,10 +112,10 @@ std::string InventoryReport::generateStatisticsReport() const {
 InventoryReport::BookCounts InventoryReport::calculateBookCounts(
     const std::vector<std::shared_ptr<InventoryItem>>& inventory) const {
     BookCounts counts = {0, 0};
-    std::string lastIsbn = "";
+    std::uint64_t lastIsbn = ISBN::INVALID_CODE;
     for (const auto& item : inventory) {
         if (isValidInventoryItem(item)) {
-            std::string currentIsbn = item->getBook()->getISBN().getCode();
+            std::uint64_t currentIsbn = item->getBook()->getISBN().getPackedCode();
             counts = updateBookCounts(counts, currentIsbn, lastIsbn, item->getQuantity());
             lastIsbn = currentIsbn;
         }
@@ -129,8 +128,8 @@ bool InventoryReport::isValidInventoryItem(std::shared_ptr<InventoryItem> item)
 }
 
 InventoryReport::BookCounts InventoryReport::updateBookCounts(
-    BookCounts counts, const std::string& currentIsbn, 
-    const std::string& lastIsbn, int quantity) const {
+    BookCounts counts, std::uint64_t currentIsbn, 
+    std::uint64_t lastIsbn, int quantity) const {
     if (currentIsbn != lastIsbn) {
         counts.uniqueBooks++;
     }
@@ -204,42 +203,19 @@ std::string InventoryReport::buildEmptyLocationsList(
     return list;
 }
 
-std::string InventoryReport::buildEmptyLocationLine(std::shared_ptr<StorageLocation> location) const {
+std::string InventoryReport::buildEmptyLocationLine(const std::shared_ptr<StorageLocation>& location) const {
     return "  - " + location->getLocationId() + 
            " (Capacity: " + std::to_string(location->getCapacity()) + ")\n";
 }
 
 std::vector<std::shared_ptr<StorageLocation>> InventoryReport::findFullLocations() const {
     std::vector<std::shared_ptr<StorageLocation>> fullLocations;
-    auto sections = warehouse->getSections();
-    for (const auto& section : sections) {
-        if (section) {
-            collectFullLocationsFromSection(section, fullLocations);
-        }
-    }
-    return fullLocations;
-}
-
-void InventoryReport::collectFullLocationsFromSection(
-    std::shared_ptr<WarehouseSection> section,
-    std::vector<std::shared_ptr<StorageLocation>>& fullLocations) const { 
-    auto shelves = section->getShelves();
-    for (const auto& shelf : shelves) {
-        if (shelf) {
-            collectFullLocationsFromShelf(shelf, fullLocations);
-        }
-    }
-}
-
-void InventoryReport::collectFullLocationsFromShelf(
-    std::shared_ptr<Shelf> shelf,
-    std::vector<std::shared_ptr<StorageLocation>>& fullLocations) const {
-    auto locations = shelf->getLocations();
-    for (const auto& location : locations) {
+    warehouse->forEachLocation([&fullLocations](const std::shared_ptr<StorageLocation>& location) {
         if (location && location->isFull()) {
             fullLocations.push_back(location);
         }
-    }
+    });
+    return fullLocations;
 }
 
 std::string InventoryReport::buildFullLocationsList(
@@ -251,7 +227,7 @@ std::string InventoryReport::buildFullLocationsList(
     return list;
 }
 
-std::string InventoryReport::buildFullLocationLine(std::shared_ptr<StorageLocation> location) const {
+std::string InventoryReport::buildFullLocationLine(const std::shared_ptr<StorageLocation>& location) const {
     return "  - " + location->getLocationId() + 
            " (Load: " + std::to_string(location->getCurrentLoad()) + 
            "/" + std::to_string(location->getCapacity()) + ")\n";
@@ -0,0 +1,169 @@
+#include "LocationIndex.hpp"
+#include <algorithm>
+
+namespace {
+std::array<int, LocationIndex::SECTION_TYPES + 1> noKeys() {
+    std::array<int, LocationIndex::SECTION_TYPES + 1> keys;
+    keys.fill(-1);
+    return keys;
+}
+}
+
+LocationIndex::LocationIndex() : tree(2, noKeys()) {}
+
+int LocationIndex::freeSpaceOf(const StorageLocation& location) noexcept {
+    // Same rule as the old scan over Shelf::getAvailableLocations()
+    return location.getStatus() == StorageLocation::LocationStatus::FREE ? location.getAvailableSpace() : -1;
+}
+
+void LocationIndex::setKey(std::size_t slot, int freeSpace) {
+    Slot& entry = slots[slot];
+    if (entry.freeSpace >= 0) {
+        byFreeSpace[entry.type].erase({entry.freeSpace, slot});
+        byFreeSpace[ANY_TYPE].erase({entry.freeSpace, slot});
+    }
+    entry.freeSpace = freeSpace;
+    if (freeSpace >= 0) {
+        byFreeSpace[entry.type].insert({freeSpace, slot});
+        byFreeSpace[ANY_TYPE].insert({freeSpace, slot});
+    }
+    std::size_t node = leaves + slot;
+    tree[node] = noKeys();
+    tree[node][entry.type] = freeSpace;
+    tree[node][ANY_TYPE] = freeSpace;
+    for (node /= 2; node > 0; node /= 2) {
+        for (std::size_t column = 0; column <= ANY_TYPE; ++column) {
+            tree[node][column] = std::max(tree[2 * node][column], tree[2 * node + 1][column]);
+        }
+    }
+}
+
+void LocationIndex::rebuild(std::size_t minLeaves) {
+    std::vector<Slot> live;
+    live.reserve(slots.size() - removedSlots);
+    for (auto& slot : slots) {
+        if (slot.location) {
+            live.push_back(std::move(slot));
+        }
+    }
+    slots = std::move(live);
+    removedSlots = 0;
+    leaves = 1;
+    while (leaves < std::max(minLeaves, slots.size())) {
+        leaves *= 2;
+    }
+    tree.assign(2 * leaves, noKeys());
+    slotOf.clear();
+    for (auto& set : byFreeSpace) {
+        set.clear();
+    }
+    for (std::size_t slot = 0; slot < slots.size(); ++slot) {
+        const Slot& entry = slots[slot];
+        slotOf[entry.location.get()] = slot;
+        tree[leaves + slot][entry.type] = entry.freeSpace;
+        tree[leaves + slot][ANY_TYPE] = entry.freeSpace;
+        if (entry.freeSpace >= 0) {
+            byFreeSpace[entry.type].insert({entry.freeSpace, slot});
+            byFreeSpace[ANY_TYPE].insert({entry.freeSpace, slot});
+        }
+    }
+    for (std::size_t node = leaves - 1; node > 0; --node) {
+        for (std::size_t column = 0; column <= ANY_TYPE; ++column) {
+            tree[node][column] = std::max(tree[2 * node][column], tree[2 * node + 1][column]);
+        }
+    }
+}
+
+void LocationIndex::insert(std::shared_ptr<StorageLocation> location, WarehouseSection::SectionType sectionType) {
+    if (!location) {
+        return;
+    }
+    auto found = slotOf.find(location.get());
+    if (found != slotOf.end()) {
+        slots[found->second].references++;
+        return;
+    }
+    if (slots.size() == leaves) { // no free leaf: drop removed slots and double
+        rebuild(2 * (slots.size() - removedSlots + 1));
+    }
+    std::size_t slot = slots.size();
+    int freeSpace = freeSpaceOf(*location);
+    slotOf[location.get()] = slot;
+    slots.push_back({std::move(location), static_cast<std::size_t>(sectionType), -1, 1});
+    setKey(slot, freeSpace);
+}
+
+void LocationIndex::erase(const StorageLocation& location) {
+    auto found = slotOf.find(&location);
+    if (found == slotOf.end()) {
+        return;
+    }
+    std::size_t slot = found->second;
+    if (--slots[slot].references > 0) {
+        return;
+    }
+    slotOf.erase(found);
+    setKey(slot, -1);
+    slots[slot].location.reset();
+    removedSlots++;
+    if (removedSlots > slots.size() / 2) {
+        rebuild(1);
+    }
+}
+
+void LocationIndex::update(const StorageLocation& location) {
+    auto found = slotOf.find(&location);
+    if (found != slotOf.end()) {
+        setKey(found->second, freeSpaceOf(location));
+    }
+}
+
+void LocationIndex::clear() noexcept {
+    slots.clear();
+    slotOf.clear();
+    removedSlots = 0;
+    leaves = 1;
+    tree.assign(2, noKeys());
+    for (auto& set : byFreeSpace) {
+        set.clear();
+    }
+}
+
+std::size_t LocationIndex::size() const noexcept {
+    return slotOf.size();
+}
+
+std::shared_ptr<StorageLocation> LocationIndex::firstFit(int quantity, std::size_t column) const noexcept {
+    if (quantity < 0 || tree[1][column] < quantity) {
+        return nullptr;
+    }
+    std::size_t node = 1;
+    while (node < leaves) { // leftmost subtree that still has enough space
+        node = tree[2 * node][column] >= quantity ? 2 * node : 2 * node + 1;
+    }
+    return slots[node - leaves].location;
+}
+
+std::shared_ptr<StorageLocation> LocationIndex::bestFit(int quantity, std::size_t column) const noexcept {
+    if (quantity < 0) {
+        return nullptr;
+    }
+    auto it = byFreeSpace[column].lower_bound({quantity, 0});
+    return it != byFreeSpace[column].end() ? slots[it->second].location : nullptr;
+}
+
+std::shared_ptr<StorageLocation> LocationIndex::findFirstFit(int quantity, WarehouseSection::SectionType sectionType) const noexcept {
+    return firstFit(quantity, static_cast<std::size_t>(sectionType));
+}
+
+std::shared_ptr<StorageLocation> LocationIndex::findFirstFit(int quantity) const noexcept {
+    return firstFit(quantity, ANY_TYPE);
+}
+
+std::shared_ptr<StorageLocation> LocationIndex::findBestFit(int quantity, WarehouseSection::SectionType sectionType) const noexcept {
+    return bestFit(quantity, static_cast<std::size_t>(sectionType));
+}
+
+std::shared_ptr<StorageLocation> LocationIndex::findBestFit(int quantity) const noexcept {
+    return bestFit(quantity, ANY_TYPE);
+}
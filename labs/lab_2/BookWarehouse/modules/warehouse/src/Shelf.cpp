@@ -1,11 +1,10 @@
 #include "Shelf.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
 #include "config/WarehouseConfig.hpp"
-#include <regex>
+#include "utils/IdValidation.hpp"
 
 bool Shelf::isValidShelfId(const std::string& shelfId) const {
-    std::regex pattern("^[A-Z]-\\d{2}$"); // Format: "A-01"
-    return std::regex_match(shelfId, pattern) && !shelfId.empty();
+    return IdValidation::isValidShelfId(shelfId); // Format: "A-01"
 }
 
 bool Shelf::isValidMaxLocations(int maxLocations) const {
@@ -24,6 +23,61 @@ Shelf::Shelf(const std::string& shelfId, int maxLocations) {
     this->maxLocations = maxLocations;
 }
 
+Shelf::Shelf(const Shelf& other)
+    : shelfId(other.shelfId), maxLocations(other.maxLocations), locations(other.locations),
+      totalCapacity(other.totalCapacity), currentLoad(other.currentLoad) {
+    for (const auto& location : locations) {
+        location->addListener(this);
+    }
+}
+
+Shelf& Shelf::operator=(const Shelf& other) {
+    if (this == &other) {
+        return *this;
+    }
+    for (const auto& location : locations) {
+        location->removeListener(this);
+        listeners.notifyDetached(*location);
+    }
+    shelfId = other.shelfId;
+    maxLocations = other.maxLocations;
+    locations = other.locations;
+    totalCapacity = other.totalCapacity;
+    currentLoad = other.currentLoad;
+    for (const auto& location : locations) {
+        location->addListener(this);
+        listeners.notifyAttached(location);
+    }
+    return *this;
+}
+
+Shelf::~Shelf() {
+    for (const auto& location : locations) {
+        location->removeListener(this);
+    }
+}
+
+void Shelf::addListener(CapacityListener* listener) {
+    listeners.add(listener);
+}
+
+void Shelf::removeListener(CapacityListener* listener) noexcept {
+    listeners.remove(listener);
+}
+
+void Shelf::onLocationAttached(const std::shared_ptr<StorageLocation>& location) {
+    listeners.notifyAttached(location);
+}
+
+void Shelf::onLocationDetached(const StorageLocation& location) {
+    listeners.notifyDetached(location);
+}
+
+void Shelf::onLocationChanged(const StorageLocation& location, int loadDelta) {
+    currentLoad += loadDelta;
+    listeners.notifyChanged(location, loadDelta);
+}
+
 std::string Shelf::getShelfId() const noexcept {
     return shelfId;
 }
@@ -36,7 +90,7 @@ int Shelf::getCurrentLocationsCount() const noexcept {
     return locations.size();
 }
 
-std::vector<std::shared_ptr<StorageLocation>> Shelf::getLocations() const noexcept {
+const std::vector<std::shared_ptr<StorageLocation>>& Shelf::getLocations() const noexcept {
     return locations;
 }
 
@@ -51,6 +105,10 @@ void Shelf::addLocation(std::shared_ptr<StorageLocation> location) {
         throw DuplicateBookException("Location " + location->getLocationId() + " already exists on shelf " + shelfId);
     }
     locations.push_back(location);
+    location->addListener(this);
+    totalCapacity += location->getCapacity();
+    currentLoad += location->getCurrentLoad();
+    listeners.notifyAttached(location);
 }
 
 void Shelf::removeLocation(const std::string& locationId) {
@@ -59,7 +117,12 @@ void Shelf::removeLocation(const std::string& locationId) {
             return loc->getLocationId() == locationId;
         });
     if (it != locations.end()) {
+        auto location = *it;
         locations.erase(it);
+        location->removeListener(this);
+        totalCapacity -= location->getCapacity();
+        currentLoad -= location->getCurrentLoad();
+        listeners.notifyDetached(*location);
     }
 }
 
@@ -98,19 +161,11 @@ bool Shelf::hasAvailableSpace() const noexcept {
 }
 
 int Shelf::getTotalCapacity() const noexcept {
-    int total = 0;
-    for (const auto& location : locations) {
-        total += location->getCapacity();
-    }
-    return total;
+    return totalCapacity;
 }
 
 int Shelf::getCurrentLoad() const noexcept {
-    int total = 0;
-    for (const auto& location : locations) {
-        total += location->getCurrentLoad();
-    }
-    return total;
+    return currentLoad;
 }
 
 int Shelf::getAvailableSpace() const noexcept {
@@ -0,0 +1,527 @@
+#include "StockJournal.hpp"
+#include "Warehouse.hpp"
+#include "WarehouseSnapshot.hpp"
+#include "StockReceipt.hpp"
+#include "StockWriteOff.hpp"
+#include "StockTransfer.hpp"
+#include "exceptions/WarehouseExceptions.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/Checksum.hpp"
+#include "utils/MappedFile.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+// Like snapshots, journals are written in the byte order of the machine
+constexpr char MAGIC[8] = {'B', 'W', 'J', 'R', 'N', 'L', '\r', '\n'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint32_t ENDIAN_MARK = 0x01020304;
+
+struct JournalHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianMark;
+    std::uint64_t snapshotChecksum; // Checksum of the snapshot the records follow
+    std::uint64_t checksum;         // Checksum of the fields above
+};
+
+// Every record starts at a multiple of 8 bytes, its body is padded with zeros
+struct RecordHeader {
+    std::uint32_t length;           // Bytes of the body without padding
+    std::uint32_t reserved;
+    std::uint64_t sequence;         // Number of the record in the journal, from 0
+    std::uint64_t checksum;         // Checksum of length, sequence and the body
+};
+
+constexpr std::size_t HEADER_FIELDS = offsetof(JournalHeader, checksum);
+constexpr std::size_t RECORD_FIELDS = offsetof(RecordHeader, checksum);
+
+std::size_t padded(std::size_t size) noexcept {
+    return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+JournalHeader makeHeader(std::uint64_t snapshotChecksum) noexcept {
+    JournalHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.endianMark = ENDIAN_MARK;
+    header.snapshotChecksum = snapshotChecksum;
+    header.checksum = Checksum::compute(&header, HEADER_FIELDS);
+    return header;
+}
+
+/**
+ * @brief Valid part of a journal file
+ *
+ */
+struct JournalScan {
+    bool follows = false;                   // The journal follows the snapshot
+    std::size_t validSize = 0;              // Bytes up to the end of the last valid record
+    std::vector<std::string_view> records;  // Bodies of valid records, in order
+};
+
+// A journal of another snapshot is not an error: it is left by a checkpoint interrupted after saving the snapshot
+JournalScan scanJournal(std::string_view data, std::uint64_t snapshotChecksum, const std::string& path) {
+    JournalScan scan;
+    JournalHeader header;
+    if (data.size() < sizeof(header)) {
+        return scan;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        header.checksum != Checksum::compute(&header, HEADER_FIELDS)) {
+        return scan;
+    }
+    if (header.version != VERSION || header.endianMark != ENDIAN_MARK) {
+        throw WarehouseException("Unsupported stock journal version " + std::to_string(header.version) + ": " + path);
+    }
+    if (header.snapshotChecksum != snapshotChecksum) {
+        return scan;
+    }
+    scan.follows = true;
+    std::size_t offset = sizeof(header);
+    // An interrupted write leaves a short or corrupted record, everything after it is ignored
+    while (data.size() - offset >= sizeof(RecordHeader)) {
+        RecordHeader record;
+        std::memcpy(&record, data.data() + offset, sizeof(record));
+        std::size_t available = data.size() - offset - sizeof(record);
+        if (record.sequence != scan.records.size() || padded(record.length) > available) {
+            break;
+        }
+        std::string_view body = data.substr(offset + sizeof(record), record.length);
+        if (Checksum::compute(body.data(), body.size(), Checksum::compute(&record, RECORD_FIELDS)) != record.checksum) {
+            break;
+        }
+        scan.records.push_back(body);
+        offset += sizeof(record) + padded(record.length);
+    }
+    scan.validSize = offset;
+    return scan;
+}
+
+/**
+ * @brief Writes fields of a journal record
+ *
+ */
+class Encoder {
+public:
+    template <typename T>
+    void value(T value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values are encoded");
+        data.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    void text(const std::string& text) {
+        value(static_cast<std::uint32_t>(text.size()));
+        data += text;
+    }
+
+    std::string data;
+};
+
+/**
+ * @brief Reads fields of a journal record
+ *
+ */
+class Decoder {
+public:
+    Decoder(std::string_view data, std::string source) : data(data), source(std::move(source)) {}
+
+    template <typename T>
+    T value() {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values are decoded");
+        if (data.size() - offset < sizeof(T)) {
+            damaged();
+        }
+        T value;
+        std::memcpy(&value, data.data() + offset, sizeof(value));
+        offset += sizeof(value);
+        return value;
+    }
+
+    std::string text() {
+        std::uint32_t length = value<std::uint32_t>();
+        if (data.size() - offset < length) {
+            damaged();
+        }
+        std::string text(data.substr(offset, length));
+        offset += length;
+        return text;
+    }
+
+    bool finished() const noexcept {
+        return offset == data.size();
+    }
+
+    const std::string& getSource() const noexcept {
+        return source;
+    }
+
+    [[noreturn]] void damaged() const {
+        throw WarehouseException(source + " is damaged");
+    }
+
+private:
+    std::string_view data;
+    std::size_t offset = 0;
+    std::string source;
+};
+
+/**
+ * @brief Affected item as captured before execution
+ *
+ */
+struct ItemEntry {
+    std::uint64_t isbn;
+    std::string locationId;
+    std::int32_t quantity;
+    std::string dateAdded;
+    bool indexed;           // The item of the warehouse, otherwise a separate object passed to the movement
+};
+
+/**
+ * @brief Executes journal records again on a restored warehouse
+ *
+ */
+class Replayer {
+public:
+    explicit Replayer(std::shared_ptr<Warehouse> warehouse) : warehouse(std::move(warehouse)) {
+        this->warehouse->forEachLocation([this](const std::shared_ptr<StorageLocation>& location) {
+            locations.emplace(location->getLocationId(), location);
+        });
+    }
+
+    void apply(std::string_view record, const std::string& source) {
+        Decoder in(record, source);
+        auto type = static_cast<StockMovement::MovementType>(in.value<std::uint8_t>());
+        std::string movementId = in.text();
+        std::string movementDate = in.text();
+        std::string employeeId = in.text();
+        std::string notes = in.text();
+
+        std::shared_ptr<StockMovement> movement;
+        if (type == StockMovement::MovementType::RECEIPT) {
+            std::string supplierName = in.text();
+            std::string purchaseOrderNumber = in.text();
+            std::string invoiceNumber = in.text();
+            double totalCost = in.value<double>();
+            movement = std::make_shared<StockReceipt>(movementId, movementDate, employeeId, warehouse, supplierName,
+                                                      purchaseOrderNumber, invoiceNumber, totalCost, notes);
+        } else if (type == StockMovement::MovementType::WRITE_OFF) {
+            auto reason = static_cast<StockWriteOff::WriteOffReason>(in.value<std::uint8_t>());
+            std::string detailedReason = in.text();
+            movement = std::make_shared<StockWriteOff>(movementId, movementDate, employeeId, warehouse,
+                                                       reason, detailedReason, notes);
+        } else if (type == StockMovement::MovementType::TRANSFER) {
+            std::string sourceId = in.text();
+            std::string destinationId = in.text();
+            std::string transferReason = in.text();
+            movement = std::make_shared<StockTransfer>(movementId, movementDate, employeeId, warehouse,
+                                                       findLocation(sourceId, in), findLocation(destinationId, in),
+                                                       transferReason, notes);
+        } else {
+            in.damaged();
+        }
+
+        std::vector<ItemEntry> items(in.value<std::uint32_t>());
+        for (auto& item : items) {
+            item.isbn = in.value<std::uint64_t>();
+            item.locationId = in.text();
+            item.quantity = in.value<std::int32_t>();
+            item.dateAdded = in.text();
+            item.indexed = in.value<std::uint8_t>() != 0;
+        }
+        // Copied out of the record: snapshot data have to be aligned
+        std::string booksImage = in.text();
+        std::unordered_map<ISBN, std::shared_ptr<Book>> embeddedBooks;
+        if (!booksImage.empty()) {
+            for (auto& book : WarehouseSnapshot::loadBooks(booksImage, source)) {
+                embeddedBooks.emplace(book->getISBN(), std::move(book));
+            }
+        }
+        bool succeeded = in.value<std::uint8_t>() != 0;
+        if (!in.finished()) {
+            in.damaged();
+        }
+
+        for (const auto& entry : items) {
+            ISBN isbn = ISBN::fromPacked(entry.isbn);
+            if (entry.indexed) {
+                auto item = warehouse->findInventoryItem(isbn, entry.locationId);
+                if (!item) {
+                    throw WarehouseException(source + " refers to missing inventory item " +
+                                             isbn.getCode() + " at " + entry.locationId);
+                }
+                movement->addAffectedItem(item);
+            } else {
+                movement->addAffectedItem(std::make_shared<InventoryItem>(
+                    findBook(isbn, embeddedBooks, in), entry.quantity, findLocation(entry.locationId, in), entry.dateAdded));
+            }
+        }
+
+        // A movement that failed when recorded may have changed stock before failing, it is executed as well
+        try {
+            warehouse->processStockMovement(movement);
+        } catch (const WarehouseException& e) {
+            if (succeeded) {
+                throw WarehouseException("Cannot replay " + source + ": " + e.what());
+            }
+            return;
+        }
+        if (!succeeded) {
+            throw WarehouseException("Cannot replay " + source + ": movement " + movementId + " did not fail as recorded");
+        }
+    }
+
+private:
+    std::shared_ptr<StorageLocation> findLocation(const std::string& locationId, const Decoder& in) {
+        auto found = locations.find(locationId);
+        if (found != locations.end()) {
+            return found->second;
+        }
+        // Items may be placed into locations that are on no shelf
+        std::shared_ptr<StorageLocation> location;
+        warehouse->forEachInventoryItem([&](const std::shared_ptr<InventoryItem>& item) {
+            if (!location && item->getLocation() && item->getLocation()->getLocationId() == locationId) {
+                location = item->getLocation();
+            }
+        });
+        if (!location) {
+            throw WarehouseException(in.getSource() + " refers to unknown location " + locationId);
+        }
+        locations.emplace(locationId, location);
+        return location;
+    }
+
+    std::shared_ptr<Book> findBook(const ISBN& isbn, const std::unordered_map<ISBN, std::shared_ptr<Book>>& embeddedBooks,
+                                   const Decoder& in) const {
+        auto embedded = embeddedBooks.find(isbn);
+        if (embedded != embeddedBooks.end()) {
+            return embedded->second;
+        }
+        auto stock = warehouse->findInventoryByBook(isbn.getCode());
+        if (stock.empty()) {
+            throw WarehouseException(in.getSource() + " refers to unknown book " + isbn.getCode());
+        }
+        return stock.front()->getBook();
+    }
+
+    std::shared_ptr<Warehouse> warehouse;
+    std::unordered_map<std::string, std::shared_ptr<StorageLocation>> locations;
+};
+}
+
+StockJournal::StockJournal(const std::string& path, const std::string& snapshotPath, int commitIntervalMs)
+    : path(path), snapshotPath(snapshotPath), commitInterval(commitIntervalMs) {
+    if (commitIntervalMs <= 0 || commitIntervalMs > WarehouseConfig::StockJournal::MAX_COMMIT_INTERVAL_MS) {
+        throw DataValidationException("Invalid journal commit interval: " + std::to_string(commitIntervalMs));
+    }
+    std::uint64_t snapshotChecksum = WarehouseSnapshot::getChecksum(snapshotPath);
+    JournalScan scan;
+    if (::access(path.c_str(), F_OK) == 0) {
+        MappedFile file(path);
+        scan = scanJournal(file.text(), snapshotChecksum, path);
+    }
+    if (scan.follows) {
+        descriptor = ::open(path.c_str(), O_WRONLY | O_APPEND);
+        if (descriptor < 0 || ::ftruncate(descriptor, static_cast<off_t>(scan.validSize)) != 0 || ::fsync(descriptor) != 0) {
+            if (descriptor >= 0) {
+                ::close(descriptor);
+            }
+            throw WarehouseException("Cannot open stock journal: " + path);
+        }
+        recordCount = scan.records.size();
+    } else {
+        startJournal(snapshotChecksum);
+    }
+    flusher = std::thread(&StockJournal::flushLoop, this);
+}
+
+StockJournal::~StockJournal() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeFlusher.notify_all();
+    flusher.join();
+    flush(); // the thread may stop before its first commit, records must not stay unflushed
+    ::close(descriptor);
+}
+
+void StockJournal::startJournal(std::uint64_t snapshotChecksum) {
+    JournalHeader header = makeHeader(snapshotChecksum);
+    AtomicFile::write(path, std::string_view(reinterpret_cast<const char*>(&header), sizeof(header)));
+    int reopened = ::open(path.c_str(), O_WRONLY | O_APPEND);
+    if (reopened < 0) {
+        throw WarehouseException("Cannot open stock journal: " + path);
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+    descriptor = reopened;
+    recordCount = 0;
+}
+
+void StockJournal::flush() {
+    std::lock_guard<std::mutex> flushLock(flushMutex);
+    std::uint64_t target;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (broken || durableCount == appendedCount) {
+            return;
+        }
+        target = appendedCount;
+    }
+    // Appends go on while the file is flushed, they wait for the next commit
+    bool flushed = ::fdatasync(descriptor) == 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (flushed) {
+            durableCount = std::max(durableCount, target);
+        } else {
+            broken = true;
+        }
+    }
+    committed.notify_all();
+}
+
+void StockJournal::flushLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        wakeFlusher.wait_for(lock, commitInterval, [this] { return stopping; });
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+std::string StockJournal::capture(const Warehouse& warehouse, const StockMovement& movement) {
+    Encoder out;
+    out.value(static_cast<std::uint8_t>(movement.getMovementType()));
+    out.text(movement.getMovementId());
+    out.text(movement.getMovementDate());
+    out.text(movement.getEmployeeId());
+    out.text(movement.getNotes());
+    if (auto receipt = dynamic_cast<const StockReceipt*>(&movement)) {
+        out.text(receipt->getSupplierName());
+        out.text(receipt->getPurchaseOrderNumber());
+        out.text(receipt->getInvoiceNumber());
+        out.value(receipt->getTotalCost());
+    } else if (auto writeOff = dynamic_cast<const StockWriteOff*>(&movement)) {
+        out.value(static_cast<std::uint8_t>(writeOff->getReason()));
+        out.text(writeOff->getDetailedReason());
+    } else if (auto transfer = dynamic_cast<const StockTransfer*>(&movement)) {
+        out.text(transfer->getSourceLocation()->getLocationId());
+        out.text(transfer->getDestinationLocation()->getLocationId());
+        out.text(transfer->getTransferReason());
+    } else {
+        throw WarehouseException("Cannot journal stock movement of unknown type: " + movement.getMovementId());
+    }
+
+    const auto& items = movement.getAffectedItems();
+    out.value(static_cast<std::uint32_t>(items.size()));
+    std::vector<std::shared_ptr<Book>> newBooks;
+    std::unordered_set<ISBN> seenIsbns;
+    for (const auto& item : items) {
+        const ISBN& isbn = item->getBook()->getISBN();
+        std::string locationId = item->getLocation()->getLocationId();
+        bool indexed = warehouse.findInventoryItem(isbn, locationId) == item;
+        out.value(isbn.getPackedCode());
+        out.text(locationId);
+        out.value(static_cast<std::int32_t>(item->getQuantity()));
+        out.text(item->getDateAdded());
+        out.value(static_cast<std::uint8_t>(indexed));
+        // Books in stock are found by ISBN on replay, others are stored with the record
+        if (!indexed && warehouse.findInventoryByBook(item->getBook()).empty() && seenIsbns.insert(isbn).second) {
+            newBooks.push_back(item->getBook());
+        }
+    }
+    out.text(newBooks.empty() ? std::string() : WarehouseSnapshot::saveBooks(newBooks));
+    return std::move(out.data);
+}
+
+void StockJournal::append(const std::string& record, bool succeeded) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (broken) {
+        throw WarehouseException("Stock journal is not writable after an error: " + path);
+    }
+    // A lost or partly written record would hide the movement from recovery,
+    // so any failure closes the journal for writing until the next checkpoint
+    try {
+        std::string bytes(sizeof(RecordHeader), '\0');
+        bytes += record;
+        bytes.push_back(succeeded ? 1 : 0);
+        RecordHeader header{};
+        header.length = static_cast<std::uint32_t>(bytes.size() - sizeof(header));
+        bytes.resize(padded(bytes.size()), '\0');
+        header.sequence = recordCount;
+        header.checksum = Checksum::compute(bytes.data() + sizeof(header), header.length,
+                                            Checksum::compute(&header, RECORD_FIELDS));
+        std::memcpy(&bytes[0], &header, sizeof(header));
+        if (!AtomicFile::writeAll(descriptor, bytes)) {
+            throw WarehouseException("Cannot write stock journal: " + path);
+        }
+    } catch (...) {
+        broken = true;
+        committed.notify_all();
+        throw;
+    }
+    ++recordCount;
+    ++appendedCount;
+}
+
+void StockJournal::sync() {
+    std::unique_lock<std::mutex> lock(mutex);
+    std::uint64_t target = appendedCount;
+    committed.wait(lock, [this, target] { return durableCount >= target || broken; });
+    if (broken) { // also when a record was lost, even if the earlier ones are on disk
+        throw WarehouseException("Cannot flush stock journal: " + path);
+    }
+}
+
+void StockJournal::checkpoint(const Warehouse& warehouse) {
+    {
+        std::lock_guard<std::mutex> flushLock(flushMutex);
+        std::lock_guard<std::mutex> lock(mutex);
+        std::uint64_t snapshotChecksum = WarehouseSnapshot::save(warehouse, snapshotPath);
+        // The old journal no longer follows the snapshot, appending to it would lose records
+        try {
+            startJournal(snapshotChecksum);
+        } catch (const WarehouseException&) {
+            broken = true;
+            committed.notify_all();
+            throw;
+        }
+        broken = false;
+        durableCount = appendedCount;
+    }
+    committed.notify_all();
+}
+
+std::uint64_t StockJournal::getRecordCount() noexcept {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recordCount;
+}
+
+std::shared_ptr<Warehouse> StockJournal::recover(const std::string& snapshotPath, const std::string& journalPath) {
+    std::shared_ptr<Warehouse> warehouse = WarehouseSnapshot::load(snapshotPath);
+    if (::access(journalPath.c_str(), F_OK) != 0) {
+        return warehouse;
+    }
+    MappedFile file(journalPath);
+    JournalScan scan = scanJournal(file.text(), WarehouseSnapshot::getChecksum(snapshotPath), journalPath);
+    Replayer replayer(warehouse);
+    for (std::size_t i = 0; i < scan.records.size(); ++i) {
+        replayer.apply(scan.records[i], "Stock journal record " + std::to_string(i) + " in " + journalPath);
+    }
+    return warehouse;
+}
@@ -1,11 +1,11 @@
 #include "StockMovement.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
 #include "utils/Utils.hpp"
-#include <regex>
+#include "utils/IdValidation.hpp"
+#include <algorithm>
 
 bool StockMovement::isValidMovementId(const std::string& movementId) const {
-    std::regex pattern("^(MOV|REC|WO|TRF|DEL)-\\d{4}-\\d{3}$");
-    return std::regex_match(movementId, pattern);
+    return IdValidation::isValidMovementId(movementId);
 }
 
 bool StockMovement::isValidDate(const std::string& date) const {
@@ -14,8 +14,7 @@ bool StockMovement::isValidDate(const std::string& date) const {
 
 bool StockMovement::isValidEmployeeId(const std::string& employeeId) const {
     //"EMP-001"
-    std::regex pattern("^EMP-\\d{3}$");
-    return std::regex_match(employeeId, pattern);
+    return IdValidation::isValidEmployeeId(employeeId);
 }
 
 StockMovement::StockMovement(const std::string& movementId, MovementType movementType,
@@ -62,7 +61,7 @@ std::string StockMovement::getEmployeeId() const noexcept {
     return employeeId;
 }
 
-std::vector<std::shared_ptr<InventoryItem>> StockMovement::getAffectedItems() const noexcept {
+const std::vector<std::shared_ptr<InventoryItem>>& StockMovement::getAffectedItems() const noexcept {
     return affectedItems;
 }
 
@@ -86,11 +85,11 @@ void StockMovement::addAffectedItem(std::shared_ptr<InventoryItem> item) {
     if (!item) {
         throw DataValidationException("Cannot add null inventory item to movement");
     }
-    auto it = std::find(affectedItems.begin(), affectedItems.end(), item);
-    if (it != affectedItems.end()) {
+    if (affectedItemSet.count(item.get())) {
         throw DataValidationException("Inventory item already added to movement");
     }
     affectedItems.push_back(item);
+    affectedItemSet.insert(item.get());
 }
 
 void StockMovement::removeAffectedItem(std::shared_ptr<InventoryItem> item) {
@@ -98,6 +97,7 @@ void StockMovement::removeAffectedItem(std::shared_ptr<InventoryItem> item) {
     auto it = std::find(affectedItems.begin(), affectedItems.end(), item);
     if (it != affectedItems.end()) {
         affectedItems.erase(it);
+        affectedItemSet.erase(item.get());
     }
 }
 
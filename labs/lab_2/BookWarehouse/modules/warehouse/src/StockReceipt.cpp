@@ -3,20 +3,18 @@
 #include "config/WarehouseConfig.hpp"
 #include "utils/Utils.hpp"
 #include "Warehouse.hpp"
-#include <regex>
+#include "utils/IdValidation.hpp"
 
 bool StockReceipt::isValidSupplierName(const std::string& supplierName) const {
     return StringValidation::isValidName(supplierName, 100);
 }
 
 bool StockReceipt::isValidPurchaseOrderNumber(const std::string& poNumber) const {
-    std::regex pattern("^PO-\\d{4}-\\d{3}$");
-    return std::regex_match(poNumber, pattern);
+    return IdValidation::isValidPurchaseOrderNumber(poNumber);
 }
 
 bool StockReceipt::isValidInvoiceNumber(const std::string& invoiceNumber) const {
-    std::regex pattern("^INV-\\d{4}-\\d{3}$");
-    return std::regex_match(invoiceNumber, pattern);
+    return IdValidation::isValidInvoiceNumber(invoiceNumber);
 }
 
 bool StockReceipt::isValidTotalCost(double cost) const {
@@ -82,10 +80,7 @@ void StockReceipt::execute() {
             if (location->getStatus() == StorageLocation::LocationStatus::BLOCKED) {
                 throw WarehouseException("Cannot add items to blocked location: " + location->getLocationId());
             }
-            warehouse->addInventoryItem(item);
-            int receiptQuantity = item->getQuantity();
-            item->increaseQuantity(receiptQuantity);
-            location->addBooks(receiptQuantity);
+            warehouse->addInventoryItem(item); // books the item quantity at its location
         }
         setStatus(MovementStatus::COMPLETED);
     } catch (const std::exception& e) {
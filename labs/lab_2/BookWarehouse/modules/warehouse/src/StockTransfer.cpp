@@ -2,7 +2,6 @@
 #include "exceptions/WarehouseExceptions.hpp"
 #include "config/WarehouseConfig.hpp"
 #include "Warehouse.hpp"
-#include <regex>
 
 bool StockTransfer::isValidTransferReason(const std::string& reason) const {
     return !reason.empty() && 
@@ -1,12 +1,11 @@
 #include "StorageLocation.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
 #include "config/WarehouseConfig.hpp"
-#include <regex>
+#include "utils/IdValidation.hpp"
 
 bool StorageLocation::isValidLocationId(const std::string& locationId) const {
     // "A-01-B-05" (Section-Shelf-Row-Cell)
-    std::regex pattern("^[A-Z]-\\d{2}-[A-Z]-\\d{2}$");
-    return std::regex_match(locationId, pattern) && !locationId.empty();
+    return IdValidation::isValidLocationId(locationId);
 }
 
 bool StorageLocation::isValidCapacity(int capacity) const {
@@ -77,6 +76,7 @@ void StorageLocation::addBooks(int count) {
     if (currentLoad > 0) {
         status = LocationStatus::OCCUPIED;
     }
+    listeners.notifyChanged(*this, count);
 }
 
 void StorageLocation::removeBooks(int count) {
@@ -95,10 +95,23 @@ void StorageLocation::removeBooks(int count) {
     if (currentLoad == 0) {
         status = LocationStatus::FREE;
     }
+    listeners.notifyChanged(*this, -count);
 }
 
 void StorageLocation::setStatus(LocationStatus newStatus) noexcept {
+    if (status == newStatus) {
+        return;
+    }
     status = newStatus;
+    listeners.notifyChanged(*this, 0);
+}
+
+void StorageLocation::addListener(CapacityListener* listener) {
+    listeners.add(listener);
+}
+
+void StorageLocation::removeListener(CapacityListener* listener) noexcept {
+    listeners.remove(listener);
 }
 
 bool StorageLocation::isEmpty() const noexcept {
@@ -1,8 +1,40 @@
 #include "Warehouse.hpp"
+#include "StockJournal.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
 #include "config/WarehouseConfig.hpp"
 #include "utils/Utils.hpp"
 #include <algorithm>
+#include <unordered_set>
+
+/**
+ * @brief Forwards changes of one section to the location index and the totals of the warehouse
+ * 
+ */
+class Warehouse::SectionWatcher : public CapacityListener {
+public:
+    SectionWatcher(Warehouse& warehouse, WarehouseSection::SectionType sectionType) : warehouse(warehouse), sectionType(sectionType) {}
+
+    void onLocationAttached(const std::shared_ptr<StorageLocation>& location) override {
+        warehouse.locationIndex.insert(location, sectionType);
+        warehouse.totalCapacity += location->getCapacity();
+        warehouse.currentLoad += location->getCurrentLoad();
+    }
+
+    void onLocationDetached(const StorageLocation& location) override {
+        warehouse.locationIndex.erase(location);
+        warehouse.totalCapacity -= location.getCapacity();
+        warehouse.currentLoad -= location.getCurrentLoad();
+    }
+
+    void onLocationChanged(const StorageLocation& location, int loadDelta) override {
+        warehouse.locationIndex.update(location);
+        warehouse.currentLoad += loadDelta;
+    }
+
+private:
+    Warehouse& warehouse;
+    WarehouseSection::SectionType sectionType;
+};
 
 bool Warehouse::isValidName(const std::string& name) const {
     return StringValidation::isValidName(name, WarehouseConfig::Warehouse::MAX_NAME_LENGTH);
@@ -23,26 +55,203 @@ Warehouse::Warehouse(const std::string& name, const std::string& address) {
     this->address = address;
 }
 
+Warehouse::Warehouse(const Warehouse& other)
+    : name(other.name), address(other.address), inventory(other.inventory), stockByIsbn(other.stockByIsbn),
+      inventoryPositions(other.inventoryPositions) {
+    try {
+        for (const auto& section : other.sections) {
+            attachSection(section);
+        }
+    } catch (...) {
+        detachSections(); // the destructor does not run, sections must not keep our watchers
+        throw;
+    }
+}
+
+Warehouse& Warehouse::operator=(const Warehouse& other) {
+    if (this == &other) {
+        return *this;
+    }
+    detachSections();
+    name = other.name;
+    address = other.address;
+    inventory = other.inventory;
+    stockByIsbn = other.stockByIsbn;
+    inventoryPositions = other.inventoryPositions;
+    sections.clear();
+    for (const auto& section : other.sections) {
+        attachSection(section);
+    }
+    return *this;
+}
+
+Warehouse::~Warehouse() {
+    detachSections();
+}
+
+void Warehouse::attachSection(const std::shared_ptr<WarehouseSection>& section) {
+    sections.reserve(sections.size() + 1);
+    sectionWatchers.reserve(sections.size() + 1);
+    auto watcher = std::make_unique<SectionWatcher>(*this, section->getSectionType());
+    std::size_t attached = 0;
+    try {
+        section->forEachLocation([&watcher, &attached](const std::shared_ptr<StorageLocation>& location) {
+            watcher->onLocationAttached(location);
+            attached++;
+        });
+        section->addListener(watcher.get());
+    } catch (...) {
+        std::size_t detached = 0; // undo the locations indexed before the failure, in the same order
+        section->forEachLocation([&watcher, &detached, attached](const std::shared_ptr<StorageLocation>& location) {
+            if (detached++ < attached) watcher->onLocationDetached(*location);
+        });
+        throw;
+    }
+    sections.push_back(section); // reserved, the section and its watcher are added together
+    sectionWatchers.push_back(std::move(watcher));
+}
+
+void Warehouse::detachSections() noexcept {
+    for (std::size_t i = 0; i < sectionWatchers.size(); ++i) {
+        sections[i]->removeListener(sectionWatchers[i].get());
+    }
+    sectionWatchers.clear();
+    locationIndex.clear();
+    totalCapacity = 0;
+    currentLoad = 0;
+}
+
+void Warehouse::eraseInventoryItem(const std::shared_ptr<InventoryItem>& item) {
+    auto position = inventoryPositions.find(item.get());
+    if (position == inventoryPositions.end()) {
+        return;
+    }
+    std::size_t index = position->second;
+    inventoryPositions.erase(position);
+    if (index + 1 != inventory.size()) { // swap with last, O(1)
+        inventory[index] = std::move(inventory.back());
+        inventoryPositions[inventory[index].get()] = index;
+    }
+    inventory.pop_back();
+
+    auto stock = stockByIsbn.find(item->getBook()->getISBN());
+    if (stock == stockByIsbn.end()) {
+        return;
+    }
+    BookStock& bookStock = stock->second;
+    bookStock.items.erase(std::find(bookStock.items.begin(), bookStock.items.end(), item));
+    bookStock.totalQuantity = 0; // A book has few items, recount instead of drifting
+    for (const auto& remaining : bookStock.items) {
+        bookStock.totalQuantity += remaining->getQuantity();
+    }
+    for (auto byLocation = bookStock.itemsByLocation.begin(); byLocation != bookStock.itemsByLocation.end(); ++byLocation) {
+        if (byLocation->second == item) { // found by value: the item may have moved since it was indexed
+            bookStock.itemsByLocation.erase(byLocation);
+            break;
+        }
+    }
+    if (bookStock.items.empty()) {
+        stockByIsbn.erase(stock);
+    }
+}
+
+void Warehouse::refreshBookStock(const ISBN& bookIsbn) {
+    auto stock = stockByIsbn.find(bookIsbn);
+    if (stock == stockByIsbn.end()) {
+        return;
+    }
+    std::vector<std::shared_ptr<InventoryItem>> items = stock->second.items;
+    for (const auto& item : items) {
+        if (item->getQuantity() == 0) {
+            eraseInventoryItem(item);
+        }
+    }
+    stock = stockByIsbn.find(bookIsbn);
+    if (stock == stockByIsbn.end()) {
+        return;
+    }
+    BookStock& bookStock = stock->second;
+    bookStock.itemsByLocation.clear();
+    std::vector<std::shared_ptr<InventoryItem>> merged;
+    for (const auto& item : bookStock.items) {
+        auto placed = bookStock.itemsByLocation.emplace(item->getLocation()->getLocationId(), item); // location could have changed
+        if (!placed.second) { // Moved onto a location that already holds the book: one item per location
+            placed.first->second->increaseQuantity(item->getQuantity()); // fits, the location load is below MAX_QUANTITY
+            item->setQuantity(0);
+            merged.push_back(item);
+        }
+    }
+    for (const auto& item : merged) {
+        eraseInventoryItem(item);
+    }
+    bookStock.totalQuantity = 0;
+    for (const auto& item : bookStock.items) {
+        bookStock.totalQuantity += item->getQuantity();
+    }
+}
+
 void Warehouse::cleanupZeroQuantityItems() {
-    inventory.erase(
-        std::remove_if(inventory.begin(), inventory.end(),
-            [](const std::shared_ptr<InventoryItem>& item) {
-                return item && item->getQuantity() == 0;
-            }),
-        inventory.end()
-    );
+    std::vector<ISBN> isbns;
+    isbns.reserve(stockByIsbn.size());
+    for (const auto& stock : stockByIsbn) {
+        isbns.push_back(stock.first);
+    }
+    for (const auto& isbn : isbns) {
+        refreshBookStock(isbn);
+    }
 }
 
 void Warehouse::processStockMovement(std::shared_ptr<StockMovement> movement) {
     if (!movement) {
         throw DataValidationException("Cannot process null stock movement");
     }
+    // Only books of affected items can change
+    std::vector<ISBN> affectedIsbns;
+    std::unordered_set<ISBN> seenIsbns;
+    for (const auto& item : movement->getAffectedItems()) {
+        if (item && seenIsbns.insert(item->getBook()->getISBN()).second) {
+            affectedIsbns.push_back(item->getBook()->getISBN());
+        }
+    }
+    // Captured before execution: it changes quantities and locations of the affected items
+    std::string journalRecord;
+    if (journal && movement->isPending()) {
+        journalRecord = StockJournal::capture(*this, *movement);
+    }
+    // The caller sees the outcome of the movement only. A journal that fails to append
+    // stays broken and reports it from StockJournal::sync()
+    auto record = [this, &journalRecord](bool succeeded) {
+        if (journalRecord.empty()) {
+            return;
+        }
+        try {
+            journal->append(journalRecord, succeeded);
+        } catch (const std::exception&) {
+            // the journal is broken now, sync() fails until a checkpoint
+        }
+    };
     try {
         movement->execute();
-        cleanupZeroQuantityItems(); // Clean up after movement
+        for (const auto& isbn : affectedIsbns) {
+            refreshBookStock(isbn); // Clean up after movement
+        }
     } catch (const std::exception& e) {
+        for (const auto& isbn : affectedIsbns) {
+            refreshBookStock(isbn);
+        }
+        // A failed movement may have changed stock before failing, replay has to repeat it
+        record(false);
         throw WarehouseException("Failed to process stock movement: " + std::string(e.what()));
     }
+    record(true);
+}
+
+void Warehouse::setJournal(std::shared_ptr<StockJournal> journal) noexcept {
+    this->journal = std::move(journal);
+}
+
+std::shared_ptr<StockJournal> Warehouse::getJournal() const noexcept {
+    return journal;
 }
 
 std::string Warehouse::getName() const noexcept {
@@ -53,7 +262,7 @@ std::string Warehouse::getAddress() const noexcept {
     return address;
 }
 
-std::vector<std::shared_ptr<WarehouseSection>> Warehouse::getSections() const noexcept {
+const std::vector<std::shared_ptr<WarehouseSection>>& Warehouse::getSections() const noexcept {
     return sections;
 }
 
@@ -72,7 +281,7 @@ void Warehouse::addSection(std::shared_ptr<WarehouseSection> section) {
         throw WarehouseException("Warehouse cannot have more than " + 
                                std::to_string(WarehouseConfig::Warehouse::MAX_SECTIONS) + " sections");
     }
-    sections.push_back(section);
+    attachSection(section);
 }
 
 void Warehouse::removeSection(const std::string& sectionId) {
@@ -81,7 +290,13 @@ void Warehouse::removeSection(const std::string& sectionId) {
             return section->getSectionId() == sectionId;
         });
     if (it != sections.end()) {
+        auto watcher = sectionWatchers.begin() + (it - sections.begin());
+        (*it)->removeListener(watcher->get());
+        (*it)->forEachLocation([&watcher](const std::shared_ptr<StorageLocation>& location) {
+            (*watcher)->onLocationDetached(*location);
+        });
         sections.erase(it);
+        sectionWatchers.erase(watcher);
     }
 }
 
@@ -108,66 +323,74 @@ void Warehouse::addInventoryItem(std::shared_ptr<InventoryItem> inventoryItem) {
     }
     location->addBooks(inventoryItem->getQuantity());
     
-    auto existing = findInventoryItem(
-        inventoryItem->getBook()->getISBN().getCode(),
-        location->getLocationId()
-    );
-    if (existing) {
+    ISBN isbn = inventoryItem->getBook()->getISBN();
+    std::string locationId = location->getLocationId();
+    if (findInventoryItem(isbn, locationId)) {
         location->removeBooks(inventoryItem->getQuantity());
         throw DataValidationException("Inventory item already exists for book " + 
-                                    inventoryItem->getBook()->getISBN().getCode() + 
-                                    " at location " + location->getLocationId());
+                                    isbn.getCode() + " at location " + locationId);
+    }
+    if (inventoryPositions.count(inventoryItem.get()) != 0) {
+        location->removeBooks(inventoryItem->getQuantity());
+        throw DataValidationException("Inventory item is already in warehouse");
     }
+    BookStock& bookStock = stockByIsbn[isbn];
+    bookStock.itemsByLocation.emplace(std::move(locationId), inventoryItem);
+    bookStock.items.push_back(inventoryItem);
+    bookStock.totalQuantity += inventoryItem->getQuantity();
+    inventoryPositions.emplace(inventoryItem.get(), inventory.size());
     inventory.push_back(inventoryItem);
 }
 
 void Warehouse::removeInventoryItem(const std::string& bookIsbn, const std::string& locationId) {
-    auto it = std::find_if(inventory.begin(), inventory.end(),
-        [&bookIsbn, &locationId](const std::shared_ptr<InventoryItem>& item) {
-            return item->getBook()->getISBN().getCode() == bookIsbn &&
-                   item->getLocation()->getLocationId() == locationId;
-        });
-    if (it != inventory.end()) {
-        auto location = (*it)->getLocation();
+    auto item = findInventoryItem(bookIsbn, locationId);
+    if (item) {
+        auto location = item->getLocation();
         if (location) {
-            location->removeBooks((*it)->getQuantity());
+            location->removeBooks(item->getQuantity());
         }
-        inventory.erase(it);
+        eraseInventoryItem(item);
     }
 }
 
+const Warehouse::BookStock* Warehouse::findStock(const ISBN& bookIsbn) const noexcept {
+    auto stock = stockByIsbn.find(bookIsbn);
+    return (stock != stockByIsbn.end()) ? &stock->second : nullptr;
+}
+
+const Warehouse::BookStock* Warehouse::findStock(const std::string& bookIsbn) const noexcept {
+    std::uint64_t code = ISBN::pack(bookIsbn);
+    return (code != ISBN::INVALID_CODE) ? findStock(ISBN::fromPacked(code)) : nullptr;
+}
+
 std::vector<std::shared_ptr<InventoryItem>> Warehouse::findInventoryByBook(const std::string& bookIsbn) const noexcept {
-    std::vector<std::shared_ptr<InventoryItem>> result;
-    for (const auto& item : inventory) {
-        if (item->getBook()->getISBN().getCode() == bookIsbn) {
-            result.push_back(item);
-        }
-    }
-    return result;
+    const BookStock* stock = findStock(bookIsbn);
+    return stock ? stock->items : std::vector<std::shared_ptr<InventoryItem>>();
 }
 
 std::vector<std::shared_ptr<InventoryItem>> Warehouse::findInventoryByBook(std::shared_ptr<Book> book) const noexcept {
     if (!book) return {};
-    return findInventoryByBook(book->getISBN().getCode());
+    const BookStock* stock = findStock(book->getISBN());
+    return stock ? stock->items : std::vector<std::shared_ptr<InventoryItem>>();
 }
 
 std::shared_ptr<InventoryItem> Warehouse::findInventoryItem(const std::string& bookIsbn, const std::string& locationId) const noexcept {
-    auto it = std::find_if(inventory.begin(), inventory.end(),
-        [&bookIsbn, &locationId](const std::shared_ptr<InventoryItem>& item) {
-            return item->getBook()->getISBN().getCode() == bookIsbn &&
-                   item->getLocation()->getLocationId() == locationId;
-        });
-    return (it != inventory.end()) ? *it : nullptr;
+    std::uint64_t code = ISBN::pack(bookIsbn);
+    return (code != ISBN::INVALID_CODE) ? findInventoryItem(ISBN::fromPacked(code), locationId) : nullptr;
 }
 
-int Warehouse::getBookTotalQuantity(const std::string& bookIsbn) const noexcept {
-    int total = 0;
-    for (const auto& item : inventory) {
-        if (item->getBook()->getISBN().getCode() == bookIsbn) {
-            total += item->getQuantity();
-        }
+std::shared_ptr<InventoryItem> Warehouse::findInventoryItem(const ISBN& bookIsbn, const std::string& locationId) const noexcept {
+    const BookStock* stock = findStock(bookIsbn);
+    if (!stock) {
+        return nullptr;
     }
-    return total;
+    auto item = stock->itemsByLocation.find(locationId);
+    return (item != stock->itemsByLocation.end()) ? item->second : nullptr;
+}
+
+int Warehouse::getBookTotalQuantity(const std::string& bookIsbn) const noexcept {
+    const BookStock* stock = findStock(bookIsbn);
+    return stock ? stock->totalQuantity : 0;
 }
 
 bool Warehouse::isBookInStock(const std::string& bookIsbn) const noexcept {
@@ -176,48 +399,34 @@ bool Warehouse::isBookInStock(const std::string& bookIsbn) const noexcept {
 
 std::vector<std::shared_ptr<StorageLocation>> Warehouse::findAvailableLocations() const noexcept {
     std::vector<std::shared_ptr<StorageLocation>> availableLocations;
-    for (const auto& section : sections) {
-        auto sectionAvailable = section->findAvailableLocations();
-        availableLocations.insert(availableLocations.end(), sectionAvailable.begin(), sectionAvailable.end());
-    }
+    forEachLocation([&availableLocations](const std::shared_ptr<StorageLocation>& location) {
+        if (location->getStatus() == StorageLocation::LocationStatus::FREE) {
+            availableLocations.push_back(location);
+        }
+    });
     return availableLocations;
 }
 
 std::shared_ptr<StorageLocation> Warehouse::findOptimalLocation(int quantity, WarehouseSection::SectionType preferredSectionType) const noexcept {
-    for (const auto& section : sections) {
-        if (section->getSectionType() != preferredSectionType) {
-            continue;
-        }
-        auto availableLocations = section->findAvailableLocations();
-        for (const auto& location : availableLocations) {
-            if (location->canAccommodate(quantity)) {
-                return location;
-            }
-        }
-    }
-    auto allAvailable = findAvailableLocations();
-    for (const auto& location : allAvailable) {
-        if (location->canAccommodate(quantity)) {
-            return location;
-        }
-    }
-    return nullptr;
+    auto location = locationIndex.findFirstFit(quantity, preferredSectionType);
+    return location ? location : locationIndex.findFirstFit(quantity);
+}
+
+std::shared_ptr<StorageLocation> Warehouse::findBestFitLocation(int quantity, WarehouseSection::SectionType preferredSectionType) const noexcept {
+    auto location = locationIndex.findBestFit(quantity, preferredSectionType);
+    return location ? location : locationIndex.findBestFit(quantity);
+}
+
+const LocationIndex& Warehouse::getLocationIndex() const noexcept {
+    return locationIndex;
 }
 
 int Warehouse::getTotalCapacity() const noexcept {
-    int total = 0;
-    for (const auto& section : sections) {
-        total += section->getTotalCapacity();
-    }
-    return total;
+    return totalCapacity;
 }
 
 int Warehouse::getCurrentLoad() const noexcept {
-    int total = 0;
-    for (const auto& section : sections) {
-        total += section->getCurrentLoad();
-    }
-    return total;
+    return currentLoad;
 }
 
 int Warehouse::getAvailableSpace() const noexcept {
@@ -2,6 +2,90 @@
 #include "config/WarehouseConfig.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
 #include "utils/Utils.hpp"
+#include <algorithm>
+#include <array>
+#include <set>
+#include <unordered_map>
+
+namespace {
+/**
+ * @brief Scratch view of the free locations of a warehouse while a receipt is planned
+ * 
+ * Candidates are taken from the LocationIndex of the warehouse on demand, room booked by
+ * the plan so far is kept in a small overlay and booked locations are skipped in the index.
+ * A query costs O(log n) plus the booked locations it passes over, so a small receipt stays
+ * logarithmic and no location the plan does not touch is visited.
+ * 
+ * Only empty locations are FREE and a line takes a location at most once, so a planned
+ * location holds no stock of the received book yet.
+ */
+class ScratchSpace {
+public:
+    struct Bin {
+        std::shared_ptr<StorageLocation> location;  // nullptr - nothing found
+        std::size_t type = 0;
+        int room = 0;                               // units that still fit
+    };
+
+    explicit ScratchSpace(const LocationIndex& index) : index(index) {}
+
+    // Location with the least room of at least quantity, or the largest one if none is that large
+    Bin choose(int quantity, std::size_t preferredType) const {
+        for (std::size_t column : {preferredType, ANY_TYPE}) {
+            Bin fromIndex;
+            index.forEachFit(quantity, column, [this, &fromIndex](const std::shared_ptr<StorageLocation>& location, std::size_t type) {
+                if (booked.count(location.get()) != 0) return false;
+                fromIndex = {location, type, location->getAvailableSpace()};
+                return true;
+            });
+            auto planned = byRoom[column].lower_bound({quantity, 0});
+            Bin fromPlan = planned != byRoom[column].end() ? bookings[planned->second] : Bin();
+            if (fromPlan.location && (!fromIndex.location || fromPlan.room <= fromIndex.room)) return fromPlan;
+            if (fromIndex.location) return fromIndex;
+        }
+        for (std::size_t column : {preferredType, ANY_TYPE}) {
+            Bin fromIndex;
+            index.forEachLargest(column, [this, &fromIndex](const std::shared_ptr<StorageLocation>& location, std::size_t type) {
+                if (booked.count(location.get()) != 0) return false;
+                fromIndex = {location, type, location->getAvailableSpace()};
+                return true;
+            });
+            Bin fromPlan = !byRoom[column].empty() ? bookings[byRoom[column].rbegin()->second] : Bin();
+            if (fromPlan.location && (!fromIndex.location || fromPlan.room >= fromIndex.room)) return fromPlan;
+            if (fromIndex.location) return fromIndex;
+        }
+        return Bin();
+    }
+
+    void take(const Bin& bin, int quantity) {
+        auto found = booked.find(bin.location.get());
+        std::size_t number;
+        if (found == booked.end()) {
+            number = bookings.size();
+            bookings.push_back(bin);
+            booked.emplace(bin.location.get(), number);
+        } else {
+            number = found->second;
+            byRoom[bin.type].erase({bin.room, number});
+            byRoom[ANY_TYPE].erase({bin.room, number});
+        }
+        Bin& entry = bookings[number];
+        entry.room -= quantity;
+        if (entry.room > 0) {
+            byRoom[entry.type].insert({entry.room, number});
+            byRoom[ANY_TYPE].insert({entry.room, number});
+        }
+    }
+
+private:
+    static constexpr std::size_t ANY_TYPE = LocationIndex::ANY_TYPE;
+
+    const LocationIndex& index;
+    std::vector<Bin> bookings;                                          // locations booked by the plan, room left
+    std::unordered_map<const StorageLocation*, std::size_t> booked;     // location -> booking number
+    std::array<std::set<std::pair<int, std::size_t>>, LocationIndex::SECTION_TYPES + 1> byRoom; // (room, booking) of booked locations with room left
+};
+}
 
 WarehouseManager::WarehouseManager(std::shared_ptr<Warehouse> warehouse) 
     : warehouse(warehouse) {
@@ -21,6 +105,59 @@ void WarehouseManager::setWarehouse(std::shared_ptr<Warehouse> warehouse) {
     this->warehouse = warehouse;
 }
 
+std::vector<WarehouseManager::PutawayPlacement> WarehouseManager::planPutaway(
+    const std::vector<std::pair<std::shared_ptr<Book>, int>>& items,
+    WarehouseSection::SectionType preferredSectionType) const {
+    validateWarehouse();
+    // Merge lines of one book, keep the order of first appearance for equal quantities
+    struct Line {
+        std::shared_ptr<Book> book;
+        ISBN isbn;
+        long long quantity;
+    };
+    std::vector<Line> lines;
+    std::unordered_map<ISBN, std::size_t> lineOf;
+    for (const auto& item : items) {
+        if (!item.first) {
+            throw DataValidationException("Cannot add null book to receipt");
+        }
+        if (item.second <= 0) {
+            throw DataValidationException("Receipt quantity must be positive");
+        }
+        ISBN isbn = item.first->getISBN();
+        auto found = lineOf.emplace(isbn, lines.size());
+        if (found.second) {
+            lines.push_back({item.first, isbn, item.second});
+        } else {
+            lines[found.first->second].quantity += item.second;
+        }
+    }
+    std::stable_sort(lines.begin(), lines.end(), [](const Line& a, const Line& b) {
+        return a.quantity > b.quantity;
+    });
+
+    ScratchSpace space(warehouse->getLocationIndex());
+    std::size_t preferredType = static_cast<std::size_t>(preferredSectionType);
+    std::vector<PutawayPlacement> plan;
+    plan.reserve(lines.size());
+    for (const auto& line : lines) {
+        long long remaining = line.quantity;
+        while (remaining > 0) {
+            int wanted = static_cast<int>(std::min<long long>(remaining, WarehouseConfig::StorageLocation::MAX_CAPACITY));
+            ScratchSpace::Bin bin = space.choose(wanted, preferredType);
+            if (!bin.location) {
+                throw WarehouseException("Not enough free space for receipt: " + std::to_string(remaining) +
+                                         " units of book " + line.isbn.getCode() + " cannot be placed");
+            }
+            int quantity = std::min(wanted, bin.room);
+            plan.push_back({line.book, bin.location, quantity});
+            space.take(bin, quantity);
+            remaining -= quantity;
+        }
+    }
+    return plan;
+}
+
 std::shared_ptr<StockReceipt> WarehouseManager::processStockReceipt(
     const std::string& supplierName,
     const std::string& purchaseOrderNumber,
@@ -39,21 +176,9 @@ std::shared_ptr<StockReceipt> WarehouseManager::processStockReceipt(
         movementId, currentDate, employeeId, warehouse,
         supplierName, purchaseOrderNumber, invoiceNumber, totalCost, notes
     );
-    for (const auto& item : items) {
-        auto book = item.first;
-        int quantity = item.second;
-        if (!book) {
-            throw DataValidationException("Cannot add null book to receipt");
-        }
-        if (quantity <= 0) {
-            throw DataValidationException("Receipt quantity must be positive");
-        }
-        auto location = findOptimalBookLocation(book, quantity);
-        if (!location) {
-            throw WarehouseException("No available location found for book");
-        }
+    for (const auto& placement : planPutaway(items)) {
         auto inventoryItem = std::make_shared<InventoryItem>(
-            book, quantity, location, currentDate
+            placement.book, placement.quantity, placement.location, currentDate
         );
         receipt->addAffectedItem(inventoryItem);
     }
@@ -88,7 +213,7 @@ std::shared_ptr<StockWriteOff> WarehouseManager::processStockWriteOff(
             throw DataValidationException("Write-off quantity must be positive");
         }
         auto existingItem = warehouse->findInventoryItem(
-            book->getISBN().getCode(), 
+            book->getISBN(), 
             location->getLocationId()
         );
         if (!existingItem) {
@@ -137,7 +262,7 @@ std::shared_ptr<StockTransfer> WarehouseManager::processStockTransfer(
             throw DataValidationException("Transfer quantity must be positive");
         }
         auto existingItem = warehouse->findInventoryItem(
-            book->getISBN().getCode(), 
+            book->getISBN(), 
             sourceLocation->getLocationId()
         );
         if (!existingItem) {
@@ -2,11 +2,10 @@
 #include "exceptions/WarehouseExceptions.hpp"
 #include "config/WarehouseConfig.hpp"
 #include "utils/Utils.hpp"
-#include <regex>
+#include "utils/IdValidation.hpp"
 
 bool WarehouseSection::isValidSectionId(const std::string& sectionId) const {
-    std::regex pattern("^[A-Z]$");
-    return std::regex_match(sectionId, pattern);
+    return IdValidation::isValidSectionId(sectionId);
 }
 
 bool WarehouseSection::isValidTemperature(double temperature) const {
@@ -46,6 +45,74 @@ WarehouseSection::WarehouseSection(const std::string& sectionId, const std::stri
     this->humidity = humidity;
 }
 
+WarehouseSection::WarehouseSection(const WarehouseSection& other)
+    : sectionId(other.sectionId), name(other.name), description(other.description), sectionType(other.sectionType),
+      shelves(other.shelves), totalCapacity(other.totalCapacity), currentLoad(other.currentLoad),
+      temperature(other.temperature), humidity(other.humidity) {
+    for (const auto& shelf : shelves) {
+        shelf->addListener(this);
+    }
+}
+
+WarehouseSection& WarehouseSection::operator=(const WarehouseSection& other) {
+    if (this == &other) {
+        return *this;
+    }
+    for (const auto& shelf : shelves) {
+        shelf->removeListener(this);
+        for (const auto& location : shelf->getLocations()) {
+            listeners.notifyDetached(*location);
+        }
+    }
+    sectionId = other.sectionId;
+    name = other.name;
+    description = other.description;
+    sectionType = other.sectionType;
+    shelves = other.shelves;
+    temperature = other.temperature;
+    humidity = other.humidity;
+    totalCapacity = other.totalCapacity;
+    currentLoad = other.currentLoad;
+    for (const auto& shelf : shelves) {
+        shelf->addListener(this);
+        for (const auto& location : shelf->getLocations()) {
+            listeners.notifyAttached(location);
+        }
+    }
+    return *this;
+}
+
+WarehouseSection::~WarehouseSection() {
+    for (const auto& shelf : shelves) {
+        shelf->removeListener(this);
+    }
+}
+
+void WarehouseSection::addListener(CapacityListener* listener) {
+    listeners.add(listener);
+}
+
+void WarehouseSection::removeListener(CapacityListener* listener) noexcept {
+    listeners.remove(listener);
+}
+
+void WarehouseSection::onLocationAttached(const std::shared_ptr<StorageLocation>& location) {
+    totalCapacity += location->getCapacity();
+    currentLoad += location->getCurrentLoad();
+    listeners.notifyAttached(location);
+}
+
+void WarehouseSection::onLocationDetached(const StorageLocation& location) {
+    totalCapacity -= location.getCapacity();
+    currentLoad -= location.getCurrentLoad();
+    listeners.notifyDetached(location);
+}
+
+void WarehouseSection::onLocationChanged(const StorageLocation& location, int loadDelta) {
+    currentLoad += loadDelta;
+    listeners.notifyChanged(location, loadDelta);
+}
+
 std::string WarehouseSection::getSectionId() const noexcept {
     return sectionId;
 }
@@ -70,7 +137,7 @@ double WarehouseSection::getHumidity() const noexcept {
     return humidity;
 }
 
-std::vector<std::shared_ptr<Shelf>> WarehouseSection::getShelves() const noexcept {
+const std::vector<std::shared_ptr<Shelf>>& WarehouseSection::getShelves() const noexcept {
     return shelves;
 }
 
@@ -86,6 +153,12 @@ void WarehouseSection::addShelf(std::shared_ptr<Shelf> shelf) {
         throw DataValidationException("Shelf " + shelf->getShelfId() + " already exists in section " + sectionId);
     }
     shelves.push_back(shelf);
+    shelf->addListener(this);
+    totalCapacity += shelf->getTotalCapacity();
+    currentLoad += shelf->getCurrentLoad();
+    for (const auto& location : shelf->getLocations()) {
+        listeners.notifyAttached(location);
+    }
 }
 
 void WarehouseSection::removeShelf(const std::string& shelfId) {
@@ -94,7 +167,14 @@ void WarehouseSection::removeShelf(const std::string& shelfId) {
             return shelf->getShelfId() == shelfId;
         });
     if (it != shelves.end()) {
+        auto shelf = *it;
         shelves.erase(it);
+        shelf->removeListener(this);
+        totalCapacity -= shelf->getTotalCapacity();
+        currentLoad -= shelf->getCurrentLoad();
+        for (const auto& location : shelf->getLocations()) {
+            listeners.notifyDetached(*location);
+        }
     }
 }
 
@@ -112,10 +192,11 @@ bool WarehouseSection::containsShelf(const std::string& shelfId) const noexcept
 
 std::vector<std::shared_ptr<StorageLocation>> WarehouseSection::findAvailableLocations() const noexcept {
     std::vector<std::shared_ptr<StorageLocation>> availableLocations;
-    for (const auto& shelf : shelves) {
-        auto shelfAvailable = shelf->getAvailableLocations();
-        availableLocations.insert(availableLocations.end(), shelfAvailable.begin(), shelfAvailable.end());
-    }
+    forEachLocation([&availableLocations](const std::shared_ptr<StorageLocation>& location) {
+        if (location->getStatus() == StorageLocation::LocationStatus::FREE) {
+            availableLocations.push_back(location);
+        }
+    });
     return availableLocations;
 }
 
@@ -131,19 +212,11 @@ std::shared_ptr<StorageLocation> WarehouseSection::findLocation(const std::strin
 }
 
 int WarehouseSection::getTotalCapacity() const noexcept {
-    int total = 0;
-    for (const auto& shelf : shelves) {
-        total += shelf->getTotalCapacity();
-    }
-    return total;
+    return totalCapacity;
 }
 
 int WarehouseSection::getCurrentLoad() const noexcept {
-    int total = 0;
-    for (const auto& shelf : shelves) {
-        total += shelf->getCurrentLoad();
-    }
-    return total;
+    return currentLoad;
 }
 
 int WarehouseSection::getAvailableSpace() const noexcept {
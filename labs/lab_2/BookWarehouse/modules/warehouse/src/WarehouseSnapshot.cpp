@@ -0,0 +1,702 @@
+#include "WarehouseSnapshot.hpp"
+#include "exceptions/WarehouseExceptions.hpp"
+#include "utils/AtomicFile.hpp"
+#include "utils/Checksum.hpp"
+#include "utils/MappedFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+// Records are written in the byte order of the machine, the endian mark rejects files of another one
+constexpr char MAGIC[8] = {'B', 'W', 'S', 'N', 'A', 'P', '\r', '\n'};
+constexpr std::uint32_t ENDIAN_MARK = 0x01020304;
+constexpr std::uint32_t NONE = UINT32_MAX;    // Index of a missing object (book without series)
+
+enum Table : std::size_t {
+    STRINGS,        // char, string data referenced by Text
+    WAREHOUSE,      // WarehouseRecord, exactly one
+    PUBLISHERS,     // PublisherRecord
+    SERIES,         // SeriesRecord
+    REVIEWS,        // ReviewRecord
+    REVIEW_REFS,    // uint32_t, indexes of REVIEWS referenced by Range of a book
+    BOOKS,          // BookRecord
+    SECTIONS,       // SectionRecord
+    SHELF_REFS,     // uint32_t, indexes of SHELVES referenced by Range of a section
+    SHELVES,        // ShelfRecord
+    LOCATION_REFS,  // uint32_t, indexes of LOCATIONS referenced by Range of a shelf
+    LOCATIONS,      // LocationRecord, also locations of items that are on no shelf
+    ITEMS,          // ItemRecord
+    TABLE_COUNT
+};
+
+struct TableEntry {
+    std::uint64_t offset;   // From the start of the file, aligned to 8
+    std::uint64_t count;    // Number of records
+};
+
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t endianMark;
+    std::uint64_t payloadSize;      // Bytes after the header
+    std::uint64_t checksum;         // Checksum of the payload
+    TableEntry tables[TABLE_COUNT];
+};
+
+struct Text {
+    std::uint32_t offset;
+    std::uint32_t length;
+};
+
+struct Range {
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+struct WarehouseRecord {
+    Text name;
+    Text address;
+};
+
+struct PublisherRecord {
+    Text name;
+    Text contactEmail;
+    std::int32_t foundationYear;
+    std::uint32_t padding;
+};
+
+struct SeriesRecord {
+    Text name;
+    Text description;
+    std::int32_t bookCount;
+    std::int32_t startYear;
+    std::int32_t endYear;
+    std::uint32_t padding;
+};
+
+struct ReviewRecord {
+    Text author;
+    Text title;
+    Text text;
+    Text date;
+    std::int32_t rating;
+    std::uint32_t padding;
+};
+
+struct BookRecord {
+    std::uint64_t isbnCode;
+    double price;
+    double averageRating;
+    Text title;
+    Text subtitle;
+    Text titleLanguage;
+    Text metadataLanguage;
+    Text description;
+    Text material;
+    Text lastSaleDate;
+    std::int32_t publicationYear;
+    std::int32_t edition;
+    std::int32_t weight;
+    std::int32_t height;
+    std::int32_t width;
+    std::int32_t thickness;
+    std::int32_t pageCount;
+    std::int32_t viewCount;
+    std::int32_t salesCount;
+    std::int32_t reviewCount;
+    std::uint32_t publisher;
+    std::uint32_t series;
+    Range reviews;
+    std::uint8_t isbnThirteen;
+    std::uint8_t coverType;
+    std::uint8_t genre;
+    std::uint8_t condition;
+    std::uint32_t padding;
+};
+
+struct SectionRecord {
+    Text sectionId;
+    Text name;
+    Text description;
+    double temperature;
+    double humidity;
+    Range shelves;
+    std::uint8_t sectionType;
+    std::uint8_t padding[7];
+};
+
+struct ShelfRecord {
+    Text shelfId;
+    Range locations;
+    std::int32_t maxLocations;
+    std::uint32_t padding;
+};
+
+struct LocationRecord {
+    Text locationId;
+    std::int32_t capacity;
+    std::int32_t currentLoad;
+    std::uint8_t status;
+    std::uint8_t padding[7];
+};
+
+struct ItemRecord {
+    std::uint32_t book;
+    std::uint32_t location;
+    std::int32_t quantity;
+    char dateAdded[10];     // YYYY-MM-DD, always 10 characters
+    char padding[2];
+};
+
+template <typename Record>
+constexpr bool isPlainRecord = std::is_trivially_copyable<Record>::value && sizeof(Record) % 8 == 0;
+
+static_assert(sizeof(Header) % 8 == 0, "payload must start aligned");
+static_assert(isPlainRecord<WarehouseRecord> && isPlainRecord<PublisherRecord> && isPlainRecord<SeriesRecord> &&
+              isPlainRecord<ReviewRecord> && isPlainRecord<BookRecord> && isPlainRecord<SectionRecord> &&
+              isPlainRecord<ShelfRecord> && isPlainRecord<LocationRecord> && isPlainRecord<ItemRecord>,
+              "records are copied to and from the file as bytes and have no implicit padding at the end");
+}
+
+/**
+ * @brief Collects the object graph into tables, deduplicating shared objects
+ *
+ */
+class WarehouseSnapshot::Writer {
+public:
+    /**
+     * @brief Add a warehouse with everything it holds, a file has at most one
+     *
+     * @param warehouse constant reference to the warehouse
+     */
+    void add(const Warehouse& warehouse) {
+        WarehouseRecord record{};
+        record.name = text(warehouse.getName());
+        record.address = text(warehouse.getAddress());
+        warehouses.push_back(record);
+        for (const auto& section : warehouse.getSections()) {
+            sections.push_back(sectionRecord(*section));
+        }
+        warehouse.forEachInventoryItem([this](const std::shared_ptr<InventoryItem>& item) {
+            ItemRecord record{};
+            record.book = add(*item->getBook());
+            record.location = locationId(item->getLocation().get());
+            record.quantity = item->getQuantity();
+            std::string date = item->getDateAdded();
+            std::memcpy(record.dateAdded, date.data(), std::min(date.size(), sizeof(record.dateAdded)));
+            items.push_back(record);
+        });
+    }
+
+    /**
+     * @brief Add a book with its publisher, series and reviews
+     *
+     * @param book constant reference to the book
+     *
+     * @return std::uint32_t containing index of the book in the file
+     */
+    std::uint32_t add(const Book& book) {
+        return intern(bookIds, books, &book, [this](const Book& value) { return bookRecord(value); });
+    }
+
+    /**
+     * @brief Build the whole file
+     *
+     * @return std::string containing header and payload
+     */
+    std::string serialize() const {
+        Header header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.endianMark = ENDIAN_MARK;
+
+        std::string image(sizeof(Header), '\0');
+        append(image, header, STRINGS, strings.data(), strings.size(), 1);
+        append(image, header, WAREHOUSE, warehouses);
+        append(image, header, PUBLISHERS, publishers);
+        append(image, header, SERIES, series);
+        append(image, header, REVIEWS, reviews);
+        append(image, header, REVIEW_REFS, reviewRefs);
+        append(image, header, BOOKS, books);
+        append(image, header, SECTIONS, sections);
+        append(image, header, SHELF_REFS, shelfRefs);
+        append(image, header, SHELVES, shelves);
+        append(image, header, LOCATION_REFS, locationRefs);
+        append(image, header, LOCATIONS, locations);
+        append(image, header, ITEMS, items);
+        image.resize(alignUp(image.size()), '\0');
+
+        header.payloadSize = image.size() - sizeof(Header);
+        header.checksum = Checksum::compute(image.data() + sizeof(Header), header.payloadSize);
+        std::memcpy(&image[0], &header, sizeof(Header));
+        return image;
+    }
+
+private:
+    std::string strings;
+    std::unordered_map<std::string, Text> texts;
+    std::vector<WarehouseRecord> warehouses;
+    std::vector<PublisherRecord> publishers;
+    std::vector<SeriesRecord> series;
+    std::vector<ReviewRecord> reviews;
+    std::vector<std::uint32_t> reviewRefs;
+    std::vector<BookRecord> books;
+    std::vector<SectionRecord> sections;
+    std::vector<std::uint32_t> shelfRefs;
+    std::vector<ShelfRecord> shelves;
+    std::vector<std::uint32_t> locationRefs;
+    std::vector<LocationRecord> locations;
+    std::vector<ItemRecord> items;
+    std::unordered_map<const Publisher*, std::uint32_t> publisherIds;
+    std::unordered_map<const BookSeries*, std::uint32_t> seriesIds;
+    std::unordered_map<const BookReview*, std::uint32_t> reviewIds;
+    std::unordered_map<const Book*, std::uint32_t> bookIds;
+    std::unordered_map<const Shelf*, std::uint32_t> shelfIds;
+    std::unordered_map<const StorageLocation*, std::uint32_t> locationIds;
+
+    static std::size_t alignUp(std::size_t size) noexcept {
+        return (size + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    static void append(std::string& image, Header& header, Table table, const void* data, std::size_t count, std::size_t recordSize) {
+        image.resize(alignUp(image.size()), '\0');
+        header.tables[table] = TableEntry{image.size(), count};
+        image.append(static_cast<const char*>(data), count * recordSize);
+    }
+
+    template <typename Record>
+    static void append(std::string& image, Header& header, Table table, const std::vector<Record>& records) {
+        append(image, header, table, records.data(), records.size(), sizeof(Record));
+    }
+
+    // Index of an object in its table, the record is made on first use
+    template <typename Object, typename Record, typename MakeRecord>
+    static std::uint32_t intern(std::unordered_map<const Object*, std::uint32_t>& ids, std::vector<Record>& records,
+                                const Object* object, MakeRecord makeRecord) {
+        auto found = ids.find(object);
+        if (found != ids.end()) {
+            return found->second;
+        }
+        Record record = makeRecord(*object); // may add records of other tables
+        if (records.size() >= NONE) {
+            throw WarehouseException("Warehouse is too large for a snapshot");
+        }
+        std::uint32_t id = static_cast<std::uint32_t>(records.size());
+        records.push_back(record);
+        ids.emplace(object, id);
+        return id;
+    }
+
+    Text text(const std::string& value) {
+        auto found = texts.find(value);
+        if (found != texts.end()) {
+            return found->second;
+        }
+        if (strings.size() + value.size() >= NONE) {
+            throw WarehouseException("Warehouse is too large for a snapshot");
+        }
+        Text result{static_cast<std::uint32_t>(strings.size()), static_cast<std::uint32_t>(value.size())};
+        strings += value;
+        texts.emplace(value, result);
+        return result;
+    }
+
+    static Range appendRefs(std::vector<std::uint32_t>& refs, const std::vector<std::uint32_t>& ids) {
+        Range range{static_cast<std::uint32_t>(refs.size()), static_cast<std::uint32_t>(ids.size())};
+        refs.insert(refs.end(), ids.begin(), ids.end());
+        return range;
+    }
+
+    std::uint32_t locationId(const StorageLocation* location) {
+        return intern(locationIds, locations, location, [this](const StorageLocation& value) {
+            LocationRecord record{};
+            record.locationId = text(value.getLocationId());
+            record.capacity = value.getCapacity();
+            record.currentLoad = value.getCurrentLoad();
+            record.status = static_cast<std::uint8_t>(value.getStatus());
+            return record;
+        });
+    }
+
+    SectionRecord sectionRecord(const WarehouseSection& section) {
+        std::vector<std::uint32_t> ids;
+        for (const auto& shelf : section.getShelves()) {
+            ids.push_back(intern(shelfIds, shelves, shelf.get(), [this](const Shelf& value) {
+                std::vector<std::uint32_t> locationIndexes;
+                for (const auto& location : value.getLocations()) {
+                    locationIndexes.push_back(locationId(location.get()));
+                }
+                ShelfRecord record{};
+                record.shelfId = text(value.getShelfId());
+                record.maxLocations = value.getMaxLocations();
+                record.locations = appendRefs(locationRefs, locationIndexes);
+                return record;
+            }));
+        }
+        SectionRecord record{};
+        record.sectionId = text(section.getSectionId());
+        record.name = text(section.getName());
+        record.description = text(section.getDescription());
+        record.temperature = section.getTemperature();
+        record.humidity = section.getHumidity();
+        record.sectionType = static_cast<std::uint8_t>(section.getSectionType());
+        record.shelves = appendRefs(shelfRefs, ids);
+        return record;
+    }
+
+    BookRecord bookRecord(const Book& book) {
+        BookRecord record{};
+        ISBN isbn = book.getISBN();
+        record.isbnCode = isbn.getPackedCode();
+        record.isbnThirteen = isbn.thirteen ? 1 : 0;
+        record.price = book.getPrice();
+
+        BookTitle title = book.getTitle();
+        record.title = text(title.getTitle());
+        record.subtitle = text(title.getSubtitle());
+        record.titleLanguage = text(title.getLanguage());
+
+        BookMetadata metadata = book.getMetadata();
+        record.publicationYear = metadata.getPublicationYear();
+        record.metadataLanguage = text(metadata.getLanguage());
+        record.edition = metadata.getEdition();
+        record.description = text(metadata.getDescription());
+
+        PhysicalProperties properties = book.getPhysicalProperties();
+        record.weight = properties.getWeight();
+        record.height = properties.getHeight();
+        record.width = properties.getWidth();
+        record.thickness = properties.getThickness();
+        record.pageCount = properties.getPageCount();
+        record.coverType = static_cast<std::uint8_t>(properties.getCoverType());
+        record.material = text(properties.getMaterial());
+
+        record.genre = static_cast<std::uint8_t>(book.getGenre().getGenre());
+        record.condition = static_cast<std::uint8_t>(book.getCondition().getCondition());
+
+        BookStatistics statistics = book.getStatistics();
+        record.viewCount = statistics.getViewCount();
+        record.salesCount = statistics.getSalesCount();
+        record.averageRating = statistics.getAverageRating();
+        record.reviewCount = statistics.getReviewCount();
+        record.lastSaleDate = text(statistics.getLastSaleDate());
+
+        record.publisher = intern(publisherIds, publishers, book.getPublisher().get(), [this](const Publisher& publisher) {
+            PublisherRecord value{};
+            value.name = text(publisher.getName());
+            value.contactEmail = text(publisher.getContactEmail());
+            value.foundationYear = publisher.getFoundationYear();
+            return value;
+        });
+        auto bookSeries = book.getSeries();
+        record.series = !bookSeries ? NONE : intern(seriesIds, series, bookSeries.get(), [this](const BookSeries& value) {
+            SeriesRecord seriesRecord{};
+            seriesRecord.name = text(value.getName());
+            seriesRecord.description = text(value.getDescription());
+            seriesRecord.bookCount = value.getBookCount();
+            seriesRecord.startYear = value.getStartYear();
+            seriesRecord.endYear = value.getEndYear();
+            return seriesRecord;
+        });
+        std::vector<std::uint32_t> ids;
+        for (const auto& review : book.getReviews()) {
+            ids.push_back(intern(reviewIds, reviews, review.get(), [this](const BookReview& value) {
+                ReviewRecord reviewRecord{};
+                reviewRecord.author = text(value.getAuthor());
+                reviewRecord.title = text(value.getTitle());
+                reviewRecord.text = text(value.getText());
+                reviewRecord.date = text(value.getDate());
+                reviewRecord.rating = value.getRating();
+                return reviewRecord;
+            }));
+        }
+        record.reviews = appendRefs(reviewRefs, ids);
+        return record;
+    }
+};
+
+/**
+ * @brief Rebuilds the object graph from the tables of a mapped file
+ *
+ */
+class WarehouseSnapshot::Reader {
+public:
+    Reader(std::string_view image, const std::string& path) : image(image), path(path) {
+        if (reinterpret_cast<std::uintptr_t>(image.data()) % alignof(Header) != 0) {
+            throw WarehouseException("Warehouse snapshot is not aligned in memory: " + path);
+        }
+        if (image.size() < sizeof(Header)) {
+            damaged();
+        }
+        std::memcpy(&header, image.data(), sizeof(Header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+            throw WarehouseException("Not a warehouse snapshot: " + path);
+        }
+        if (header.version != VERSION || header.endianMark != ENDIAN_MARK) {
+            throw WarehouseException("Unsupported warehouse snapshot version " + std::to_string(header.version) + ": " + path);
+        }
+        if (header.payloadSize != image.size() - sizeof(Header) ||
+            Checksum::compute(image.data() + sizeof(Header), header.payloadSize) != header.checksum) {
+            damaged();
+        }
+        strings = rows<char>(STRINGS);
+    }
+
+    /**
+     * @brief Get the checksum of the file, it identifies the saved state
+     *
+     * @return std::uint64_t containing checksum of the payload
+     */
+    std::uint64_t getChecksum() const noexcept {
+        return header.checksum;
+    }
+
+    /**
+     * @brief Restore all books of the file with their publishers, series and reviews
+     *
+     * @return std::vector<std::shared_ptr<Book>> containing books in file order
+     */
+    std::vector<std::shared_ptr<Book>> restoreBooks() const {
+        auto publishers = restoreAll<Publisher, PublisherRecord>(PUBLISHERS, [this](const PublisherRecord& record) {
+            return std::make_shared<Publisher>(text(record.name), text(record.contactEmail), record.foundationYear);
+        });
+        auto series = restoreAll<BookSeries, SeriesRecord>(SERIES, [this](const SeriesRecord& record) {
+            return std::make_shared<BookSeries>(text(record.name), text(record.description),
+                                                record.bookCount, record.startYear, record.endYear);
+        });
+        auto reviews = restoreAll<BookReview, ReviewRecord>(REVIEWS, [this](const ReviewRecord& record) {
+            return std::make_shared<BookReview>(text(record.author), text(record.title), text(record.text),
+                                                record.rating, text(record.date));
+        });
+        Rows<std::uint32_t> reviewRefs = rows<std::uint32_t>(REVIEW_REFS);
+        auto books = restoreAll<Book, BookRecord>(BOOKS, [&](const BookRecord& record) {
+            auto book = std::make_shared<Book>(
+                ISBN(record.isbnCode, record.isbnThirteen != 0),
+                BookTitle(text(record.title), text(record.subtitle), text(record.titleLanguage)),
+                BookMetadata(record.publicationYear, text(record.metadataLanguage), record.edition, text(record.description)),
+                PhysicalProperties(record.weight, record.height, record.width, record.thickness, record.pageCount,
+                                   static_cast<PhysicalProperties::CoverType>(record.coverType), text(record.material)),
+                Genre(static_cast<Genre::Type>(record.genre)),
+                at(publishers, record.publisher),
+                BookCondition(static_cast<BookCondition::Condition>(record.condition)),
+                record.price,
+                record.series == NONE ? nullptr : at(series, record.series));
+            // Reviews and statistics are restored as they were, not recomputed by addReview
+            for (std::uint32_t id : refs(reviewRefs, record.reviews)) {
+                book->reviews.push_back(at(reviews, id));
+            }
+            book->statistics = BookStatistics(record.viewCount, record.salesCount, record.averageRating,
+                                              record.reviewCount, text(record.lastSaleDate));
+            return book;
+        });
+        return books;
+    }
+
+    /**
+     * @brief Restore the warehouse of the file
+     *
+     * @return std::shared_ptr<Warehouse> containing restored warehouse
+     */
+    std::shared_ptr<Warehouse> restore() const {
+        std::vector<std::shared_ptr<Book>> books = restoreBooks();
+        auto locations = restoreAll<StorageLocation, LocationRecord>(LOCATIONS, [this](const LocationRecord& record) {
+            return std::make_shared<StorageLocation>(text(record.locationId), record.capacity, record.currentLoad,
+                                                     static_cast<StorageLocation::LocationStatus>(record.status));
+        });
+        Rows<std::uint32_t> locationRefs = rows<std::uint32_t>(LOCATION_REFS);
+        auto shelves = restoreAll<Shelf, ShelfRecord>(SHELVES, [&](const ShelfRecord& record) {
+            auto shelf = std::make_shared<Shelf>(text(record.shelfId), record.maxLocations);
+            Rows<std::uint32_t> ids = refs(locationRefs, record.locations);
+            shelf->locations.reserve(ids.size());
+            for (std::uint32_t id : ids) {
+                const auto& location = at(locations, id);
+                shelf->locations.push_back(location);
+                location->addListener(shelf.get());
+                shelf->totalCapacity += location->getCapacity();
+                shelf->currentLoad += location->getCurrentLoad();
+            }
+            return shelf;
+        });
+        Rows<std::uint32_t> shelfRefs = rows<std::uint32_t>(SHELF_REFS);
+        auto sections = restoreAll<WarehouseSection, SectionRecord>(SECTIONS, [&](const SectionRecord& record) {
+            auto section = std::make_shared<WarehouseSection>(text(record.sectionId), text(record.name), text(record.description),
+                                                              static_cast<WarehouseSection::SectionType>(record.sectionType),
+                                                              record.temperature, record.humidity);
+            Rows<std::uint32_t> ids = refs(shelfRefs, record.shelves);
+            section->shelves.reserve(ids.size());
+            for (std::uint32_t id : ids) {
+                const auto& shelf = at(shelves, id);
+                section->shelves.push_back(shelf);
+                shelf->addListener(section.get());
+                section->totalCapacity += shelf->getTotalCapacity();
+                section->currentLoad += shelf->getCurrentLoad();
+            }
+            return section;
+        });
+
+        Rows<WarehouseRecord> warehouseRows = rows<WarehouseRecord>(WAREHOUSE);
+        if (warehouseRows.size() != 1) {
+            damaged();
+        }
+        auto warehouse = std::make_shared<Warehouse>(text(warehouseRows.begin()->name), text(warehouseRows.begin()->address));
+        warehouse->sections.reserve(sections.size());
+        for (const auto& section : sections) {
+            warehouse->attachSection(section);
+        }
+
+        // Items are grouped by book with a counting sort, so the inventory of each book is built
+        // in one go instead of visiting all books for every item; the inventory keeps file order.
+        // Loads of the locations already include the items, they are indexed without addBooks.
+        Rows<ItemRecord> items = rows<ItemRecord>(ITEMS);
+        std::vector<std::size_t> firstOfBook(books.size() + 1, 0);
+        for (const ItemRecord& record : items) {
+            if (record.book >= books.size()) {
+                damaged();
+            }
+            ++firstOfBook[record.book + 1];
+        }
+        for (std::size_t book = 0; book < books.size(); ++book) {
+            firstOfBook[book + 1] += firstOfBook[book];
+        }
+        std::vector<std::size_t> byBook(items.size());
+        std::vector<std::size_t> next(firstOfBook.begin(), firstOfBook.end() - 1);
+        for (std::size_t position = 0; position < items.size(); ++position) {
+            byBook[next[items.begin()[position].book]++] = position;
+        }
+
+        auto& inventory = warehouse->inventory;
+        inventory.resize(items.size());
+        warehouse->stockByIsbn.reserve(books.size());
+        for (std::size_t book = 0; book < books.size(); ++book) {
+            std::size_t count = firstOfBook[book + 1] - firstOfBook[book];
+            if (count == 0) {
+                continue;
+            }
+            auto& stock = warehouse->stockByIsbn[books[book]->isbn];
+            stock.items.reserve(count);
+            stock.itemsByLocation.reserve(count);
+            for (std::size_t i = firstOfBook[book]; i < firstOfBook[book + 1]; ++i) {
+                const ItemRecord& record = items.begin()[byBook[i]];
+                const auto& location = at(locations, record.location);
+                auto item = std::make_shared<InventoryItem>(books[book], record.quantity, location,
+                                                            std::string(record.dateAdded, sizeof(record.dateAdded)));
+                stock.itemsByLocation.emplace(location->getLocationId(), item);
+                stock.items.push_back(item);
+                stock.totalQuantity += record.quantity;
+                inventory[byBook[i]] = std::move(item);
+            }
+        }
+        warehouse->inventoryPositions.reserve(inventory.size());
+        for (std::size_t position = 0; position < inventory.size(); ++position) {
+            warehouse->inventoryPositions.emplace(inventory[position].get(), position);
+        }
+        return warehouse;
+    }
+
+private:
+    template <typename Record>
+    class Rows {
+    public:
+        Rows() = default;
+        Rows(const Record* first, std::size_t count) : first(first), count(count) {}
+        const Record* begin() const noexcept { return first; }
+        const Record* end() const noexcept { return first + count; }
+        std::size_t size() const noexcept { return count; }
+
+    private:
+        const Record* first = nullptr;
+        std::size_t count = 0;
+    };
+
+    std::string_view image;
+    std::string path;
+    Header header;
+    Rows<char> strings;
+
+    [[noreturn]] void damaged() const {
+        throw WarehouseException("Warehouse snapshot is damaged: " + path);
+    }
+
+    // Records are read in place: the mapping is page aligned and tables are aligned to 8
+    template <typename Record>
+    Rows<Record> rows(Table table) const {
+        const TableEntry& entry = header.tables[table];
+        if (entry.offset < sizeof(Header) || entry.offset > image.size() || entry.offset % alignof(Record) != 0 ||
+            entry.count > (image.size() - entry.offset) / sizeof(Record)) {
+            damaged();
+        }
+        return Rows<Record>(reinterpret_cast<const Record*>(image.data() + entry.offset), entry.count);
+    }
+
+    Rows<std::uint32_t> refs(const Rows<std::uint32_t>& table, Range range) const {
+        if (static_cast<std::size_t>(range.first) + range.count > table.size()) {
+            damaged();
+        }
+        return Rows<std::uint32_t>(table.begin() + range.first, range.count);
+    }
+
+    std::string text(Text value) const {
+        if (static_cast<std::size_t>(value.offset) + value.length > strings.size()) {
+            damaged();
+        }
+        return std::string(strings.begin() + value.offset, value.length);
+    }
+
+    template <typename Object>
+    const std::shared_ptr<Object>& at(const std::vector<std::shared_ptr<Object>>& objects, std::uint32_t id) const {
+        if (id >= objects.size()) {
+            damaged();
+        }
+        return objects[id];
+    }
+
+    template <typename Object, typename Record, typename Restore>
+    std::vector<std::shared_ptr<Object>> restoreAll(Table table, Restore restoreOne) const {
+        Rows<Record> records = rows<Record>(table);
+        std::vector<std::shared_ptr<Object>> objects;
+        objects.reserve(records.size());
+        for (const Record& record : records) {
+            objects.push_back(restoreOne(record));
+        }
+        return objects;
+    }
+};
+
+std::uint64_t WarehouseSnapshot::save(const Warehouse& warehouse, const std::string& path) {
+    Writer writer;
+    writer.add(warehouse);
+    std::string image = writer.serialize();
+    AtomicFile::write(path, image);
+    Header header;
+    std::memcpy(&header, image.data(), sizeof(Header));
+    return header.checksum;
+}
+
+std::shared_ptr<Warehouse> WarehouseSnapshot::load(const std::string& path) {
+    MappedFile file(path);
+    return Reader(file.text(), path).restore();
+}
+
+std::uint64_t WarehouseSnapshot::getChecksum(const std::string& path) {
+    MappedFile file(path);
+    return Reader(file.text(), path).getChecksum();
+}
+
+std::string WarehouseSnapshot::saveBooks(const std::vector<std::shared_ptr<Book>>& books) {
+    Writer writer;
+    for (const auto& book : books) {
+        if (!book) {
+            throw DataValidationException("Cannot save null book");
+        }
+        writer.add(*book);
+    }
+    return writer.serialize();
+}
+
+std::vector<std::shared_ptr<Book>> WarehouseSnapshot::loadBooks(std::string_view image, const std::string& source) {
+    return Reader(image, source).restoreBooks();
+}
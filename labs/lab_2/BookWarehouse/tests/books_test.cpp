@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
 #include <memory>
+#include <string_view>
+#include <vector>
 #include "Book.hpp"
 #include "BookCollection.hpp"
+#include "CatalogueImporter.hpp"
+#include "config/BookConfig.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
 
 TEST(ISBNTest, ValidISBN13) {
@@ -49,6 +55,40 @@ TEST(ISBNTest, EdgeCases) {
     EXPECT_NO_THROW(ISBN isbn("012000030x"));
 }
 
+TEST(ISBNTest, PackedCodeConvertsIsbn10) {
+    ISBN isbn10("0-306-40615-2");
+    ISBN isbn13("978-0-306-40615-7");
+    EXPECT_EQ(isbn10.getPackedCode(), 9780306406157ULL);
+    EXPECT_EQ(isbn10, isbn13);
+    EXPECT_EQ(isbn10.getHash(), isbn13.getHash());
+    EXPECT_EQ(std::hash<ISBN>()(isbn10), isbn13.getHash());
+    EXPECT_EQ(isbn10.getCode(), "0306406152");
+    EXPECT_EQ(ISBN("012000030X").getCode(), "012000030X");
+    EXPECT_EQ(ISBN::fromPacked(9783161484100ULL).getCode(), "9783161484100");
+    EXPECT_THROW(ISBN::fromPacked(9783161484101ULL), InvalidISBNException);
+}
+
+TEST(ISBNTest, PackMatchesConstructor) {
+    std::vector<std::string> codes = {"978-3-16-148410-0", "0306406152", "012000030x", "invalid", "123",
+                                      "978-3-16-148410-1", "0306406153", "978316148410X", "01200X0300",
+                                      "97831614841000", "0000000000000", ""};
+    std::vector<std::string_view> views;
+    for (int copy = 0; copy < 40; copy++) { // more than one block of packAll
+        views.insert(views.end(), codes.begin(), codes.end());
+    }
+    std::vector<std::uint64_t> packed = ISBN::packAll(views);
+    ASSERT_EQ(packed.size(), views.size());
+    for (std::size_t i = 0; i < views.size(); i++) {
+        std::uint64_t expected = ISBN::INVALID_CODE;
+        try {
+            expected = ISBN(std::string(views[i])).getPackedCode();
+        } catch (const InvalidISBNException&) {
+        }
+        EXPECT_EQ(ISBN::pack(views[i]), expected) << views[i];
+        EXPECT_EQ(packed[i], expected) << views[i];
+    }
+}
+
 TEST(BookTitleTest, ValidTitle) {
     EXPECT_NO_THROW(BookTitle title("The Great Gatsby", "A Novel", "EN"));
     BookTitle title("Test", "", "RU");
@@ -967,4 +1007,82 @@ TEST(PerformanceTest, LargeCollection) {
     }
     EXPECT_EQ(collection.getBookCount(), 50);
     EXPECT_FALSE(collection.isEmpty());
-}
\ No newline at end of file
+}
+
+TEST(CatalogueImporterTest, ImportsCsvAndJsonLinesWithRowErrors) {
+    std::string catalogue =
+        "isbn,title,subtitle,language,year,edition,genre,condition,price,publisher,publisherEmail,publisherYear,series\n"
+        "978-3-16-148410-0,Dune,,EN,1965,1,SCIENCE_FICTION,new,9.5,Chilton,info@chilton.com,1904,Dune Chronicles\n"
+        "0306406152,\"Children of Dune, part \"\"1\"\"\",,EN,1976,,,,,Chilton,info@chilton.com,1904,Dune Chronicles\n"
+        "\n"
+        "# comment\n"
+        "0306406153,Bad check digit,,EN,1976,,,,,Chilton,info@chilton.com,1904\n"
+        "{\"isbn\": \"012000030X\", \"title\": \"Caf\\u00e9\", \"language\": \"FR\", \"year\": 2001, \"price\": 12.25,"
+        " \"publisher\": \"Gallimard\", \"publisherYear\": 1911, \"extra\": null}\r\n"
+        "{\"isbn\": \"9780306406157\", \"title\": \"Same book as line 3\", \"language\": \"EN\", \"year\": 1976,"
+        " \"publisher\": \"Chilton\", \"publisherEmail\": \"info@chilton.com\", \"publisherYear\": 1904}\n"
+        "9783161484100,No year,,EN,,,,,,Chilton,,1904\n"
+        "{\"isbn\": \"9783161484100\", \"title\": \"Broken\"\n"
+        "9783161484100,Unknown genre,,EN,1965,,SPACE_OPERA,,,Chilton,,1904";
+    CatalogueImporter importer(4);
+    CatalogueImporter::Result result = importer.importText(catalogue);
+
+    ASSERT_EQ(result.books.size(), 3u);
+    EXPECT_EQ(result.books[0]->getTitle().getTitle(), "Dune");
+    EXPECT_EQ(result.books[0]->getPrice(), 9.5);
+    EXPECT_EQ(result.books[1]->getTitle().getTitle(), "Children of Dune, part \"1\"");
+    EXPECT_EQ(result.books[2]->getTitle().getTitle(), "Caf\xC3\xA9");
+    EXPECT_EQ(result.books[2]->getISBN().getCode(), "012000030X");
+    EXPECT_EQ(result.books[0]->getPublisher(), result.books[1]->getPublisher());
+    EXPECT_EQ(result.books[0]->getSeries(), result.books[1]->getSeries());
+    EXPECT_EQ(result.books[2]->getSeries(), nullptr);
+    EXPECT_EQ(importer.getPublisherCount(), 2u);
+    EXPECT_EQ(importer.getSeriesCount(), 1u);
+
+    std::vector<std::size_t> errorLines;
+    for (const auto& error : result.errors) {
+        errorLines.push_back(error.line);
+    }
+    EXPECT_EQ(errorLines, (std::vector<std::size_t>{6, 8, 9, 10, 11}));
+    EXPECT_NE(result.errors[1].message.find("Duplicate ISBN"), std::string::npos);
+    EXPECT_NE(result.errors[2].message.find("Missing year"), std::string::npos);
+}
+
+TEST(CatalogueImporterTest, ParallelFileImportKeepsOrderAndSharesPublishers) {
+    auto isbnOf = [](long long number) { // valid ISBN-13 with the number in the middle
+        std::string digits = "978" + std::to_string(100000000 + number);
+        int sum = 0;
+        for (int i = 0; i < 12; i++) {
+            sum += (digits[i] - '0') * (i % 2 == 0 ? 1 : 3);
+        }
+        return digits + std::to_string((10 - sum % 10) % 10);
+    };
+    std::string catalogue;
+    const int rows = 40000; // several chunks of BookConfig::CatalogueImporter::MIN_CHUNK_SIZE
+    for (int row = 0; row < rows; row++) {
+        catalogue += isbnOf(row) + ",Title " + std::to_string(row) + ",,EN,2000,,,,,Publisher " +
+                     std::to_string(row % 7) + ",,1990,,120,200,130,15,300,PAPERBACK,Paper\n";
+        if (row % 1000 == 0) {
+            catalogue += "not a book\n";
+        }
+    }
+    ASSERT_GT(catalogue.size(), 2 * BookConfig::CatalogueImporter::MIN_CHUNK_SIZE);
+    std::string path = testing::TempDir() + "catalogue_import_test.csv";
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << catalogue;
+    }
+    CatalogueImporter importer(4);
+    CatalogueImporter::Result result = importer.importFile(path);
+    std::remove(path.c_str());
+
+    ASSERT_EQ(result.books.size(), static_cast<std::size_t>(rows));
+    for (int row = 0; row < rows; row += 997) {
+        EXPECT_EQ(result.books[row]->getISBN().getCode(), isbnOf(row));
+    }
+    EXPECT_EQ(result.errors.size(), static_cast<std::size_t>(rows / 1000));
+    EXPECT_EQ(result.errors[1].line, 1003u);
+    EXPECT_EQ(importer.getPublisherCount(), 7u);
+    EXPECT_EQ(result.books[0]->getPublisher(), result.books[7 * 5000]->getPublisher());
+    EXPECT_THROW(importer.importFile(path), WarehouseException);
+}
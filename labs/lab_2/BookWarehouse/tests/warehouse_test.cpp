@@ -1,9 +1,16 @@
 #include <gtest/gtest.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <memory>
+#include <string>
 #include "Delivery.hpp"
 #include "InventoryItem.hpp"
 #include "InventoryReport.hpp"
+#include "LocationIndex.hpp"
 #include "Shelf.hpp"
+#include "StockJournal.hpp"
 #include "StockMovement.hpp"
 #include "StockReceipt.hpp"
 #include "StockTransfer.hpp"
@@ -12,8 +19,10 @@
 #include "Warehouse.hpp"
 #include "WarehouseManager.hpp"
 #include "WarehouseSection.hpp"
+#include "WarehouseSnapshot.hpp"
 #include "Book.hpp"
 #include "exceptions/WarehouseExceptions.hpp"
+#include "utils/IdValidation.hpp"
 
 TEST(DeliveryTest, ConstructorValidData) {
     EXPECT_NO_THROW(Delivery delivery("DEL-2025-001", "Supplier A", "2024-12-31", "TRK123", "Carrier X", 100.0));
@@ -367,6 +376,258 @@ TEST(WarehouseTest, CapacityCalculations) {
     EXPECT_FALSE(warehouse.isFull());
 }
 
+TEST(WarehouseTest, InventoryIndexMultipleLocations) {
+    Warehouse warehouse("Test", "Address");
+    auto section = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto shelf = std::make_shared<Shelf>("A-01", 3);
+    auto loc1 = std::make_shared<StorageLocation>("A-01-B-01", 100);
+    auto loc2 = std::make_shared<StorageLocation>("A-01-B-02", 100);
+    shelf->addLocation(loc1); shelf->addLocation(loc2);
+    section->addShelf(shelf);
+    warehouse.addSection(section);
+    auto book = std::make_shared<Book>(
+        ISBN("9783161484100"), BookTitle("Test Book", "", "EN"), BookMetadata(2024, "EN", 1, ""),
+        PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::SCIENCE_FICTION), std::make_shared<Publisher>("Pub", "test@pub.com", 2000),
+        BookCondition(BookCondition::Condition::NEW), 19.99
+    );
+    auto item1 = std::make_shared<InventoryItem>(book, 10, loc1, "2024-01-15");
+    auto item2 = std::make_shared<InventoryItem>(book, 5, loc2, "2024-01-15");
+    warehouse.addInventoryItem(item1);
+    warehouse.addInventoryItem(item2);
+    EXPECT_EQ(warehouse.findInventoryItem("9783161484100", "A-01-B-01"), item1);
+    EXPECT_EQ(warehouse.findInventoryItem("9783161484100", "A-01-B-02"), item2);
+    EXPECT_EQ(warehouse.findInventoryItem("9783161484100", "A-01-B-03"), nullptr);
+    EXPECT_EQ(warehouse.findInventoryByBook("9783161484100").size(), 2);
+    EXPECT_EQ(warehouse.getBookTotalQuantity("9783161484100"), 15);
+    auto duplicate = std::make_shared<InventoryItem>(book, 3, loc1, "2024-01-16");
+    EXPECT_THROW(warehouse.addInventoryItem(duplicate), DataValidationException);
+    EXPECT_EQ(warehouse.getBookTotalQuantity("9783161484100"), 15);
+    warehouse.removeInventoryItem("9783161484100", "A-01-B-01");
+    EXPECT_EQ(warehouse.findInventoryItem("9783161484100", "A-01-B-01"), nullptr);
+    EXPECT_EQ(warehouse.findInventoryItem("9783161484100", "A-01-B-02"), item2);
+    EXPECT_EQ(warehouse.getBookTotalQuantity("9783161484100"), 5);
+}
+
+TEST(WarehouseTest, CleanupRecomputesCachedTotals) {
+    Warehouse warehouse("Test", "Address");
+    auto section = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto shelf = std::make_shared<Shelf>("A-01", 2);
+    auto location = std::make_shared<StorageLocation>("A-01-B-01", 100);
+    shelf->addLocation(location);
+    section->addShelf(shelf);
+    warehouse.addSection(section);
+    auto book = std::make_shared<Book>(
+        ISBN("9783161484100"), BookTitle("Test Book", "", "EN"), BookMetadata(2024, "EN", 1, ""),
+        PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::SCIENCE_FICTION), std::make_shared<Publisher>("Pub", "test@pub.com", 2000),
+        BookCondition(BookCondition::Condition::NEW), 19.99
+    );
+    auto item = std::make_shared<InventoryItem>(book, 10, location, "2024-01-15");
+    warehouse.addInventoryItem(item);
+    item->setQuantity(7);
+    warehouse.cleanupZeroQuantityItems();
+    EXPECT_EQ(warehouse.getBookTotalQuantity("9783161484100"), 7);
+    item->setQuantity(0);
+    warehouse.cleanupZeroQuantityItems();
+    EXPECT_EQ(warehouse.getBookTotalQuantity("9783161484100"), 0);
+    EXPECT_TRUE(warehouse.findInventoryByBook("9783161484100").empty());
+    EXPECT_EQ(warehouse.findInventoryItem("9783161484100", "A-01-B-01"), nullptr);
+}
+
+TEST(WarehouseTest, TransferOntoHeldLocationMergesItems) {
+    auto warehouse = std::make_shared<Warehouse>("Test", "Address");
+    auto section = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto shelf = std::make_shared<Shelf>("A-01", 2);
+    auto source = std::make_shared<StorageLocation>("A-01-B-01", 100);
+    auto dest = std::make_shared<StorageLocation>("A-01-B-02", 100);
+    shelf->addLocation(source); shelf->addLocation(dest);
+    section->addShelf(shelf);
+    warehouse->addSection(section);
+    auto book = std::make_shared<Book>(
+        ISBN("9783161484100"), BookTitle("Test Book", "", "EN"), BookMetadata(2024, "EN", 1, ""),
+        PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::SCIENCE_FICTION), std::make_shared<Publisher>("Pub", "test@pub.com", 2000),
+        BookCondition(BookCondition::Condition::NEW), 19.99
+    );
+    auto held = std::make_shared<InventoryItem>(book, 20, dest, "2024-01-15");
+    auto moved = std::make_shared<InventoryItem>(book, 30, source, "2024-01-15");
+    warehouse->addInventoryItem(held);
+    warehouse->addInventoryItem(moved);
+    auto transfer = std::make_shared<StockTransfer>("TRF-2024-001", "2024-01-15", "EMP-001", warehouse,
+                                                    source, dest, "Test");
+    transfer->addAffectedItem(moved);
+    warehouse->processStockMovement(transfer);
+    EXPECT_EQ(warehouse->findInventoryItem("9783161484100", "A-01-B-02"), held);
+    EXPECT_EQ(held->getQuantity(), 50);
+    EXPECT_EQ(warehouse->findInventoryItem("9783161484100", "A-01-B-01"), nullptr);
+    EXPECT_EQ(warehouse->findInventoryByBook("9783161484100").size(), 1);
+    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 50);
+    int inventorySize = 0;
+    warehouse->forEachInventoryItem([&inventorySize](const std::shared_ptr<InventoryItem>&) { inventorySize++; });
+    EXPECT_EQ(inventorySize, 1);
+    EXPECT_EQ(dest->getCurrentLoad(), 50);
+    EXPECT_EQ(source->getCurrentLoad(), 0);
+}
+
+TEST(WarehouseTest, OptimalLocationFollowsLocationChanges) {
+    Warehouse warehouse("Test", "Address");
+    auto general = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto bulk = std::make_shared<WarehouseSection>("B", "Bulk", "", WarehouseSection::SectionType::BULK);
+    auto shelfA = std::make_shared<Shelf>("A-01", 3);
+    auto shelfB = std::make_shared<Shelf>("B-01", 1);
+    auto small = std::make_shared<StorageLocation>("A-01-B-01", 50);
+    auto medium = std::make_shared<StorageLocation>("A-01-B-02", 100);
+    auto large = std::make_shared<StorageLocation>("B-01-B-01", 500);
+    shelfA->addLocation(small); shelfA->addLocation(medium);
+    shelfB->addLocation(large);
+    general->addShelf(shelfA); bulk->addShelf(shelfB);
+    warehouse.addSection(general); warehouse.addSection(bulk);
+    EXPECT_EQ(warehouse.findOptimalLocation(40), small);
+    EXPECT_EQ(warehouse.findOptimalLocation(80), medium);
+    EXPECT_EQ(warehouse.findOptimalLocation(200), large);
+    EXPECT_EQ(warehouse.findOptimalLocation(40, WarehouseSection::SectionType::BULK), large);
+    EXPECT_EQ(warehouse.findOptimalLocation(600), nullptr);
+    EXPECT_EQ(warehouse.findOptimalLocation(-1), nullptr);
+    small->addBooks(10);
+    EXPECT_EQ(warehouse.findOptimalLocation(40), medium);
+    small->removeBooks(10);
+    EXPECT_EQ(warehouse.findOptimalLocation(40), small);
+    small->setStatus(StorageLocation::LocationStatus::BLOCKED);
+    EXPECT_EQ(warehouse.findOptimalLocation(40), medium);
+    auto added = std::make_shared<StorageLocation>("A-01-B-03", 300);
+    shelfA->addLocation(added);
+    EXPECT_EQ(warehouse.findOptimalLocation(200), added);
+    shelfA->removeLocation("A-01-B-03");
+    EXPECT_EQ(warehouse.findOptimalLocation(200), large);
+    Warehouse copy(warehouse);
+    medium->addBooks(1);
+    EXPECT_EQ(copy.findOptimalLocation(40), large);
+    warehouse.removeSection("B");
+    EXPECT_EQ(warehouse.findOptimalLocation(200), nullptr);
+    EXPECT_EQ(copy.findOptimalLocation(200), large);
+}
+
+TEST(WarehouseTest, CapacityTotalsFollowChanges) {
+    Warehouse warehouse("Test", "Address");
+    auto section = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto shelf1 = std::make_shared<Shelf>("A-01", 2);
+    auto shelf2 = std::make_shared<Shelf>("A-02", 2);
+    auto loc1 = std::make_shared<StorageLocation>("A-01-B-01", 100, 20);
+    auto loc2 = std::make_shared<StorageLocation>("A-02-B-01", 200);
+    shelf1->addLocation(loc1);
+    section->addShelf(shelf1);
+    warehouse.addSection(section);
+    EXPECT_EQ(warehouse.getTotalCapacity(), 100);
+    EXPECT_EQ(warehouse.getCurrentLoad(), 20);
+    loc1->addBooks(30);
+    EXPECT_EQ(shelf1->getCurrentLoad(), 50);
+    EXPECT_EQ(section->getCurrentLoad(), 50);
+    EXPECT_EQ(warehouse.getCurrentLoad(), 50);
+    shelf2->addLocation(loc2);
+    loc2->addBooks(50);
+    section->addShelf(shelf2);
+    EXPECT_EQ(section->getTotalCapacity(), 300);
+    EXPECT_EQ(warehouse.getTotalCapacity(), 300);
+    EXPECT_EQ(warehouse.getCurrentLoad(), 100);
+    EXPECT_EQ(warehouse.getAvailableSpace(), 200);
+    loc2->removeBooks(50);
+    EXPECT_EQ(warehouse.getCurrentLoad(), 50);
+    shelf1->removeLocation("A-01-B-01");
+    EXPECT_EQ(shelf1->getTotalCapacity(), 0);
+    EXPECT_EQ(section->getTotalCapacity(), 200);
+    EXPECT_EQ(warehouse.getTotalCapacity(), 200);
+    EXPECT_TRUE(warehouse.isEmpty());
+    loc1->addBooks(10);
+    EXPECT_EQ(warehouse.getCurrentLoad(), 0);
+    section->removeShelf("A-02");
+    EXPECT_EQ(warehouse.getTotalCapacity(), 0);
+    EXPECT_DOUBLE_EQ(warehouse.getUtilizationPercentage(), 0.0);
+    section->addShelf(shelf2);
+    loc2->addBooks(200);
+    EXPECT_TRUE(warehouse.isFull());
+    warehouse.removeSection("A");
+    EXPECT_EQ(warehouse.getTotalCapacity(), 0);
+    EXPECT_EQ(warehouse.getCurrentLoad(), 0);
+    EXPECT_EQ(section->getCurrentLoad(), 200);
+}
+
+TEST(WarehouseTest, BestFitLocationPrefersLeastSpace) {
+    Warehouse warehouse("Test", "Address");
+    auto section = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto shelf = std::make_shared<Shelf>("A-01", 3);
+    auto large = std::make_shared<StorageLocation>("A-01-B-01", 500);
+    auto medium = std::make_shared<StorageLocation>("A-01-B-02", 100);
+    auto small = std::make_shared<StorageLocation>("A-01-B-03", 50);
+    shelf->addLocation(large); shelf->addLocation(medium); shelf->addLocation(small);
+    section->addShelf(shelf);
+    warehouse.addSection(section);
+    EXPECT_EQ(warehouse.findOptimalLocation(40), large);
+    EXPECT_EQ(warehouse.findBestFitLocation(40), small);
+    EXPECT_EQ(warehouse.findBestFitLocation(60), medium);
+    EXPECT_EQ(warehouse.findBestFitLocation(40, WarehouseSection::SectionType::BULK), small);
+    small->addBooks(1);
+    EXPECT_EQ(warehouse.findBestFitLocation(40), medium);
+    EXPECT_EQ(warehouse.findBestFitLocation(501), nullptr);
+}
+
+TEST(WarehouseTest, ForEachLocationVisitsWithoutCopies) {
+    Warehouse warehouse("Test", "Address");
+    auto section1 = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto section2 = std::make_shared<WarehouseSection>("B", "Bulk", "", WarehouseSection::SectionType::BULK);
+    auto shelf1 = std::make_shared<Shelf>("A-01", 2);
+    auto shelf2 = std::make_shared<Shelf>("B-01", 1);
+    auto loc1 = std::make_shared<StorageLocation>("A-01-B-01", 100);
+    auto loc2 = std::make_shared<StorageLocation>("A-01-B-02", 100, 100, StorageLocation::LocationStatus::OCCUPIED);
+    auto loc3 = std::make_shared<StorageLocation>("B-01-B-01", 100);
+    shelf1->addLocation(loc1); shelf1->addLocation(loc2);
+    shelf2->addLocation(loc3);
+    section1->addShelf(shelf1); section2->addShelf(shelf2);
+    warehouse.addSection(section1); warehouse.addSection(section2);
+    EXPECT_EQ(&warehouse.getSections(), &warehouse.getSections());
+    EXPECT_EQ(&shelf1->getLocations(), &shelf1->getLocations());
+    EXPECT_EQ(&section1->getShelves(), &section1->getShelves());
+    long useCount = loc1.use_count();
+    std::vector<std::string> visited;
+    warehouse.forEachLocation([&](const std::shared_ptr<StorageLocation>& location) {
+        EXPECT_EQ(loc1.use_count(), useCount);
+        visited.push_back(location->getLocationId());
+    });
+    EXPECT_EQ(visited, (std::vector<std::string>{"A-01-B-01", "A-01-B-02", "B-01-B-01"}));
+    EXPECT_EQ(warehouse.findAvailableLocations().size(), 2);
+    EXPECT_EQ(section1->findAvailableLocations().size(), 1);
+}
+
+TEST(LocationIndexTest, InsertEraseAndGrowth) {
+    LocationIndex index;
+    std::vector<std::shared_ptr<StorageLocation>> locations;
+    for (int i = 1; i <= 40; ++i) {
+        std::string id = std::string("A-01-B-") + (i < 10 ? "0" : "") + std::to_string(i);
+        locations.push_back(std::make_shared<StorageLocation>(id, i * 10));
+        index.insert(locations.back(), WarehouseSection::SectionType::GENERAL);
+    }
+    EXPECT_EQ(index.size(), 40);
+    EXPECT_EQ(index.findFirstFit(395, WarehouseSection::SectionType::GENERAL), locations[39]);
+    EXPECT_EQ(index.findFirstFit(10), locations[0]);
+    EXPECT_EQ(index.findBestFit(155), locations[15]);
+    EXPECT_EQ(index.findFirstFit(10, WarehouseSection::SectionType::SECURE), nullptr);
+    index.insert(locations[0], WarehouseSection::SectionType::GENERAL);
+    index.erase(*locations[0]);
+    EXPECT_EQ(index.findFirstFit(10), locations[0]);
+    for (int i = 0; i < 30; ++i) {
+        index.erase(*locations[i]);
+    }
+    EXPECT_EQ(index.size(), 10);
+    EXPECT_EQ(index.findFirstFit(10), locations[30]);
+    locations[30]->addBooks(5);
+    index.update(*locations[30]);
+    EXPECT_EQ(index.findFirstFit(10), locations[31]);
+    EXPECT_EQ(index.findBestFit(10), locations[31]);
+    index.clear();
+    EXPECT_EQ(index.size(), 0);
+    EXPECT_EQ(index.findFirstFit(0), nullptr);
+}
+
 TEST(StockMovementTest, ConstructorValidData) {
     auto warehouse = std::make_shared<Warehouse>("Test", "Address");
     EXPECT_NO_THROW(StockReceipt receipt("REC-2024-001", "2024-01-15", "EMP-001", warehouse,
@@ -706,7 +967,82 @@ TEST(WarehouseManagerTest, StockReceiptProcessing) {
     std::vector<std::pair<std::shared_ptr<Book>, int>> items = {{book, 10}};
     auto receipt = manager.processStockReceipt("Supplier", "PO-2024-001", "INV-2024-001", 200.0, items, "EMP-001");
     EXPECT_NE(receipt, nullptr);
-    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 20);
+    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 10);
+    EXPECT_EQ(location->getCurrentLoad(), 10);
+}
+
+TEST(WarehouseManagerTest, StockReceiptDoesNotOverfillOneLocation) {
+    auto warehouse = std::make_shared<Warehouse>("Test", "Address");
+    auto section = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto shelf = std::make_shared<Shelf>("A-01", 2);
+    auto loc1 = std::make_shared<StorageLocation>("A-01-B-01", 100);
+    auto loc2 = std::make_shared<StorageLocation>("A-01-B-02", 100);
+    shelf->addLocation(loc1); shelf->addLocation(loc2);
+    section->addShelf(shelf);
+    warehouse->addSection(section);
+    WarehouseManager manager(warehouse);
+    auto book1 = std::make_shared<Book>(
+        ISBN("9783161484100"), BookTitle("Test Book", "", "EN"), BookMetadata(2024, "EN", 1, ""),
+        PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::SCIENCE_FICTION), std::make_shared<Publisher>("Pub", "test@pub.com", 2000),
+        BookCondition(BookCondition::Condition::NEW), 19.99
+    );
+    auto book2 = std::make_shared<Book>(
+        ISBN("0306406152"), BookTitle("History Book", "", "EN"), BookMetadata(2024, "EN", 1, ""),
+        PhysicalProperties(400, 220, 150, 30, 350, PhysicalProperties::CoverType::HARDCOVER, "Hardcover"),
+        Genre(Genre::Type::HISTORICAL_FICTION), std::make_shared<Publisher>("History Press", "contact@history.com", 2005),
+        BookCondition(BookCondition::Condition::NEW), 39.99
+    );
+    std::vector<std::pair<std::shared_ptr<Book>, int>> items = {{book1, 60}, {book2, 60}};
+    auto plan = manager.planPutaway(items);
+    ASSERT_EQ(plan.size(), 2);
+    EXPECT_NE(plan[0].location, plan[1].location);
+    EXPECT_NO_THROW(manager.processStockReceipt("Supplier", "PO-2024-001", "INV-2024-001", 200.0, items, "EMP-001"));
+    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 60);
+    EXPECT_EQ(warehouse->getBookTotalQuantity("0306406152"), 60);
+    EXPECT_EQ(warehouse->getCurrentLoad(), 120);
+}
+
+TEST(WarehouseManagerTest, PlanPutawayMergesSplitsAndRejects) {
+    auto warehouse = std::make_shared<Warehouse>("Test", "Address");
+    auto general = std::make_shared<WarehouseSection>("A", "General", "", WarehouseSection::SectionType::GENERAL);
+    auto bulk = std::make_shared<WarehouseSection>("B", "Bulk", "", WarehouseSection::SectionType::BULK);
+    auto shelfA = std::make_shared<Shelf>("A-01", 2);
+    auto shelfB = std::make_shared<Shelf>("B-01", 1);
+    auto small = std::make_shared<StorageLocation>("A-01-B-01", 40);
+    auto medium = std::make_shared<StorageLocation>("A-01-B-02", 100);
+    auto large = std::make_shared<StorageLocation>("B-01-B-01", 300);
+    shelfA->addLocation(small); shelfA->addLocation(medium);
+    shelfB->addLocation(large);
+    general->addShelf(shelfA); bulk->addShelf(shelfB);
+    warehouse->addSection(general); warehouse->addSection(bulk);
+    WarehouseManager manager(warehouse);
+    auto book = std::make_shared<Book>(
+        ISBN("9783161484100"), BookTitle("Test Book", "", "EN"), BookMetadata(2024, "EN", 1, ""),
+        PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::SCIENCE_FICTION), std::make_shared<Publisher>("Pub", "test@pub.com", 2000),
+        BookCondition(BookCondition::Condition::NEW), 19.99
+    );
+    auto merged = manager.planPutaway({{book, 10}, {book, 5}});
+    ASSERT_EQ(merged.size(), 1);
+    EXPECT_EQ(merged[0].location, small);
+    EXPECT_EQ(merged[0].quantity, 15);
+    auto bulkFirst = manager.planPutaway({{book, 15}}, WarehouseSection::SectionType::BULK);
+    ASSERT_EQ(bulkFirst.size(), 1);
+    EXPECT_EQ(bulkFirst[0].location, large);
+    auto split = manager.planPutaway({{book, 350}});
+    ASSERT_EQ(split.size(), 2);
+    EXPECT_EQ(split[0].location, medium);
+    EXPECT_EQ(split[0].quantity, 100);
+    EXPECT_EQ(split[1].location, large);
+    EXPECT_EQ(split[1].quantity, 250);
+    EXPECT_NO_THROW(manager.processStockReceipt("Supplier", "PO-2024-001", "INV-2024-001", 200.0, {{book, 180}}, "EMP-001"));
+    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 180);
+    EXPECT_EQ(large->getCurrentLoad(), 180);
+    EXPECT_THROW(manager.planPutaway({{book, 0}}), DataValidationException);
+    EXPECT_THROW(manager.processStockReceipt("Supplier", "PO-2024-002", "INV-2024-002", 200.0, {{book, 500}}, "EMP-001"),
+                 WarehouseException);
+    EXPECT_EQ(warehouse->getCurrentLoad(), 180);
 }
 
 TEST(WarehouseManagerTest, LocationFinding) {
@@ -1217,7 +1553,7 @@ TEST(WarehouseManagerTest, ProcessStockWriteOffValid) {
         "EMP-001",
         "Initial stock"
     );
-    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 40);
+    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), 20);
 }
 
 TEST(WarehouseManagerTest, ProcessStockWriteOffEmptyItemsThrows) {
@@ -1676,4 +2012,349 @@ TEST(WarehouseSectionTest, EqualityOperatorsDifferOnSectionIdOrShelves) {
     c.addShelf(shelf);
     EXPECT_FALSE(c == d);
     EXPECT_TRUE(c != d);
-}
\ No newline at end of file
+}
+
+TEST(IdValidationTest, DocumentNumbersMatchFixedFormat) {
+    EXPECT_TRUE(IdValidation::isValidMovementId("REC-2025-001"));
+    EXPECT_TRUE(IdValidation::isValidMovementId("WO-2025-001"));
+    EXPECT_FALSE(IdValidation::isValidMovementId("PO-2025-001"));
+    EXPECT_FALSE(IdValidation::isValidMovementId("REC-2025-0011"));
+    EXPECT_FALSE(IdValidation::isValidMovementId("REC-20X5-001"));
+    EXPECT_FALSE(IdValidation::isValidMovementId("REC"));
+    EXPECT_TRUE(IdValidation::isValidDeliveryId("DEL-2025-001"));
+    EXPECT_TRUE(IdValidation::isValidPurchaseOrderNumber("PO-2025-001"));
+    EXPECT_FALSE(IdValidation::isValidInvoiceNumber("inv-2025-001"));
+    EXPECT_TRUE(IdValidation::isValidEmployeeId("EMP-001"));
+    EXPECT_FALSE(IdValidation::isValidEmployeeId("EMP-01"));
+}
+
+TEST(IdValidationTest, StorageIdsMatchFixedFormat) {
+    EXPECT_TRUE(IdValidation::isValidSectionId("A"));
+    EXPECT_FALSE(IdValidation::isValidSectionId("a"));
+    EXPECT_FALSE(IdValidation::isValidSectionId(""));
+    EXPECT_TRUE(IdValidation::isValidShelfId("A-01"));
+    EXPECT_FALSE(IdValidation::isValidShelfId("A-1"));
+    EXPECT_FALSE(IdValidation::isValidShelfId("A_01"));
+    EXPECT_TRUE(IdValidation::isValidLocationId("A-01-B-05"));
+    EXPECT_FALSE(IdValidation::isValidLocationId("A-01-b-05"));
+    EXPECT_FALSE(IdValidation::isValidLocationId("A-01-B-05 "));
+    EXPECT_THROW(StorageLocation("A-01-B-5", 100), DataValidationException);
+}
+
+namespace {
+std::shared_ptr<Warehouse> makeSnapshotWarehouse() {
+    auto warehouse = std::make_shared<Warehouse>("Main Warehouse", "Minsk, Nezavisimosti 4");
+    auto general = std::make_shared<WarehouseSection>("A", "General", "Main hall");
+    auto cold = std::make_shared<WarehouseSection>("B", "Cold", "", WarehouseSection::SectionType::REFRIGERATED, 5.0, 40.0);
+    auto shelfA = std::make_shared<Shelf>("A-01", 10);
+    auto shelfB = std::make_shared<Shelf>("B-01", 10);
+    shelfA->addLocation(std::make_shared<StorageLocation>("A-01-A-01", 100));
+    shelfA->addLocation(std::make_shared<StorageLocation>("A-01-A-02", 50));
+    shelfB->addLocation(std::make_shared<StorageLocation>("B-01-A-01", 200));
+    general->addShelf(shelfA);
+    cold->addShelf(shelfB);
+    warehouse->addSection(general);
+    warehouse->addSection(cold);
+
+    auto publisher = std::make_shared<Publisher>("Test Pub", "test@pub.com", 2000);
+    auto series = std::make_shared<BookSeries>("Saga", "Long one", 3, 2001, 2005);
+    auto book = std::make_shared<Book>(
+        ISBN("9783161484100"), BookTitle("Test Book", "Part One", "EN"), BookMetadata(2024, "EN", 2, "About"),
+        PhysicalProperties(300, 200, 130, 20, 250, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::SCIENCE_FICTION), publisher, BookCondition(BookCondition::Condition::NEW), 25.5, series);
+    book->addReview(std::make_shared<BookReview>("Reader", "Good", "Worth reading", 4, "2024-01-15"));
+    auto otherBook = std::make_shared<Book>(
+        ISBN("0306406152"), BookTitle("Other Book", "", "RU"), BookMetadata(1999, "RU"),
+        PhysicalProperties(200, 180, 110, 15, 120, PhysicalProperties::CoverType::HARDCOVER, "Cloth"),
+        Genre(Genre::Type::OTHER), publisher, BookCondition(BookCondition::Condition::GOOD), 10.0);
+
+    auto locations = shelfA->getLocations();
+    warehouse->addInventoryItem(std::make_shared<InventoryItem>(book, 30, locations[0], "2024-01-01"));
+    warehouse->addInventoryItem(std::make_shared<InventoryItem>(book, 20, shelfB->getLocations()[0], "2024-01-02"));
+    warehouse->addInventoryItem(std::make_shared<InventoryItem>(otherBook, 5, locations[0], "2024-01-03"));
+    return warehouse;
+}
+}
+
+TEST(WarehouseSnapshotTest, RoundTripRestoresStateAndSharing) {
+    auto original = makeSnapshotWarehouse();
+    std::string path = testing::TempDir() + "warehouse_snapshot_test.bin";
+    WarehouseSnapshot::save(*original, path);
+    auto restored = WarehouseSnapshot::load(path);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(restored->getName(), original->getName());
+    EXPECT_EQ(restored->getAddress(), original->getAddress());
+    ASSERT_EQ(restored->getSectionsCount(), 2);
+    EXPECT_EQ(restored->findSection("B")->getSectionType(), WarehouseSection::SectionType::REFRIGERATED);
+    EXPECT_DOUBLE_EQ(restored->findSection("B")->getTemperature(), 5.0);
+    EXPECT_EQ(restored->getTotalCapacity(), original->getTotalCapacity());
+    EXPECT_EQ(restored->getCurrentLoad(), original->getCurrentLoad());
+    EXPECT_EQ(restored->findSection("A")->getShelves()[0]->getCurrentLoad(), 35);
+    EXPECT_EQ(restored->getBookTotalQuantity("9783161484100"), 50);
+    EXPECT_EQ(restored->getBookTotalQuantity("0306406152"), 5);
+
+    auto first = restored->findInventoryItem("9783161484100", "A-01-A-01");
+    auto second = restored->findInventoryItem("9783161484100", "B-01-A-01");
+    auto other = restored->findInventoryItem("0306406152", "A-01-A-01");
+    ASSERT_TRUE(first && second && other);
+    EXPECT_EQ(first->getBook(), second->getBook());
+    EXPECT_EQ(first->getLocation(), other->getLocation());
+    EXPECT_EQ(first->getLocation(), restored->findSection("A")->getShelves()[0]->getLocations()[0]);
+    EXPECT_EQ(first->getBook()->getPublisher(), other->getBook()->getPublisher());
+    EXPECT_EQ(first->getDateAdded(), "2024-01-01");
+
+    auto book = first->getBook();
+    EXPECT_EQ(other->getBook()->getISBN().getCode(), "0306406152");
+    EXPECT_EQ(book->getTitle().getSubtitle(), "Part One");
+    EXPECT_EQ(book->getMetadata().getEdition(), 2);
+    EXPECT_EQ(book->getSeries()->getName(), "Saga");
+    EXPECT_EQ(other->getBook()->getSeries(), nullptr);
+    ASSERT_EQ(book->getReviewCount(), 1u);
+    EXPECT_EQ(book->getReviews()[0]->getText(), "Worth reading");
+    EXPECT_DOUBLE_EQ(book->getAverageRating(), 4.0);
+    EXPECT_DOUBLE_EQ(book->getPrice(), 25.5);
+
+    // Restored objects are connected: changes reach the warehouse totals and index
+    EXPECT_EQ(first->getLocation()->getStatus(), StorageLocation::LocationStatus::OCCUPIED);
+    ASSERT_TRUE(restored->findOptimalLocation(40));
+    EXPECT_EQ(restored->findOptimalLocation(40)->getLocationId(), original->findOptimalLocation(40)->getLocationId());
+    first->getLocation()->addBooks(10);
+    EXPECT_EQ(restored->getCurrentLoad(), original->getCurrentLoad() + 10);
+    EXPECT_EQ(restored->findBestFitLocation(50, WarehouseSection::SectionType::GENERAL)->getLocationId(), "A-01-A-02");
+}
+
+TEST(WarehouseSnapshotTest, DamagedOrMissingFileThrows) {
+    auto warehouse = makeSnapshotWarehouse();
+    std::string path = testing::TempDir() + "warehouse_snapshot_damaged.bin";
+    WarehouseSnapshot::save(*warehouse, path);
+    std::string image;
+    {
+        std::ifstream file(path, std::ios::binary);
+        image.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GT(image.size(), 512u);
+    auto write = [&path](const std::string& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << bytes;
+    };
+
+    std::string corrupted = image;
+    corrupted[image.size() / 2] ^= 0x01;
+    write(corrupted);
+    EXPECT_THROW(WarehouseSnapshot::load(path), WarehouseException);
+    write(image.substr(0, image.size() - 8));
+    EXPECT_THROW(WarehouseSnapshot::load(path), WarehouseException);
+    write(image.substr(0, 16));
+    EXPECT_THROW(WarehouseSnapshot::load(path), WarehouseException);
+    write(image);
+    EXPECT_NO_THROW(WarehouseSnapshot::load(path));
+    std::remove(path.c_str());
+    EXPECT_THROW(WarehouseSnapshot::load(path), WarehouseException);
+}
+
+namespace {
+std::string readFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << bytes;
+}
+
+void expectSameStock(const Warehouse& restored, const Warehouse& original) {
+    EXPECT_EQ(restored.getCurrentLoad(), original.getCurrentLoad());
+    int restoredItems = 0;
+    int originalItems = 0;
+    restored.forEachInventoryItem([&restoredItems](const std::shared_ptr<InventoryItem>&) { ++restoredItems; });
+    original.forEachInventoryItem([&originalItems](const std::shared_ptr<InventoryItem>&) { ++originalItems; });
+    EXPECT_EQ(restoredItems, originalItems);
+    original.forEachInventoryItem([&restored](const std::shared_ptr<InventoryItem>& item) {
+        auto same = restored.findInventoryItem(item->getBook()->getISBN(), item->getLocation()->getLocationId());
+        ASSERT_TRUE(same) << item->getInfo();
+        EXPECT_EQ(same->getQuantity(), item->getQuantity());
+        EXPECT_EQ(same->getLocation()->getCurrentLoad(), item->getLocation()->getCurrentLoad());
+    });
+    original.forEachLocation([&restored](const std::shared_ptr<StorageLocation>& location) {
+        int load = -1;
+        restored.forEachLocation([&](const std::shared_ptr<StorageLocation>& other) {
+            if (other->getLocationId() == location->getLocationId()) {
+                load = other->getCurrentLoad();
+            }
+        });
+        EXPECT_EQ(load, location->getCurrentLoad()) << location->getLocationId();
+    });
+}
+}
+
+TEST(StockJournalTest, RecoverReplaysMovementsAfterSnapshot) {
+    auto warehouse = makeSnapshotWarehouse();
+    std::string snapshotPath = testing::TempDir() + "stock_journal_replay.bin";
+    std::string journalPath = testing::TempDir() + "stock_journal_replay.journal";
+    std::remove(journalPath.c_str());
+    auto book = warehouse->findInventoryItem("9783161484100", "A-01-A-01")->getBook();
+    auto otherBook = warehouse->findInventoryItem("0306406152", "A-01-A-01")->getBook();
+    auto newBook = std::make_shared<Book>(
+        ISBN("9780140449136"), BookTitle("New Book", "", "EN"), BookMetadata(2020, "EN"),
+        PhysicalProperties(250, 190, 120, 18, 200, PhysicalProperties::CoverType::PAPERBACK, "Paper"),
+        Genre(Genre::Type::OTHER), book->getPublisher(), BookCondition(BookCondition::Condition::NEW), 12.0);
+    auto locations = warehouse->findSection("A")->getShelves()[0]->getLocations();
+    auto coldLocation = warehouse->findSection("B")->getShelves()[0]->getLocations()[0];
+    auto smallLocation = std::make_shared<StorageLocation>("A-01-A-03", 40);
+    warehouse->findSection("A")->getShelves()[0]->addLocation(smallLocation);
+    WarehouseSnapshot::save(*warehouse, snapshotPath);
+    auto journal = std::make_shared<StockJournal>(journalPath, snapshotPath, 1);
+    warehouse->setJournal(journal);
+    WarehouseManager manager(warehouse);
+
+    auto moved = std::make_shared<StockTransfer>("TRF-2024-001", "2024-02-01", "EMP-001", warehouse,
+                                                 locations[0], smallLocation, "Restocking");
+    moved->addAffectedItem(warehouse->findInventoryItem("9783161484100", "A-01-A-01"));
+    warehouse->processStockMovement(moved);
+    auto writeOff = std::make_shared<StockWriteOff>("WO-2024-001", "2024-02-02", "EMP-001", warehouse,
+                                                    StockWriteOff::WriteOffReason::DAMAGED, "Water damage");
+    writeOff->addAffectedItem(warehouse->findInventoryItem("9783161484100", "A-01-A-03"));
+    warehouse->processStockMovement(writeOff);
+    manager.processStockTransfer(locations[0], locations[1], "Reorganization", {{otherBook, 5}}, "EMP-001");
+    manager.processStockReceipt("Supplier", "PO-2024-001", "INV-2024-001", 120.0, {{newBook, 10}}, "EMP-001");
+    // Fails during execution and is recorded as failed
+    auto overflow = std::make_shared<StockTransfer>("TRF-2024-002", "2024-02-03", "EMP-001", warehouse,
+                                                    coldLocation, locations[1], "Restocking");
+    overflow->addAffectedItem(warehouse->findInventoryItem("9783161484100", "B-01-A-01"));
+    overflow->addAffectedItem(std::make_shared<InventoryItem>(book, 40, coldLocation, "2024-02-03"));
+    EXPECT_THROW(warehouse->processStockMovement(overflow), WarehouseException);
+    journal->sync();
+    EXPECT_EQ(journal->getRecordCount(), 5u);
+
+    auto restored = StockJournal::recover(snapshotPath, journalPath);
+    EXPECT_EQ(restored->getJournal(), nullptr);
+    expectSameStock(*restored, *warehouse);
+    EXPECT_EQ(restored->getBookTotalQuantity("9780140449136"), warehouse->getBookTotalQuantity("9780140449136"));
+    EXPECT_GT(restored->getBookTotalQuantity("9780140449136"), 0);
+    EXPECT_EQ(restored->getBookTotalQuantity("9783161484100"), warehouse->getBookTotalQuantity("9783161484100"));
+    auto received = restored->findInventoryByBook("9780140449136");
+    ASSERT_FALSE(received.empty());
+    EXPECT_EQ(received.front()->getBook()->getTitle().getTitle(), "New Book");
+
+    warehouse->setJournal(nullptr);
+    journal.reset();
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
+TEST(StockJournalTest, TornTailAndStaleJournalAreIgnored) {
+    auto warehouse = makeSnapshotWarehouse();
+    std::string snapshotPath = testing::TempDir() + "stock_journal_torn.bin";
+    std::string journalPath = testing::TempDir() + "stock_journal_torn.journal";
+    std::remove(journalPath.c_str());
+    auto coldShelf = warehouse->findSection("B")->getShelves()[0];
+    coldShelf->addLocation(std::make_shared<StorageLocation>("B-01-A-02", 50));
+    coldShelf->addLocation(std::make_shared<StorageLocation>("B-01-A-03", 50));
+    WarehouseSnapshot::save(*warehouse, snapshotPath);
+    auto book = warehouse->findInventoryItem("9783161484100", "A-01-A-01")->getBook();
+    std::vector<std::shared_ptr<StorageLocation>> targets = {
+        warehouse->findSection("A")->getShelves()[0]->getLocations()[1], coldShelf->getLocations()[1], coldShelf->getLocations()[2]};
+    int receiptNumber = 0;
+    auto receive = [&]() {
+        std::string number = "00" + std::to_string(receiptNumber + 1);
+        auto receipt = std::make_shared<StockReceipt>("REC-2024-" + number, "2024-02-01", "EMP-001", warehouse,
+                                                      "Supplier", "PO-2024-" + number, "INV-2024-" + number, 50.0);
+        receipt->addAffectedItem(std::make_shared<InventoryItem>(book, 5, targets[receiptNumber++], "2024-02-01"));
+        warehouse->processStockMovement(receipt);
+    };
+    EXPECT_THROW(StockJournal(journalPath, snapshotPath, 0), DataValidationException);
+
+    auto journal = std::make_shared<StockJournal>(journalPath, snapshotPath, 1);
+    warehouse->setJournal(journal);
+    receive();
+    int afterFirst = warehouse->getBookTotalQuantity("9783161484100");
+    std::string firstRecord = readFile(journalPath);
+    receive();
+    warehouse->setJournal(nullptr);
+    journal.reset();
+    std::string complete = readFile(journalPath);
+
+    // Interrupted append: the partial record is dropped and cut off when the journal is opened again
+    writeFile(journalPath, complete + std::string(20, 'x'));
+    expectSameStock(*StockJournal::recover(snapshotPath, journalPath), *warehouse);
+    std::string damaged = complete;
+    damaged[firstRecord.size() + 32] ^= 0x01;   // In the body of the second record
+    writeFile(journalPath, damaged);
+    EXPECT_EQ(StockJournal::recover(snapshotPath, journalPath)->getBookTotalQuantity("9783161484100"), afterFirst);
+    writeFile(journalPath, complete + std::string(20, 'x'));
+    journal = std::make_shared<StockJournal>(journalPath, snapshotPath, 1);
+    EXPECT_EQ(journal->getRecordCount(), 2u);
+    EXPECT_EQ(readFile(journalPath), complete);
+
+    // After a checkpoint the old journal belongs to an older snapshot and is not applied again
+    warehouse->setJournal(journal);
+    journal->checkpoint(*warehouse);
+    EXPECT_EQ(journal->getRecordCount(), 0u);
+    receive();
+    journal->sync();
+    expectSameStock(*StockJournal::recover(snapshotPath, journalPath), *warehouse);
+    writeFile(journalPath, firstRecord);
+    int beforeLast = StockJournal::recover(snapshotPath, journalPath)->getBookTotalQuantity("9783161484100");
+    EXPECT_LT(beforeLast, warehouse->getBookTotalQuantity("9783161484100"));
+    EXPECT_GT(beforeLast, afterFirst);
+    std::remove(journalPath.c_str());
+    EXPECT_EQ(StockJournal::recover(snapshotPath, journalPath)->getBookTotalQuantity("9783161484100"), beforeLast);
+
+    warehouse->setJournal(nullptr);
+    journal.reset();
+    std::remove(snapshotPath.c_str());
+    std::remove(journalPath.c_str());
+}
+
+TEST(StockJournalTest, JournalErrorsDoNotChangeMovementOutcome) {
+    auto warehouse = makeSnapshotWarehouse();
+    std::string snapshotPath = testing::TempDir() + "stock_journal_broken.bin";
+    std::string journalDirectory = testing::TempDir() + "stock_journal_broken";
+    std::string journalPath = journalDirectory + "/movements.journal";
+    std::filesystem::remove_all(journalDirectory);
+    std::filesystem::create_directories(journalDirectory);
+    auto book = warehouse->findInventoryItem("9783161484100", "A-01-A-01")->getBook();
+    auto shelf = warehouse->findSection("A")->getShelves()[0];
+    auto freeLocation = std::make_shared<StorageLocation>("A-01-A-03", 40);
+    auto blockedLocation = std::make_shared<StorageLocation>("A-01-A-04", 40);
+    blockedLocation->setStatus(StorageLocation::LocationStatus::BLOCKED);
+    shelf->addLocation(freeLocation);
+    shelf->addLocation(blockedLocation);
+    WarehouseSnapshot::save(*warehouse, snapshotPath);
+    auto journal = std::make_shared<StockJournal>(journalPath, snapshotPath, 1);
+    warehouse->setJournal(journal);
+
+    // The new journal cannot be created, the journal stops accepting records
+    std::filesystem::remove_all(journalDirectory);
+    EXPECT_THROW(journal->checkpoint(*warehouse), WarehouseException);
+    int before = warehouse->getBookTotalQuantity("9783161484100");
+    auto receipt = std::make_shared<StockReceipt>("REC-2024-001", "2024-02-01", "EMP-001", warehouse,
+                                                  "Supplier", "PO-2024-001", "INV-2024-001", 50.0);
+    receipt->addAffectedItem(std::make_shared<InventoryItem>(book, 5, freeLocation, "2024-02-01"));
+    EXPECT_NO_THROW(warehouse->processStockMovement(receipt));
+    EXPECT_EQ(receipt->getStatus(), StockMovement::MovementStatus::COMPLETED);
+    EXPECT_EQ(warehouse->getBookTotalQuantity("9783161484100"), before + 5);
+    auto blocked = std::make_shared<StockReceipt>("REC-2024-002", "2024-02-01", "EMP-001", warehouse,
+                                                  "Supplier", "PO-2024-002", "INV-2024-002", 50.0);
+    blocked->addAffectedItem(std::make_shared<InventoryItem>(book, 5, blockedLocation, "2024-02-01"));
+    try {
+        warehouse->processStockMovement(blocked);
+        ADD_FAILURE() << "receipt into a blocked location succeeded";
+    } catch (const WarehouseException& e) {
+        EXPECT_NE(std::string(e.what()).find("blocked location"), std::string::npos) << e.what();
+    }
+    EXPECT_THROW(journal->sync(), WarehouseException);
+
+    // A checkpoint saves the state with the unrecorded receipt and repairs the journal
+    std::filesystem::create_directories(journalDirectory);
+    journal->checkpoint(*warehouse);
+    EXPECT_NO_THROW(journal->sync());
+    expectSameStock(*StockJournal::recover(snapshotPath, journalPath), *warehouse);
+
+    warehouse->setJournal(nullptr);
+    journal.reset();
+    std::remove(snapshotPath.c_str());
+    std::filesystem::remove_all(journalDirectory);
+}
@@ -0,0 +1,96 @@
+/**
+ * @file MappedFile.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the MappedFile class - RAII wrapper over a memory-mapped file
+ * @version 0.1
+ * @date 2025-12-05
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief File mapped into memory for reading or for writing a file of known size
+ *
+ * An empty file is represented by a null mapping of size zero.
+ * Errors of the operating system are reported as std::runtime_error.
+ */
+class MappedFile {
+public:
+    /**
+     * @brief Expected access pattern, passed to madvise()
+     *
+     */
+    enum class Access {
+        Sequential, ///< read once from the beginning, pages may be dropped behind
+        Normal      ///< accessed in any order (e.g. CSR arrays), default read-ahead of the kernel
+    };
+
+    /**
+     * @brief Map an existing file for reading
+     *
+     * @param path path to the file
+     * @param access expected access pattern
+     * @return MappedFile
+     */
+    static MappedFile openRead(const std::string& path, Access access = Access::Sequential);
+
+    /**
+     * @brief Create (or truncate) a file of the given size and map it for writing
+     *
+     * @param path path to the file
+     * @param size size of the file in bytes
+     * @return MappedFile
+     */
+    static MappedFile create(const std::string& path, std::size_t size);
+
+    MappedFile() = default;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Destroy the MappedFile object, unmaps and closes the file
+     *
+     */
+    ~MappedFile();
+
+    /**
+     * @brief Get the mapped bytes (nullptr for an empty file)
+     *
+     * @return const char*
+     */
+    const char* data() const;
+
+    /**
+     * @brief Get the mapped bytes for writing (nullptr for an empty file)
+     *
+     * @return char*
+     */
+    char* data();
+
+    /**
+     * @brief Get the size of the file in bytes
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Flush written pages to the file
+     *
+     */
+    void sync();
+
+private:
+    int fd = -1;
+    char* mapping = nullptr;
+    std::size_t length = 0;
+
+    void release();
+};
@@ -0,0 +1,86 @@
+#include "MappedFile.hpp"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+[[noreturn]] void fail(const std::string& what, const std::string& path) {
+    throw std::runtime_error("MappedFile: " + what + " " + path + ": " + std::strerror(errno));
+}
+}
+
+MappedFile MappedFile::openRead(const std::string& path, Access access) {
+    MappedFile file;
+    file.fd = ::open(path.c_str(), O_RDONLY);
+    if (file.fd < 0) fail("cannot open", path);
+    struct stat info;
+    if (fstat(file.fd, &info) != 0) fail("cannot stat", path);
+    file.length = static_cast<std::size_t>(info.st_size);
+    if (file.length == 0) return file;
+    void* address = mmap(nullptr, file.length, PROT_READ, MAP_PRIVATE, file.fd, 0);
+    if (address == MAP_FAILED) fail("cannot map", path);
+    file.mapping = static_cast<char*>(address);
+    if (access == Access::Sequential) madvise(address, file.length, MADV_SEQUENTIAL); // прочитанное можно вытеснять
+    return file;
+}
+
+MappedFile MappedFile::create(const std::string& path, std::size_t size) {
+    MappedFile file;
+    file.fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (file.fd < 0) fail("cannot create", path);
+    if (ftruncate(file.fd, static_cast<off_t>(size)) != 0) fail("cannot resize", path);
+    file.length = size;
+    if (size == 0) return file;
+    void* address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+    if (address == MAP_FAILED) fail("cannot map", path);
+    file.mapping = static_cast<char*>(address);
+    madvise(address, size, MADV_SEQUENTIAL);
+    return file;
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : fd(std::exchange(other.fd, -1)), mapping(std::exchange(other.mapping, nullptr)),
+      length(std::exchange(other.length, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        fd = std::exchange(other.fd, -1);
+        mapping = std::exchange(other.mapping, nullptr);
+        length = std::exchange(other.length, 0);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+    if (mapping) munmap(mapping, length);
+    if (fd >= 0) ::close(fd);
+    mapping = nullptr;
+    fd = -1;
+    length = 0;
+}
+
+const char* MappedFile::data() const {
+    return mapping;
+}
+
+char* MappedFile::data() {
+    return mapping;
+}
+
+std::size_t MappedFile::size() const {
+    return length;
+}
+
+void MappedFile::sync() {
+    if (mapping && msync(mapping, length, MS_SYNC) != 0) fail("cannot sync", "mapping");
+}
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BreadthFirstSearch.hpp"
+#include "CSRGraph.hpp"
+#include "ConcurrentUnionFind.hpp"
+#include "Dijkstra.hpp"
+#include "GraphFile.hpp"
+
+namespace {
+struct Options {
+    VertexId vertices = 1 << 20;
+    std::uint64_t edges = 8 << 20;
+    std::string kind = "rmat";
+    bool directed = false;
+    std::size_t threads = 0;
+    VertexId source = 0;
+    std::string load;
+    std::string save;
+};
+
+void printUsage() {
+    std::cout << "Usage: GraphDemo [options]\n"
+              << "  --vertices N     number of vertices (default 2^20)\n"
+              << "  --edges M        number of edges for uniform and rmat (default 2^23)\n"
+              << "  --kind K         uniform, rmat (skewed degrees) or grid (large diameter), default rmat\n"
+              << "  --directed       keep edges one-way\n"
+              << "  --threads N      threads, 0 - all cores (default 0)\n"
+              << "  --source V       start vertex (default 0)\n"
+              << "  --load FILE      read a binary CSR file, a DIMACS file or a text edge list instead of generating\n"
+              << "  --save FILE      write the graph in the binary CSR format\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help") return false;
+        if (argument == "--directed") {
+            options.directed = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (argument == "--vertices") options.vertices = static_cast<VertexId>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (argument == "--edges") options.edges = std::strtoull(value.c_str(), nullptr, 10);
+        else if (argument == "--kind") options.kind = value;
+        else if (argument == "--threads") options.threads = static_cast<std::size_t>(std::atoi(value.c_str()));
+        else if (argument == "--source") options.source = static_cast<VertexId>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (argument == "--load") options.load = value;
+        else if (argument == "--save") options.save = value;
+        else {
+            std::cerr << "Unknown option " << argument << "\n";
+            return false;
+        }
+    }
+    return options.vertices > 0 && (options.kind == "uniform" || options.kind == "rmat" || options.kind == "grid");
+}
+
+// Веса 1..100, генератор детерминирован
+std::vector<Edge> generate(Options& options) {
+    std::mt19937_64 random(20251206);
+    std::vector<Edge> edges;
+    auto weight = [&random] { return static_cast<Weight>(1 + random() % 100); };
+    if (options.kind == "grid") {
+        VertexId side = 1;
+        while (static_cast<std::uint64_t>(side + 1) * (side + 1) <= options.vertices) side++;
+        options.vertices = side * side;
+        edges.reserve(2 * static_cast<std::size_t>(options.vertices));
+        for (VertexId row = 0; row < side; ++row) {
+            for (VertexId column = 0; column < side; ++column) {
+                VertexId v = row * side + column;
+                if (column + 1 < side) edges.push_back({v, v + 1, weight()});
+                if (row + 1 < side) edges.push_back({v, v + side, weight()});
+            }
+        }
+        return edges;
+    }
+    edges.reserve(options.edges);
+    std::uniform_real_distribution<double> coin(0.0, 1.0);
+    int scale = 0;
+    while ((std::uint64_t(1) << scale) < options.vertices) scale++;
+    for (std::uint64_t i = 0; i < options.edges; ++i) {
+        VertexId from;
+        VertexId to;
+        if (options.kind == "uniform") {
+            from = static_cast<VertexId>(random() % options.vertices);
+            to = static_cast<VertexId>(random() % options.vertices);
+        } else { // R-MAT с вероятностями четвертей 0.57, 0.19, 0.19, 0.05
+            std::uint64_t a = 0;
+            std::uint64_t b = 0;
+            for (int bit = 0; bit < scale; ++bit) {
+                double p = coin(random);
+                a = a << 1 | (p >= 0.76 ? 1 : 0);
+                b = b << 1 | ((p >= 0.57 && p < 0.76) || p >= 0.95 ? 1 : 0);
+            }
+            from = static_cast<VertexId>(a % options.vertices);
+            to = static_cast<VertexId>(b % options.vertices);
+        }
+        edges.push_back({from, to, weight()});
+    }
+    return edges;
+}
+
+template <typename Function>
+double seconds(Function function) {
+    auto begin = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    CSRGraph graph;
+    try {
+        if (!options.load.empty()) {
+            GraphFile::TextOptions textOptions;
+            textOptions.directed = options.directed;
+            textOptions.threads = options.threads;
+            double loadTime = seconds([&] { graph = GraphFile::load(options.load, textOptions); });
+            options.directed = graph.isDirected();
+            std::cout << options.load << (GraphFile::isBinary(options.load) ? " mapped" : " parsed") << " in " << loadTime << " s\n";
+        } else {
+            std::vector<Edge> edges = generate(options);
+            double buildTime = seconds([&] { graph = CSRGraph::fromEdges(options.vertices, edges, options.directed); });
+            std::cout << options.kind << " generated, built in " << buildTime << " s\n";
+        }
+        if (!options.save.empty()) {
+            double saveTime = seconds([&] { GraphFile::writeBinary(graph, options.save); });
+            std::cout << "saved to " << options.save << " in " << saveTime << " s\n";
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    if (options.source >= graph.vertexCount()) {
+        std::cerr << "Source is out of range\n";
+        return 1;
+    }
+    std::cout << (graph.isDirected() ? "directed" : "undirected") << ": " << graph.vertexCount() << " vertices, "
+              << graph.arcCount() << " arcs, " << graph.memoryBytes() / (1 << 20) << " MB\n";
+
+    CSRGraph incoming;
+    if (options.directed) incoming = graph.transposed();
+    const CSRGraph& reverse = options.directed ? incoming : graph;
+
+    BfsResult bfs;
+    double bfsTime = seconds([&] { bfs = BreadthFirstSearch::run(graph, reverse, options.source, options.threads); });
+    std::size_t reached = 0;
+    std::uint32_t height = 0;
+    for (std::uint32_t depth : bfs.depth) {
+        if (depth == BfsResult::unreached) continue;
+        reached++;
+        height = std::max(height, depth);
+    }
+    std::cout << "BFS:        " << bfsTime << " s, reached " << reached << ", depth " << height << ", "
+              << bfs.topDownSteps << " top-down and " << bfs.bottomUpSteps << " bottom-up steps\n";
+
+    ShortestPaths paths;
+    double dijkstraTime = seconds([&] { paths = Dijkstra::run(graph, options.source); });
+    std::uint64_t farthest = 0;
+    for (std::uint64_t distance : paths.distance) {
+        if (distance != ShortestPaths::unreachable) farthest = std::max(farthest, distance);
+    }
+    std::cout << "Dijkstra:   " << dijkstraTime << " s, largest distance " << farthest << "\n";
+
+    Components components;
+    double componentsTime = seconds([&] { components = ConnectedComponents::run(graph, options.threads); });
+    std::cout << "Components: " << componentsTime << " s, " << components.count << " components\n";
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include "BreadthFirstSearch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include "ThreadTeam.hpp"
+
+namespace {
+constexpr std::size_t vertexGrain = 4096; // кратно 64: слово битовой карты пишет один поток
+constexpr std::size_t frontierGrain = 256;
+
+class Search {
+public:
+    Search(const CSRGraph& graph, const CSRGraph& incoming, std::size_t threads, BfsResult& result)
+        : graph(graph), incoming(incoming), team(threads), result(result), n(graph.vertexCount()),
+          depth(new std::atomic<std::uint32_t>[graph.vertexCount()]), buffers(team.size()), counters(team.size()),
+          current((n + 63) / 64), next((n + 63) / 64) {}
+
+    void run(VertexId source) {
+        team.parallelFor(0, n, vertexGrain, [this](std::size_t first, std::size_t last, std::size_t) {
+            for (std::size_t v = first; v < last; ++v) depth[v].store(BfsResult::unreached, std::memory_order_relaxed);
+        });
+        result.parent.assign(n, noVertex);
+        depth[source].store(0, std::memory_order_relaxed);
+
+        std::vector<VertexId> frontier = {source};
+        std::uint64_t scout = graph.degree(source);          // дуги фронта
+        std::uint64_t unexplored = graph.arcCount() - scout; // дуги еще не посещенных вершин
+        std::uint32_t level = 0;
+        while (!frontier.empty()) {
+            if (scout > unexplored / BreadthFirstSearch::alpha) {
+                toBitmap(frontier);
+                std::size_t awake = frontier.size();
+                std::size_t previous;
+                do { // снизу вверх, пока фронт растет или остается большим
+                    previous = awake;
+                    awake = bottomUpStep(level++, unexplored);
+                    result.bottomUpSteps++;
+                } while (awake > 0 && (awake >= previous || awake > n / BreadthFirstSearch::beta));
+                frontier = fromBitmap();
+                scout = 0;
+                for (VertexId v : frontier) scout += graph.degree(v);
+                continue;
+            }
+            frontier = topDownStep(frontier, level++, scout);
+            unexplored -= std::min(unexplored, scout);
+            result.topDownSteps++;
+        }
+
+        result.depth.resize(n);
+        team.parallelFor(0, n, vertexGrain, [this](std::size_t first, std::size_t last, std::size_t) {
+            for (std::size_t v = first; v < last; ++v) result.depth[v] = depth[v].load(std::memory_order_relaxed);
+        });
+    }
+
+private:
+    const CSRGraph& graph;
+    const CSRGraph& incoming;
+    ThreadTeam team;
+    BfsResult& result;
+    std::size_t n;
+    std::unique_ptr<std::atomic<std::uint32_t>[]> depth;
+    std::vector<std::vector<VertexId>> buffers; // новые вершины каждого потока
+    std::vector<std::uint64_t> counters;
+    std::vector<std::uint64_t> current;         // фронт снизу вверх
+    std::vector<std::uint64_t> next;
+
+    // Вершина достается потоку, первым записавшему ее глубину
+    std::vector<VertexId> topDownStep(const std::vector<VertexId>& frontier, std::uint32_t level, std::uint64_t& scout) {
+        for (std::size_t w = 0; w < buffers.size(); ++w) {
+            buffers[w].clear();
+            counters[w] = 0;
+        }
+        team.parallelFor(0, frontier.size(), frontierGrain, [&](std::size_t first, std::size_t last, std::size_t worker) {
+            std::vector<VertexId>& local = buffers[worker];
+            std::uint64_t arcs = 0;
+            for (std::size_t i = first; i < last; ++i) {
+                VertexId u = frontier[i];
+                for (VertexId v : graph.neighbours(u)) {
+                    std::uint32_t expected = BfsResult::unreached;
+                    if (depth[v].load(std::memory_order_relaxed) == expected &&
+                        depth[v].compare_exchange_strong(expected, level + 1, std::memory_order_relaxed)) {
+                        result.parent[v] = u;
+                        local.push_back(v);
+                        arcs += graph.degree(v);
+                    }
+                }
+            }
+            counters[worker] += arcs;
+        });
+        return gather(scout);
+    }
+
+    // Каждую непосещенную вершину проверяет только ее поток, атомарные обмены не нужны
+    std::size_t bottomUpStep(std::uint32_t level, std::uint64_t& unexplored) {
+        std::fill(next.begin(), next.end(), 0);
+        std::vector<std::uint64_t> awake(team.size(), 0);
+        std::fill(counters.begin(), counters.end(), 0);
+        team.parallelFor(0, n, vertexGrain, [&](std::size_t first, std::size_t last, std::size_t worker) {
+            std::uint64_t found = 0;
+            std::uint64_t arcs = 0;
+            for (std::size_t v = first; v < last; ++v) {
+                if (depth[v].load(std::memory_order_relaxed) != BfsResult::unreached) continue;
+                for (VertexId u : incoming.neighbours(static_cast<VertexId>(v))) {
+                    if (!(current[u >> 6] >> (u & 63) & 1)) continue;
+                    depth[v].store(level + 1, std::memory_order_relaxed);
+                    result.parent[v] = u;
+                    next[v >> 6] |= std::uint64_t(1) << (v & 63);
+                    found++;
+                    arcs += graph.degree(static_cast<VertexId>(v));
+                    break;
+                }
+            }
+            awake[worker] += found;
+            counters[worker] += arcs;
+        });
+        current.swap(next);
+        std::size_t total = 0;
+        for (std::size_t w = 0; w < awake.size(); ++w) {
+            total += awake[w];
+            unexplored -= std::min(unexplored, counters[w]);
+        }
+        return total;
+    }
+
+    void toBitmap(const std::vector<VertexId>& frontier) {
+        std::fill(current.begin(), current.end(), 0);
+        for (VertexId v : frontier) current[v >> 6] |= std::uint64_t(1) << (v & 63);
+    }
+
+    std::vector<VertexId> fromBitmap() {
+        for (std::vector<VertexId>& buffer : buffers) buffer.clear();
+        team.parallelFor(0, current.size(), vertexGrain / 64, [&](std::size_t first, std::size_t last, std::size_t worker) {
+            for (std::size_t word = first; word < last; ++word) {
+                for (std::uint64_t bits = current[word]; bits; bits &= bits - 1) {
+                    buffers[worker].push_back(static_cast<VertexId>(word * 64 + __builtin_ctzll(bits)));
+                }
+            }
+        });
+        std::uint64_t unused = 0;
+        return gather(unused);
+    }
+
+    std::vector<VertexId> gather(std::uint64_t& arcs) {
+        std::size_t total = 0;
+        arcs = 0;
+        for (std::size_t w = 0; w < buffers.size(); ++w) {
+            total += buffers[w].size();
+            arcs += counters[w];
+        }
+        std::vector<VertexId> frontier;
+        frontier.reserve(total);
+        for (const std::vector<VertexId>& buffer : buffers) frontier.insert(frontier.end(), buffer.begin(), buffer.end());
+        return frontier;
+    }
+};
+}
+
+BfsResult BreadthFirstSearch::run(const CSRGraph& graph, VertexId source, std::size_t threads) {
+    if (!graph.isDirected()) return run(graph, graph, source, threads);
+    CSRGraph incoming = graph.transposed();
+    return run(graph, incoming, source, threads);
+}
+
+BfsResult BreadthFirstSearch::run(const CSRGraph& graph, const CSRGraph& incoming, VertexId source, std::size_t threads) {
+    if (source >= graph.vertexCount()) throw std::out_of_range("BreadthFirstSearch: source is out of range");
+    if (incoming.vertexCount() != graph.vertexCount() || incoming.arcCount() != graph.arcCount()) {
+        throw std::invalid_argument("BreadthFirstSearch: incoming adjacency does not match the graph");
+    }
+    BfsResult result;
+    Search(graph, incoming, threads, result).run(source);
+    return result;
+}
+
+std::vector<VertexId> BreadthFirstSearch::path(const BfsResult& result, VertexId target) {
+    if (target >= result.depth.size() || result.depth[target] == BfsResult::unreached) return {};
+    std::vector<VertexId> vertices(result.depth[target] + 1);
+    for (std::size_t i = vertices.size(); i-- > 0; target = result.parent[target]) vertices[i] = target;
+    return vertices;
+}
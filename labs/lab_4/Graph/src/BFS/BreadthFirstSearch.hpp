@@ -0,0 +1,75 @@
+/**
+ * @file BreadthFirstSearch.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the BreadthFirstSearch class - direction-optimising parallel BFS
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+/**
+ * @brief Result of a breadth-first search
+ *
+ */
+struct BfsResult {
+    static constexpr std::uint32_t unreached = static_cast<std::uint32_t>(-1); ///< Depth of an unreached vertex
+
+    std::vector<std::uint32_t> depth;  ///< Number of arcs from the source, unreached if none
+    std::vector<VertexId> parent;      ///< Previous vertex of a shortest path, noVertex for the source and unreached vertices
+    std::size_t topDownSteps = 0;      ///< Levels expanded from the frontier
+    std::size_t bottomUpSteps = 0;     ///< Levels found by scanning unvisited vertices
+};
+
+/**
+ * @class BreadthFirstSearch
+ * @brief Level-synchronous parallel BFS switching between top-down and bottom-up steps
+ *
+ * A top-down step scans arcs of the frontier and claims new vertices with a
+ * compare-and-swap. When the frontier has more outgoing arcs than the unexplored part
+ * of the graph divided by alpha, the search switches to bottom-up steps: every unvisited
+ * vertex scans its incoming arcs and stops at the first parent found in the frontier
+ * bitmap, which skips most arcs of the large middle levels. When the frontier shrinks
+ * below n / beta the search returns to top-down steps.
+ */
+class BreadthFirstSearch {
+public:
+    static constexpr std::size_t alpha = 14; ///< Top-down to bottom-up switch factor
+    static constexpr std::size_t beta = 24;  ///< Bottom-up to top-down switch factor
+
+    /**
+     * @brief Search from a source, the incoming adjacency of a directed graph is built internally
+     *
+     * @param graph graph
+     * @param source start vertex
+     * @param threads number of threads, 0 means std::thread::hardware_concurrency()
+     * @return BfsResult
+     */
+    static BfsResult run(const CSRGraph& graph, VertexId source, std::size_t threads = 0);
+
+    /**
+     * @brief Search from a source with a prepared incoming adjacency
+     *
+     * @param graph graph
+     * @param incoming graph.transposed() for a directed graph, graph itself for an undirected one
+     * @param source start vertex
+     * @param threads number of threads, 0 means std::thread::hardware_concurrency()
+     * @return BfsResult
+     */
+    static BfsResult run(const CSRGraph& graph, const CSRGraph& incoming, VertexId source, std::size_t threads = 0);
+
+    /**
+     * @brief Vertices of the path from the source to a target
+     *
+     * @param result result of run()
+     * @param target end vertex
+     * @return std::vector<VertexId>, empty if the target is unreached
+     */
+    static std::vector<VertexId> path(const BfsResult& result, VertexId target);
+};
@@ -0,0 +1,129 @@
+#include "CSRGraph.hpp"
+#include <stdexcept>
+#include <string>
+
+namespace {
+// Массивы графа, построенного в памяти
+struct Arrays {
+    std::vector<EdgeIndex> offsets;
+    std::vector<VertexId> targets;
+    std::vector<Weight> weights;
+};
+
+CSRGraph adopt(Arrays&& arrays, bool directed) {
+    auto owner = std::make_shared<Arrays>(std::move(arrays));
+    return CSRGraph::view(owner, static_cast<VertexId>(owner->offsets.size() - 1), owner->offsets.data(),
+                          owner->targets.data(), owner->weights.empty() ? nullptr : owner->weights.data(), directed);
+}
+
+// Сортировка подсчетом по началу дуги, части списка идут подряд
+CSRGraph build(VertexId vertexCount, const std::vector<const std::vector<Edge>*>& parts, bool directed, bool weighted) {
+    Arrays arrays;
+    arrays.offsets.assign(static_cast<std::size_t>(vertexCount) + 1, 0);
+    for (const std::vector<Edge>* part : parts) {
+        const std::vector<Edge>& edges = *part;
+        for (const Edge& edge : edges) {
+            if (edge.from >= vertexCount || edge.to >= vertexCount) {
+                throw std::invalid_argument("CSRGraph: edge " + std::to_string(edge.from) + " -> " + std::to_string(edge.to) +
+                                            " is out of " + std::to_string(vertexCount) + " vertices");
+            }
+            arrays.offsets[edge.from + 1]++;
+            if (!directed && edge.from != edge.to) arrays.offsets[edge.to + 1]++;
+        }
+    }
+    for (std::size_t v = 0; v < vertexCount; ++v) arrays.offsets[v + 1] += arrays.offsets[v];
+
+    EdgeIndex arcs = arrays.offsets[vertexCount];
+    arrays.targets.resize(arcs);
+    if (weighted) arrays.weights.resize(arcs);
+    std::vector<EdgeIndex> position(arrays.offsets.begin(), arrays.offsets.end() - 1); // следующая свободная позиция вершины
+    auto place = [&](VertexId from, VertexId to, Weight weight) {
+        EdgeIndex arc = position[from]++;
+        arrays.targets[arc] = to;
+        if (weighted) arrays.weights[arc] = weight;
+    };
+    for (const std::vector<Edge>* part : parts) {
+        const std::vector<Edge>& edges = *part;
+        for (const Edge& edge : edges) {
+            place(edge.from, edge.to, edge.weight);
+            if (!directed && edge.from != edge.to) place(edge.to, edge.from, edge.weight);
+        }
+    }
+    return adopt(std::move(arrays), directed);
+}
+}
+
+CSRGraph CSRGraph::fromEdges(VertexId vertexCount, const std::vector<Edge>& edges, bool directed, bool weighted) {
+    return build(vertexCount, {&edges}, directed, weighted);
+}
+
+CSRGraph CSRGraph::fromEdges(VertexId vertexCount, const std::vector<std::vector<Edge>>& parts, bool directed, bool weighted) {
+    std::vector<const std::vector<Edge>*> pointers;
+    for (const std::vector<Edge>& part : parts) pointers.push_back(&part);
+    return build(vertexCount, pointers, directed, weighted);
+}
+
+CSRGraph CSRGraph::view(std::shared_ptr<const void> owner, VertexId vertexCount, const EdgeIndex* offsets,
+                        const VertexId* targets, const Weight* weights, bool directed) {
+    CSRGraph graph;
+    graph.storage = std::move(owner);
+    graph.offsets = offsets;
+    graph.targets = targets;
+    graph.weights = weights;
+    graph.vertices = vertexCount;
+    graph.directed = directed;
+    return graph;
+}
+
+CSRGraph CSRGraph::transposed() const {
+    Arrays arrays;
+    VertexId n = vertexCount();
+    EdgeIndex arcs = arcCount();
+    arrays.offsets.assign(static_cast<std::size_t>(n) + 1, 0);
+    for (EdgeIndex arc = 0; arc < arcs; ++arc) arrays.offsets[targets[arc] + 1]++;
+    for (std::size_t v = 0; v < n; ++v) arrays.offsets[v + 1] += arrays.offsets[v];
+    arrays.targets.resize(arcs);
+    if (weights) arrays.weights.resize(arcs);
+    std::vector<EdgeIndex> position(arrays.offsets.begin(), arrays.offsets.end() - 1);
+    for (VertexId v = 0; v < n; ++v) {
+        for (EdgeIndex arc = offsets[v]; arc < offsets[v + 1]; ++arc) {
+            EdgeIndex reversed = position[targets[arc]]++;
+            arrays.targets[reversed] = v;
+            if (weights) arrays.weights[reversed] = weights[arc];
+        }
+    }
+    return adopt(std::move(arrays), directed);
+}
+
+VertexId CSRGraph::vertexCount() const {
+    return vertices;
+}
+
+EdgeIndex CSRGraph::arcCount() const {
+    return offsets[vertices];
+}
+
+bool CSRGraph::isDirected() const {
+    return directed;
+}
+
+bool CSRGraph::isWeighted() const {
+    return weights != nullptr;
+}
+
+std::size_t CSRGraph::memoryBytes() const {
+    return (static_cast<std::size_t>(vertices) + 1) * sizeof(EdgeIndex) + arcCount() * sizeof(VertexId) +
+           (weights ? arcCount() * sizeof(Weight) : 0);
+}
+
+const EdgeIndex* CSRGraph::offsetData() const {
+    return offsets;
+}
+
+const VertexId* CSRGraph::targetData() const {
+    return targets;
+}
+
+const Weight* CSRGraph::weightData() const {
+    return weights;
+}
@@ -0,0 +1,218 @@
+/**
+ * @file CSRGraph.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the CSRGraph class - graph in compressed sparse row form
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+using VertexId = std::uint32_t;  ///< Index of a vertex
+using EdgeIndex = std::uint64_t; ///< Index of an arc in the CSR arrays
+using Weight = std::uint32_t;    ///< Non-negative integer weight of an arc
+
+constexpr VertexId noVertex = static_cast<VertexId>(-1); ///< Absent vertex (no parent, not reached)
+
+/**
+ * @brief Edge of an input edge list
+ *
+ */
+struct Edge {
+    VertexId from;      ///< Tail of the edge
+    VertexId to;        ///< Head of the edge
+    Weight weight = 1;  ///< Weight of the edge
+};
+
+/**
+ * @brief Neighbours of one vertex, a view into the CSR arrays
+ *
+ */
+struct NeighbourRange {
+    const VertexId* first;
+    const VertexId* last;
+
+    const VertexId* begin() const { return first; }
+    const VertexId* end() const { return last; }
+    std::size_t size() const { return static_cast<std::size_t>(last - first); }
+};
+
+/**
+ * @class CSRGraph
+ * @brief Immutable graph stored as three flat arrays
+ *
+ * Arcs leaving vertex v are targets[offsets[v] .. offsets[v + 1]) with the weights at the
+ * same positions. A graph with m arcs and n vertices takes 4m bytes of targets, 4m bytes
+ * of weights (none for an unweighted graph) and 8(n + 1) bytes of offsets, neighbours of
+ * a vertex are contiguous in memory. An undirected edge is stored as two arcs.
+ *
+ * The arrays are shared between copies and may live in vectors built by fromEdges() or
+ * in any other owner, e.g. a memory-mapped file (see view()).
+ */
+class CSRGraph {
+public:
+    /**
+     * @brief Construct an empty graph
+     *
+     */
+    CSRGraph() = default;
+
+    /**
+     * @brief Build a graph from an edge list with a counting sort by the tail
+     *
+     * Arcs of a vertex keep the order of the edge list.
+     *
+     * @param vertexCount number of vertices, all endpoints must be less than it
+     * @param edges edge list
+     * @param directed false - every edge is stored in both directions
+     * @param weighted false - weights are dropped and every arc weighs 1
+     * @return CSRGraph
+     * @throw std::invalid_argument if an endpoint is out of range
+     */
+    static CSRGraph fromEdges(VertexId vertexCount, const std::vector<Edge>& edges, bool directed = true, bool weighted = true);
+
+    /**
+     * @brief Build a graph from an edge list split into parts, as if the parts were concatenated
+     *
+     * @param vertexCount number of vertices, all endpoints must be less than it
+     * @param parts parts of the edge list
+     * @param directed false - every edge is stored in both directions
+     * @param weighted false - weights are dropped and every arc weighs 1
+     * @return CSRGraph
+     * @throw std::invalid_argument if an endpoint is out of range
+     */
+    static CSRGraph fromEdges(VertexId vertexCount, const std::vector<std::vector<Edge>>& parts, bool directed = true, bool weighted = true);
+
+    /**
+     * @brief Use CSR arrays owned by someone else without copying them
+     *
+     * @param owner object keeping the arrays alive, shared by all copies of the graph
+     * @param vertexCount number of vertices
+     * @param offsets vertexCount + 1 offsets, offsets[0] == 0
+     * @param targets offsets[vertexCount] heads of arcs
+     * @param weights weights of arcs or nullptr for an unweighted graph
+     * @param directed whether arcs are not mirrored
+     * @return CSRGraph
+     */
+    static CSRGraph view(std::shared_ptr<const void> owner, VertexId vertexCount, const EdgeIndex* offsets,
+                         const VertexId* targets, const Weight* weights, bool directed);
+
+    /**
+     * @brief Build the graph with every arc reversed (the incoming adjacency)
+     *
+     * @return CSRGraph
+     */
+    CSRGraph transposed() const;
+
+    /**
+     * @brief Get the number of vertices
+     *
+     * @return VertexId
+     */
+    VertexId vertexCount() const;
+
+    /**
+     * @brief Get the number of stored arcs
+     *
+     * @return EdgeIndex
+     */
+    EdgeIndex arcCount() const;
+
+    /**
+     * @brief Check whether the graph was built as directed
+     *
+     * @return true if arcs are not mirrored
+     */
+    bool isDirected() const;
+
+    /**
+     * @brief Check whether arcs carry weights
+     *
+     * @return true if weights are stored
+     */
+    bool isWeighted() const;
+
+    /**
+     * @brief Get the out-degree of a vertex
+     *
+     * @param vertex vertex
+     * @return std::size_t
+     */
+    std::size_t degree(VertexId vertex) const {
+        return static_cast<std::size_t>(offsets[vertex + 1] - offsets[vertex]);
+    }
+
+    /**
+     * @brief Get the heads of arcs leaving a vertex
+     *
+     * @param vertex vertex
+     * @return NeighbourRange
+     */
+    NeighbourRange neighbours(VertexId vertex) const {
+        return {targets + offsets[vertex], targets + offsets[vertex + 1]};
+    }
+
+    /**
+     * @brief Get the weight of the arc at a CSR position
+     *
+     * @param arc index in [offsets[v], offsets[v + 1])
+     * @return Weight, 1 for an unweighted graph
+     */
+    Weight weight(EdgeIndex arc) const {
+        return weights ? weights[arc] : 1;
+    }
+
+    /**
+     * @brief Get the first arc of a vertex
+     *
+     * @param vertex vertex
+     * @return EdgeIndex
+     */
+    EdgeIndex firstArc(VertexId vertex) const {
+        return offsets[vertex];
+    }
+
+    /**
+     * @brief Get the size of the CSR arrays in bytes
+     *
+     * @return std::size_t
+     */
+    std::size_t memoryBytes() const;
+
+    /**
+     * @brief Get the offsets array (vertexCount() + 1 values)
+     *
+     * @return const EdgeIndex*
+     */
+    const EdgeIndex* offsetData() const;
+
+    /**
+     * @brief Get the heads of all arcs (arcCount() values)
+     *
+     * @return const VertexId*
+     */
+    const VertexId* targetData() const;
+
+    /**
+     * @brief Get the weights of all arcs
+     *
+     * @return const Weight*, nullptr for an unweighted graph
+     */
+    const Weight* weightData() const;
+
+private:
+    static constexpr EdgeIndex emptyOffsets[1] = {0};
+
+    std::shared_ptr<const void> storage; // владелец массивов
+    const EdgeIndex* offsets = emptyOffsets;
+    const VertexId* targets = nullptr;
+    const Weight* weights = nullptr;
+    VertexId vertices = 0;
+    bool directed = true;
+};
@@ -0,0 +1,47 @@
+#include "Dijkstra.hpp"
+#include <stdexcept>
+#include "RadixHeap.hpp"
+
+namespace {
+// Поиск до target (noVertex - до всех вершин)
+ShortestPaths search(const CSRGraph& graph, VertexId source, VertexId target) {
+    if (source >= graph.vertexCount()) throw std::out_of_range("Dijkstra: source is out of range");
+    ShortestPaths paths;
+    paths.distance.assign(graph.vertexCount(), ShortestPaths::unreachable);
+    paths.parent.assign(graph.vertexCount(), noVertex);
+    RadixHeap<VertexId> heap;
+    paths.distance[source] = 0;
+    heap.push(0, source);
+    while (!heap.empty()) {
+        auto [distance, u] = heap.pop();
+        if (distance != paths.distance[u]) continue; // устаревшая запись
+        if (u == target) break;
+        EdgeIndex arc = graph.firstArc(u);
+        for (VertexId v : graph.neighbours(u)) {
+            std::uint64_t candidate = distance + graph.weight(arc++);
+            if (candidate < paths.distance[v]) {
+                paths.distance[v] = candidate;
+                paths.parent[v] = u;
+                heap.push(candidate, v);
+            }
+        }
+    }
+    return paths;
+}
+}
+
+ShortestPaths Dijkstra::run(const CSRGraph& graph, VertexId source) {
+    return search(graph, source, noVertex);
+}
+
+std::vector<VertexId> Dijkstra::path(const CSRGraph& graph, VertexId source, VertexId target) {
+    if (target >= graph.vertexCount()) return {};
+    return path(search(graph, source, target), target);
+}
+
+std::vector<VertexId> Dijkstra::path(const ShortestPaths& paths, VertexId target) {
+    if (target >= paths.distance.size() || paths.distance[target] == ShortestPaths::unreachable) return {};
+    std::vector<VertexId> vertices;
+    for (VertexId v = target; v != noVertex; v = paths.parent[v]) vertices.push_back(v);
+    return std::vector<VertexId>(vertices.rbegin(), vertices.rend());
+}
@@ -0,0 +1,65 @@
+/**
+ * @file Dijkstra.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the Dijkstra class - single-source shortest paths on a CSRGraph
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ *
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CSRGraph.hpp"
+
+/**
+ * @brief Result of a shortest path search
+ *
+ */
+struct ShortestPaths {
+    static constexpr std::uint64_t unreachable = static_cast<std::uint64_t>(-1); ///< Distance of an unreached vertex
+
+    std::vector<std::uint64_t> distance; ///< Sum of weights of a shortest path, unreachable if none
+    std::vector<VertexId> parent;        ///< Previous vertex of a shortest path, noVertex for the source and unreached vertices
+};
+
+/**
+ * @class Dijkstra
+ * @brief Dijkstra's algorithm with a RadixHeap
+ *
+ * Weights are non-negative integers, so extracted distances never decrease and the
+ * radix heap replaces a binary heap. Stale heap entries are skipped on extraction
+ * instead of decreasing keys in place.
+ */
+class Dijkstra {
+public:
+    /**
+     * @brief Find shortest paths from a source to all vertices
+     *
+     * @param graph graph, arcs of an unweighted graph weigh 1
+     * @param source start vertex
+     * @return ShortestPaths
+     * @throw std::out_of_range if the source is not a vertex
+     */
+    static ShortestPaths run(const CSRGraph& graph, VertexId source);
+
+    /**
+     * @brief Find a shortest path between two vertices, stops when the target is settled
+     *
+     * @param graph graph
+     * @param source start vertex
+     * @param target end vertex
+     * @return std::vector<VertexId> vertices of the path, empty if the target is unreachable
+     */
+    static std::vector<VertexId> path(const CSRGraph& graph, VertexId source, VertexId target);
+
+    /**
+     * @brief Vertices of the path from the source to a target
+     *
+     * @param paths result of run()
+     * @param target end vertex
+     * @return std::vector<VertexId>, empty if the target is unreachable
+     */
+    static std::vector<VertexId> path(const ShortestPaths& paths, VertexId target);
+};
@@ -0,0 +1,102 @@
+/**
+ * @file RadixHeap.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the RadixHeap class - monotone priority queue with integer keys
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * @class RadixHeap
+ * @brief Min-priority queue for keys that never go below the last extracted key
+ *
+ * Bucket i > 0 holds keys whose highest bit differing from the last extracted key is
+ * bit i - 1, bucket 0 holds keys equal to it. Extraction takes bucket 0 or, if it is
+ * empty, redistributes the first non-empty bucket around its minimum; each item moves
+ * to a lower bucket at most 64 times, so operations are amortised O(log C) without
+ * comparisons between items. Dijkstra's algorithm satisfies the monotonicity condition.
+ *
+ * @tparam Value payload stored with a key
+ */
+template <typename Value>
+class RadixHeap {
+public:
+    using Key = std::uint64_t;
+
+    /**
+     * @brief Add an item
+     *
+     * @param key priority, not less than the last extracted key
+     * @param value payload
+     * @throw std::invalid_argument if the key is less than the last extracted one
+     */
+    void push(Key key, Value value) {
+        if (key < last) throw std::invalid_argument("RadixHeap: key is less than the last extracted key");
+        buckets[bucketOf(key)].emplace_back(key, std::move(value));
+        count++;
+    }
+
+    /**
+     * @brief Extract an item with the smallest key
+     *
+     * @return std::pair<Key, Value>
+     * @throw std::out_of_range if the heap is empty
+     */
+    std::pair<Key, Value> pop() {
+        if (count == 0) throw std::out_of_range("RadixHeap: pop from an empty heap");
+        if (buckets[0].empty()) redistribute();
+        std::pair<Key, Value> item = std::move(buckets[0].back());
+        buckets[0].pop_back();
+        count--;
+        return item;
+    }
+
+    /**
+     * @brief Check whether the heap is empty
+     *
+     * @return true if there are no items
+     */
+    bool empty() const {
+        return count == 0;
+    }
+
+    /**
+     * @brief Get the number of items
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const {
+        return count;
+    }
+
+private:
+    std::array<std::vector<std::pair<Key, Value>>, 65> buckets;
+    Key last = 0;
+    std::size_t count = 0;
+
+    std::size_t bucketOf(Key key) const {
+        return key == last ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(key ^ last));
+    }
+
+    void redistribute() {
+        std::size_t index = 1;
+        while (buckets[index].empty()) index++;
+        std::vector<std::pair<Key, Value>>& source = buckets[index];
+        last = std::min_element(source.begin(), source.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        })->first;
+        for (std::pair<Key, Value>& item : source) buckets[bucketOf(item.first)].push_back(std::move(item)); // все уходят ниже index
+        source.clear();
+    }
+};
@@ -0,0 +1,269 @@
+#include "GraphFile.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "MappedFile.hpp"
+#include "ThreadTeam.hpp"
+
+namespace {
+constexpr char magic[8] = {'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H'};
+constexpr std::uint32_t formatVersion = 1;
+constexpr std::uint32_t byteOrderMark = 0x01020304; // другой порядок байт - файл не наш
+constexpr std::uint32_t directedFlag = 1;
+constexpr std::uint32_t weightedFlag = 2;
+
+// Заголовок двоичного файла, за ним offsets, targets и weights
+struct BinaryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t flags;
+    std::uint32_t reserved0;
+    std::uint64_t vertexCount;
+    std::uint64_t arcCount;
+    std::uint8_t reserved[24];
+};
+static_assert(sizeof(BinaryHeader) == 64, "header keeps the arrays 8-byte aligned");
+
+std::uint64_t binarySize(std::uint64_t vertices, std::uint64_t arcs, bool weighted) {
+    return sizeof(BinaryHeader) + (vertices + 1) * sizeof(EdgeIndex) + arcs * sizeof(VertexId) * (weighted ? 2 : 1);
+}
+
+enum class TextFormat { Plain, Dimacs };
+
+// Результат разбора одного куска файла
+struct Chunk {
+    std::vector<Edge> edges;
+    VertexId maxVertex = 0;
+    bool anyWeight = false;
+    std::size_t errorOffset = static_cast<std::size_t>(-1);
+    std::string error;
+};
+
+class ChunkParser {
+public:
+    ChunkParser(TextFormat format, VertexId declaredVertices, const char* data) : format(format), declared(declaredVertices), data(data) {}
+
+    void parse(const char* begin, const char* end, Chunk& chunk) const {
+        for (const char* line = begin; line < end;) {
+            const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+            const char* lineEnd = newline ? newline : end;
+            const char* next = newline ? newline + 1 : end;
+            if (lineEnd > line && lineEnd[-1] == '\r') lineEnd--;
+            if (!parseLine(line, lineEnd, chunk)) {
+                chunk.errorOffset = static_cast<std::size_t>(line - data);
+                return;
+            }
+            line = next;
+        }
+    }
+
+private:
+    TextFormat format;
+    VertexId declared;
+    const char* data;
+
+    static const char* skipBlanks(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        return p;
+    }
+
+    static bool number(const char*& p, const char* end, std::uint64_t& value) {
+        p = skipBlanks(p, end);
+        auto [next, error] = std::from_chars(p, end, value);
+        if (error != std::errc() || next == p) return false;
+        p = next;
+        return true;
+    }
+
+    bool parseLine(const char* p, const char* end, Chunk& chunk) const {
+        p = skipBlanks(p, end);
+        if (p == end) return true;
+        if (format == TextFormat::Dimacs) {
+            if (*p == 'c' || *p == 'p') return true;
+            if (*p != 'a' && *p != 'e') return fail(chunk, "expected an 'a' or 'e' line");
+            p++;
+        } else if (*p == '#' || *p == '%') {
+            return true;
+        }
+        std::uint64_t from;
+        std::uint64_t to;
+        std::uint64_t weight = 1;
+        if (!number(p, end, from) || !number(p, end, to)) return fail(chunk, "expected two vertex numbers");
+        p = skipBlanks(p, end);
+        if (p < end) {
+            if (!number(p, end, weight)) return fail(chunk, "expected a weight");
+            if (weight > static_cast<Weight>(-1)) return fail(chunk, "weight is too large");
+            chunk.anyWeight = true;
+            if (skipBlanks(p, end) != end) return fail(chunk, "unexpected text after the weight");
+        }
+        if (format == TextFormat::Dimacs) {
+            if (from == 0 || to == 0) return fail(chunk, "DIMACS vertices are numbered from 1");
+            from--;
+            to--;
+        }
+        std::uint64_t limit = declared ? declared : noVertex;
+        if (from >= limit || to >= limit) return fail(chunk, "vertex number is out of range");
+        chunk.edges.push_back({static_cast<VertexId>(from), static_cast<VertexId>(to), static_cast<Weight>(weight)});
+        chunk.maxVertex = std::max({chunk.maxVertex, static_cast<VertexId>(from), static_cast<VertexId>(to)});
+        return true;
+    }
+
+    static bool fail(Chunk& chunk, const char* message) {
+        chunk.error = message;
+        return false;
+    }
+};
+
+// Формат и число вершин по заголовку: первые непустые строки
+TextFormat detectFormat(const char* data, std::size_t size, VertexId& declared) {
+    const char* end = data + size;
+    for (const char* line = data; line < end;) {
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', end - line));
+        const char* lineEnd = newline ? newline : end;
+        const char* p = line;
+        while (p < lineEnd && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+        line = newline ? newline + 1 : end;
+        if (p == lineEnd) continue;
+        if (*p == 'c') continue; // комментарий DIMACS (или начало строки "c ..." - решит строка p/a)
+        if (*p == 'p') {
+            // "p sp n m": пропускаем слово задачи и читаем n
+            p++;
+            while (p < lineEnd && (*p == ' ' || *p == '\t')) p++;
+            while (p < lineEnd && *p != ' ' && *p != '\t') p++;
+            while (p < lineEnd && (*p == ' ' || *p == '\t')) p++;
+            std::uint64_t vertices = 0;
+            auto result = std::from_chars(p, lineEnd, vertices);
+            if (result.ec != std::errc() || vertices >= noVertex) throw std::runtime_error("malformed DIMACS problem line");
+            declared = static_cast<VertexId>(vertices);
+            return TextFormat::Dimacs;
+        }
+        return *p == 'a' || *p == 'e' ? TextFormat::Dimacs : TextFormat::Plain;
+    }
+    return TextFormat::Plain;
+}
+}
+
+CSRGraph GraphFile::readText(const std::string& path, const TextOptions& options) {
+    MappedFile file = MappedFile::openRead(path);
+    const char* data = file.data();
+    std::size_t size = file.size();
+    VertexId declared = 0;
+    TextFormat format;
+    try {
+        format = detectFormat(data, size, declared);
+    } catch (const std::runtime_error& error) {
+        throw std::runtime_error("GraphFile: " + path + ": " + error.what());
+    }
+    if (options.vertexCount) declared = options.vertexCount;
+
+    ThreadTeam team(options.threads);
+    std::size_t parts = std::max<std::size_t>(1, std::min<std::size_t>(team.size() * 4, size / (1 << 16)));
+    std::vector<const char*> bounds(parts + 1, data + size);
+    bounds[0] = data;
+    for (std::size_t i = 1; i < parts; ++i) { // границы кусков - сразу после перевода строки
+        const char* cut = std::max(bounds[i - 1], data + size / parts * i);
+        const char* newline = static_cast<const char*>(std::memchr(cut, '\n', data + size - cut));
+        bounds[i] = newline ? newline + 1 : data + size;
+    }
+    std::vector<Chunk> chunks(parts);
+    ChunkParser parser(format, declared, data);
+    team.parallelFor(0, parts, 1, [&](std::size_t first, std::size_t last, std::size_t) {
+        for (std::size_t i = first; i < last; ++i) {
+            chunks[i].edges.reserve(static_cast<std::size_t>(bounds[i + 1] - bounds[i]) / 8);
+            parser.parse(bounds[i], bounds[i + 1], chunks[i]);
+        }
+    });
+
+    VertexId maxVertex = 0;
+    bool anyWeight = false;
+    bool anyEdge = false;
+    std::vector<std::vector<Edge>> edges;
+    edges.reserve(parts);
+    for (Chunk& chunk : chunks) {
+        if (!chunk.error.empty()) { // первая ошибка в файле - в первом по порядку куске
+            std::size_t line = 1 + static_cast<std::size_t>(std::count(data, data + chunk.errorOffset, '\n'));
+            throw std::runtime_error("GraphFile: " + path + ":" + std::to_string(line) + ": " + chunk.error);
+        }
+        maxVertex = std::max(maxVertex, chunk.maxVertex);
+        anyWeight = anyWeight || chunk.anyWeight;
+        anyEdge = anyEdge || !chunk.edges.empty();
+        edges.push_back(std::move(chunk.edges));
+    }
+    std::vector<Chunk>().swap(chunks);
+    VertexId vertices = declared ? declared : (anyEdge ? maxVertex + 1 : 0);
+    return CSRGraph::fromEdges(vertices, edges, options.directed, options.weighted && anyWeight);
+}
+
+CSRGraph GraphFile::readText(const std::string& path) {
+    return readText(path, TextOptions());
+}
+
+void GraphFile::writeBinary(const CSRGraph& graph, const std::string& path) {
+    BinaryHeader header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = formatVersion;
+    header.byteOrder = byteOrderMark;
+    header.flags = (graph.isDirected() ? directedFlag : 0) | (graph.isWeighted() ? weightedFlag : 0);
+    header.vertexCount = graph.vertexCount();
+    header.arcCount = graph.arcCount();
+
+    std::size_t offsetsBytes = (static_cast<std::size_t>(graph.vertexCount()) + 1) * sizeof(EdgeIndex);
+    std::size_t arcsBytes = graph.arcCount() * sizeof(VertexId);
+    MappedFile file = MappedFile::create(path, binarySize(header.vertexCount, header.arcCount, graph.isWeighted()));
+    char* out = file.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, graph.offsetData(), offsetsBytes);
+    out += offsetsBytes;
+    if (arcsBytes) std::memcpy(out, graph.targetData(), arcsBytes);
+    out += arcsBytes;
+    if (graph.isWeighted() && arcsBytes) std::memcpy(out, graph.weightData(), arcsBytes);
+    file.sync();
+}
+
+CSRGraph GraphFile::mapBinary(const std::string& path) {
+    auto file = std::make_shared<MappedFile>(MappedFile::openRead(path, MappedFile::Access::Normal));
+    auto fail = [&path](const std::string& message) {
+        return std::runtime_error("GraphFile: " + path + ": " + message);
+    };
+    BinaryHeader header;
+    if (file->size() < sizeof(header)) throw fail("too short for a binary CSR file");
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0) throw fail("not a binary CSR file");
+    if (header.byteOrder != byteOrderMark) throw fail("written with another byte order");
+    if (header.version != formatVersion) throw fail("unsupported version " + std::to_string(header.version));
+    if (header.vertexCount >= noVertex) throw fail("too many vertices");
+    bool weighted = header.flags & weightedFlag;
+    if (file->size() != binarySize(header.vertexCount, header.arcCount, weighted)) throw fail("size does not match the header");
+
+    const char* base = file->data() + sizeof(header);
+    auto offsets = reinterpret_cast<const EdgeIndex*>(base);
+    auto targets = reinterpret_cast<const VertexId*>(base + (header.vertexCount + 1) * sizeof(EdgeIndex));
+    auto weights = weighted ? targets + header.arcCount : nullptr;
+    if (offsets[0] != 0 || offsets[header.vertexCount] != header.arcCount) throw fail("offsets do not match the header");
+    // один последовательный проход: испорченный файл не должен дать выход за массивы при обходе
+    for (std::uint64_t v = 0; v < header.vertexCount; ++v) {
+        if (offsets[v] > offsets[v + 1]) throw fail("offsets decrease at vertex " + std::to_string(v));
+    }
+    for (std::uint64_t arc = 0; arc < header.arcCount; ++arc) {
+        if (targets[arc] >= header.vertexCount) throw fail("arc " + std::to_string(arc) + " leads to a missing vertex");
+    }
+    return CSRGraph::view(file, static_cast<VertexId>(header.vertexCount), offsets, targets, weights, header.flags & directedFlag);
+}
+
+bool GraphFile::isBinary(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char prefix[sizeof(magic)] = {};
+    file.read(prefix, sizeof(prefix));
+    return file.gcount() == sizeof(prefix) && std::memcmp(prefix, magic, sizeof(magic)) == 0;
+}
+
+CSRGraph GraphFile::load(const std::string& path, const TextOptions& options) {
+    return isBinary(path) ? mapBinary(path) : readText(path, options);
+}
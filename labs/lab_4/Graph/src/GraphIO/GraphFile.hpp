@@ -0,0 +1,100 @@
+/**
+ * @file GraphFile.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the GraphFile class - loading and saving CSR graphs
+ * @version 0.1
+ * @date 2025-12-07
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <string>
+#include "CSRGraph.hpp"
+
+/**
+ * @class GraphFile
+ * @brief Text edge lists, DIMACS files and the binary CSR format
+ *
+ * Text files are memory-mapped, cut into chunks at line boundaries and parsed in
+ * parallel with std::from_chars. Two text formats are recognised by the first line that
+ * is not empty:
+ * - DIMACS: "c" comments, "p sp n m" problem line, "a u v w" arcs or "e u v" edges with
+ *   vertices numbered from 1;
+ * - plain edge list: "u v" or "u v w" per line with vertices numbered from 0, lines
+ *   starting with '#' or '%' are comments.
+ *
+ * The binary format is a 64-byte header followed by the offsets, targets and weights
+ * arrays exactly as CSRGraph keeps them, so mapBinary() returns a graph that reads the
+ * mapped file directly: loading costs nothing until pages are touched.
+ */
+class GraphFile {
+public:
+    /**
+     * @brief Settings of a text file
+     *
+     */
+    struct TextOptions {
+        bool directed = true;       ///< false - every edge is stored in both directions
+        bool weighted = true;       ///< false - weights are ignored; a file without weights is always unweighted
+        VertexId vertexCount = 0;   ///< Number of vertices, 0 - from the DIMACS problem line or the largest vertex + 1
+        std::size_t threads = 0;    ///< Parsing threads, 0 - all cores
+    };
+
+    /**
+     * @brief Parse a text edge list or a DIMACS file
+     *
+     * @param path path to the file
+     * @param options settings
+     * @return CSRGraph
+     * @throw std::runtime_error with the line number on a malformed line or an I/O error
+     */
+    static CSRGraph readText(const std::string& path, const TextOptions& options);
+
+    /**
+     * @brief Parse a text file as a directed weighted graph with all cores
+     *
+     * @param path path to the file
+     * @return CSRGraph
+     */
+    static CSRGraph readText(const std::string& path);
+
+    /**
+     * @brief Save a graph in the binary CSR format
+     *
+     * @param graph graph
+     * @param path path to the file (created or truncated)
+     * @throw std::runtime_error on I/O errors
+     */
+    static void writeBinary(const CSRGraph& graph, const std::string& path);
+
+    /**
+     * @brief Map a binary CSR file and use it as a graph without copying
+     *
+     * The mapping stays alive while any copy of the returned graph exists. Offsets and
+     * targets are checked in one sequential pass, so the file is read once on mapping.
+     *
+     * @param path path to the file
+     * @return CSRGraph
+     * @throw std::runtime_error if the file is not a valid binary CSR file
+     */
+    static CSRGraph mapBinary(const std::string& path);
+
+    /**
+     * @brief Check whether a file starts with the binary CSR header
+     *
+     * @param path path to the file
+     * @return true if it does
+     */
+    static bool isBinary(const std::string& path);
+
+    /**
+     * @brief Load a binary CSR file with mapBinary() or a text file with readText()
+     *
+     * @param path path to the file
+     * @param options settings of a text file
+     * @return CSRGraph
+     */
+    static CSRGraph load(const std::string& path, const TextOptions& options);
+};
@@ -0,0 +1,61 @@
+#include "ThreadTeam.hpp"
+
+ThreadTeam::ThreadTeam(std::size_t count) {
+    if (count == 0) count = std::thread::hardware_concurrency();
+    if (count == 0) count = 1;
+    threads.reserve(count - 1);
+    for (std::size_t i = 1; i < count; ++i) { // работник 0 - вызывающий поток
+        threads.emplace_back(&ThreadTeam::workerLoop, this, i);
+    }
+}
+
+ThreadTeam::~ThreadTeam() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    started.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+std::size_t ThreadTeam::size() const {
+    return threads.size() + 1;
+}
+
+void ThreadTeam::run(const std::function<void(std::size_t)>& function) {
+    if (threads.empty()) {
+        function(0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &function;
+        running = threads.size();
+        generation++;
+    }
+    started.notify_all();
+    function(0);
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return running == 0; });
+    job = nullptr;
+}
+
+void ThreadTeam::workerLoop(std::size_t index) {
+    std::size_t seen = 0;
+    for (;;) {
+        const std::function<void(std::size_t)>* current;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            started.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+            current = job;
+        }
+        (*current)(index);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running > 0) continue;
+        }
+        finished.notify_one();
+    }
+}
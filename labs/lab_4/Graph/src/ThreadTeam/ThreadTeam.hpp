@@ -0,0 +1,101 @@
+/**
+ * @file ThreadTeam.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the ThreadTeam class - fixed group of threads running data-parallel loops
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadTeam
+ * @brief Threads that are started once and then execute one job at a time together
+ *
+ * Graph algorithms run many short parallel loops (one per BFS level), so the threads
+ * are kept alive between loops instead of being created for each of them. The calling
+ * thread takes part in every job as worker 0.
+ */
+class ThreadTeam {
+public:
+    /**
+     * @brief Construct a new ThreadTeam object and start the threads
+     *
+     * @param threads number of workers including the caller, 0 means std::thread::hardware_concurrency()
+     */
+    explicit ThreadTeam(std::size_t threads = 0);
+
+    /**
+     * @brief Destroy the ThreadTeam object, stops the threads
+     *
+     */
+    ~ThreadTeam();
+
+    ThreadTeam(const ThreadTeam&) = delete;
+    ThreadTeam& operator=(const ThreadTeam&) = delete;
+
+    /**
+     * @brief Get the number of workers
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Run job(worker) on every worker and wait for all of them
+     *
+     * @param job function of the worker index in [0, size())
+     */
+    void run(const std::function<void(std::size_t)>& job);
+
+    /**
+     * @brief Split [begin, end) into chunks of grain indices and process them on all workers
+     *
+     * Chunks are taken from a shared counter, so uneven chunks are balanced. Small ranges
+     * are processed by the caller alone.
+     *
+     * @tparam Function callable (first, last, worker)
+     * @param begin first index
+     * @param end index past the last one
+     * @param grain chunk size
+     * @param function body of the loop
+     */
+    template <typename Function>
+    void parallelFor(std::size_t begin, std::size_t end, std::size_t grain, Function function) {
+        if (begin >= end) return;
+        if (size() == 1 || end - begin <= grain) {
+            function(begin, end, std::size_t(0));
+            return;
+        }
+        std::atomic<std::size_t> next(begin);
+        run([&](std::size_t worker) {
+            for (;;) {
+                std::size_t first = next.fetch_add(grain, std::memory_order_relaxed);
+                if (first >= end) break;
+                function(first, std::min(first + grain, end), worker);
+            }
+        });
+    }
+
+private:
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable started;
+    std::condition_variable finished;
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::size_t generation = 0;
+    std::size_t running = 0;
+    bool stopping = false;
+
+    void workerLoop(std::size_t index);
+};
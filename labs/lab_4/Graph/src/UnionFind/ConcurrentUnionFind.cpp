@@ -0,0 +1,69 @@
+#include "ConcurrentUnionFind.hpp"
+#include <utility>
+#include "ThreadTeam.hpp"
+
+ConcurrentUnionFind::ConcurrentUnionFind(std::size_t size) : parent(new std::atomic<VertexId>[size]), count(size) {
+    for (std::size_t i = 0; i < size; ++i) parent[i].store(static_cast<VertexId>(i), std::memory_order_relaxed);
+}
+
+VertexId ConcurrentUnionFind::find(VertexId element) {
+    for (;;) {
+        VertexId up = parent[element].load(std::memory_order_acquire);
+        if (up == element) return element;
+        VertexId grand = parent[up].load(std::memory_order_acquire);
+        if (grand != up) { // деление пути пополам; неудача не важна
+            parent[element].compare_exchange_weak(up, grand, std::memory_order_release, std::memory_order_relaxed);
+        }
+        element = grand;
+    }
+}
+
+bool ConcurrentUnionFind::unite(VertexId a, VertexId b) {
+    for (;;) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (a > b) std::swap(a, b);
+        VertexId expected = b;
+        if (parent[b].compare_exchange_strong(expected, a, std::memory_order_acq_rel)) return true;
+    }
+}
+
+bool ConcurrentUnionFind::sameSet(VertexId a, VertexId b) {
+    for (;;) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return true;
+        if (parent[a].load(std::memory_order_acquire) == a) return false; // a все еще корень
+    }
+}
+
+std::size_t ConcurrentUnionFind::size() const {
+    return count;
+}
+
+Components ConnectedComponents::run(const CSRGraph& graph, std::size_t threads) {
+    VertexId n = graph.vertexCount();
+    ConcurrentUnionFind sets(n);
+    ThreadTeam team(threads);
+    bool mirrored = !graph.isDirected();
+    team.parallelFor(0, n, 4096, [&](std::size_t first, std::size_t last, std::size_t) {
+        for (std::size_t v = first; v < last; ++v) {
+            for (VertexId u : graph.neighbours(static_cast<VertexId>(v))) {
+                if (mirrored && u > v) continue; // обратная дуга даст то же объединение
+                sets.unite(static_cast<VertexId>(v), u);
+            }
+        }
+    });
+
+    Components components;
+    components.label.resize(n);
+    team.parallelFor(0, n, 4096, [&](std::size_t first, std::size_t last, std::size_t) {
+        for (std::size_t v = first; v < last; ++v) components.label[v] = sets.find(static_cast<VertexId>(v));
+    });
+    for (VertexId v = 0; v < n; ++v) { // корень - наименьшая вершина, его номер уже известен
+        VertexId root = components.label[v];
+        components.label[v] = root == v ? components.count++ : components.label[root];
+    }
+    return components;
+}
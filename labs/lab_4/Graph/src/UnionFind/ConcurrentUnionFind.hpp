@@ -0,0 +1,98 @@
+/**
+ * @file ConcurrentUnionFind.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the ConcurrentUnionFind and ConnectedComponents classes
+ * @version 0.1
+ * @date 2025-12-06
+ *
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "CSRGraph.hpp"
+
+/**
+ * @class ConcurrentUnionFind
+ * @brief Lock-free disjoint sets over vertices 0..n-1
+ *
+ * Parents are atomic. A union links the root with the larger index under the root with
+ * the smaller one by a compare-and-swap that fails if that root was linked meanwhile,
+ * then it is retried from the new roots. find() halves paths with compare-and-swap too,
+ * a failed halving is simply skipped. The root of a set is always its smallest vertex.
+ */
+class ConcurrentUnionFind {
+public:
+    /**
+     * @brief Construct n singleton sets
+     *
+     * @param size number of elements
+     */
+    explicit ConcurrentUnionFind(std::size_t size);
+
+    /**
+     * @brief Find the root of the set of an element, safe to call concurrently
+     *
+     * @param element element
+     * @return VertexId smallest element of the set at the moment of the call
+     */
+    VertexId find(VertexId element);
+
+    /**
+     * @brief Merge the sets of two elements, safe to call concurrently
+     *
+     * @param a element
+     * @param b element
+     * @return true if the sets were different
+     */
+    bool unite(VertexId a, VertexId b);
+
+    /**
+     * @brief Check whether two elements are in one set
+     *
+     * @param a element
+     * @param b element
+     * @return true if they are
+     */
+    bool sameSet(VertexId a, VertexId b);
+
+    /**
+     * @brief Get the number of elements
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+private:
+    std::unique_ptr<std::atomic<VertexId>[]> parent;
+    std::size_t count;
+};
+
+/**
+ * @brief Connected components of a graph
+ *
+ */
+struct Components {
+    std::vector<VertexId> label; ///< Component of every vertex, numbered 0..count-1 by their smallest vertex
+    VertexId count = 0;          ///< Number of components
+};
+
+/**
+ * @class ConnectedComponents
+ * @brief Connected components (weakly connected for a directed graph) by parallel union-find
+ *
+ */
+class ConnectedComponents {
+public:
+    /**
+     * @brief Label components of a graph
+     *
+     * @param graph graph
+     * @param threads number of threads, 0 means std::thread::hardware_concurrency()
+     * @return Components
+     */
+    static Components run(const CSRGraph& graph, std::size_t threads = 0);
+};
@@ -0,0 +1,144 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "ExternalRadixSort.hpp"
+#include "MappedFile.hpp"
+
+namespace {
+void printUsage() {
+    std::cout << "Usage: ExternalSortDemo <command> ...\n"
+              << "  generate keys|lines <file> <count>   write count random records\n"
+              << "  sort keys|lines <input> <output> [--memory MB] [--temp DIR] [--threads N]\n"
+              << "  verify keys|lines <file>             check that records are ascending\n";
+}
+
+// Пишем блоками, файл может быть больше памяти
+void generate(const std::string& format, const std::string& path, std::uint64_t count) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) throw std::runtime_error("cannot create " + path);
+    std::mt19937_64 random(20251205);
+    std::string block;
+    const std::size_t blockRecords = 1 << 16;
+    for (std::uint64_t written = 0; written < count;) {
+        std::uint64_t records = std::min<std::uint64_t>(blockRecords, count - written);
+        block.clear();
+        for (std::uint64_t i = 0; i < records; ++i) {
+            std::uint64_t value = random();
+            if (format == "keys") {
+                block.append(reinterpret_cast<const char*>(&value), sizeof(value));
+                continue;
+            }
+            // длины 1..32, у четверти строк общий префикс
+            std::size_t length = 1 + value % 32;
+            if (value % 4 == 0) block += "shared/prefix/";
+            for (std::size_t c = 0; c < length; ++c) block += static_cast<char>('a' + (random() % 26));
+            block += '\n';
+        }
+        file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        written += records;
+    }
+    if (!file) throw std::runtime_error("cannot write " + path);
+}
+
+bool verify(const std::string& format, const std::string& path, std::uint64_t& records) {
+    MappedFile file = MappedFile::openRead(path);
+    const char* data = file.data();
+    records = 0;
+    if (format == "keys") {
+        if (file.size() % sizeof(std::uint64_t) != 0) return false;
+        std::uint64_t previous = 0;
+        for (std::size_t offset = 0; offset < file.size(); offset += sizeof(std::uint64_t)) {
+            std::uint64_t value;
+            std::memcpy(&value, data + offset, sizeof(value));
+            if (records++ > 0 && value < previous) return false;
+            previous = value;
+        }
+        return true;
+    }
+    std::string_view previous;
+    for (std::size_t offset = 0; offset < file.size();) {
+        const void* newline = std::memchr(data + offset, '\n', file.size() - offset);
+        if (!newline) return false; // последняя строка без перевода строки
+        std::size_t end = static_cast<std::size_t>(static_cast<const char*>(newline) - data);
+        std::string_view line(data + offset, end - offset);
+        if (records++ > 0 && line < previous) return false;
+        previous = line;
+        offset = end + 1;
+    }
+    return true;
+}
+
+int sort(const std::string& format, const std::string& input, const std::string& output, int argc, char* argv[]) {
+    ExternalRadixSort::Options options;
+    for (int i = 0; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << "\n";
+            return 1;
+        }
+        std::string value = argv[++i];
+        if (argument == "--memory") options.memoryLimit = static_cast<std::size_t>(std::atoll(value.c_str())) << 20;
+        else if (argument == "--temp") options.tempDirectory = value;
+        else if (argument == "--threads") options.threads = static_cast<std::size_t>(std::atoi(value.c_str()));
+        else {
+            std::cerr << "Unknown option " << argument << "\n";
+            return 1;
+        }
+    }
+    if (options.memoryLimit == 0) {
+        std::cerr << "Memory limit must be positive\n";
+        return 1;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    ExternalRadixSort::Stats stats = format == "keys" ? ExternalRadixSort::sortKeys(input, output, options)
+                                                      : ExternalRadixSort::sortLines(input, output, options);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "records:       " << stats.records << "\n"
+              << "spill files:   " << stats.spillFiles << "\n"
+              << "spilled bytes: " << stats.spilledBytes << "\n"
+              << "max level:     " << stats.maxLevel << "\n"
+              << "time, s:       " << seconds << "\n";
+    return 0;
+}
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        printUsage();
+        return 1;
+    }
+    std::string command = argv[1];
+    std::string format = argv[2];
+    if (format != "keys" && format != "lines") {
+        printUsage();
+        return 1;
+    }
+    try {
+        if (command == "generate" && argc == 5) {
+            generate(format, argv[3], std::strtoull(argv[4], nullptr, 10));
+            return 0;
+        }
+        if (command == "sort" && argc >= 5) {
+            return sort(format, argv[3], argv[4], argc - 5, argv + 5);
+        }
+        if (command == "verify" && argc == 4) {
+            std::uint64_t records = 0;
+            bool sorted = verify(format, argv[3], records);
+            std::cout << records << " records, " << (sorted ? "sorted" : "NOT SORTED") << "\n";
+            return sorted ? 0 : 2;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+    printUsage();
+    return 1;
+}
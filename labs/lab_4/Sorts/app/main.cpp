@@ -1,7 +1,226 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include "BinaryTreeSort.hpp"
 #include "MSDRadixSort.hpp"
+#include "InputGenerator.hpp"
+#include "PerfCounters.hpp"
 
-int main(){
+namespace {
+struct Options {
+    int minExponent = 3;
+    int maxExponent = 6;
+    std::size_t repeat = 3;
+    std::size_t threads = 0;
+    std::vector<Distribution> distributions = InputGenerator::all();
+    std::vector<std::string> algorithms = {"msd-radix", "tree-avl", "tree-plain", "std-sort", "std-stable-sort"};
+    std::vector<std::string> keyTypes = {"u64", "string"};
+};
+
+// Алгоритм для обоих типов ключей
+struct Algorithm {
+    std::string name;
+    std::function<void(std::vector<std::uint64_t>&, std::size_t)> sortIntegers;
+    std::function<void(std::vector<std::string>&, std::size_t)> sortStrings;
+};
+
+std::vector<Algorithm> algorithms() {
+    return {
+        {"msd-radix",
+            [](std::vector<std::uint64_t>& keys, std::size_t threads) { MSDRadixSort::sort(keys, threads); },
+            [](std::vector<std::string>& keys, std::size_t threads) { MSDRadixSort::sort(keys, threads); }},
+        {"tree-avl",
+            [](std::vector<std::uint64_t>& keys, std::size_t) { BinaryTreeSort::sort(keys, TreeBalance::AVL); },
+            [](std::vector<std::string>& keys, std::size_t) { BinaryTreeSort::sort(keys, TreeBalance::AVL); }},
+        {"tree-plain",
+            [](std::vector<std::uint64_t>& keys, std::size_t) { BinaryTreeSort::sort(keys, TreeBalance::None); },
+            [](std::vector<std::string>& keys, std::size_t) { BinaryTreeSort::sort(keys, TreeBalance::None); }},
+        {"std-sort",
+            [](std::vector<std::uint64_t>& keys, std::size_t) { std::sort(keys.begin(), keys.end()); },
+            [](std::vector<std::string>& keys, std::size_t) { std::sort(keys.begin(), keys.end()); }},
+        {"std-stable-sort",
+            [](std::vector<std::uint64_t>& keys, std::size_t) { std::stable_sort(keys.begin(), keys.end()); },
+            [](std::vector<std::string>& keys, std::size_t) { std::stable_sort(keys.begin(), keys.end()); }},
+    };
+}
+
+std::vector<std::string> split(const std::string& text) {
+    std::vector<std::string> parts;
+    std::stringstream stream(text);
+    std::string part;
+    while (std::getline(stream, part, ',')) {
+        if (!part.empty()) parts.push_back(part);
+    }
+    return parts;
+}
+
+void printUsage() {
+    std::cout << "Usage: SortingDemo [options]\n"
+              << "  --min-exp N      smallest size 10^N (default 3)\n"
+              << "  --max-exp N      largest size 10^N (default 6, up to 8)\n"
+              << "  --repeat N       runs per measurement, the best is reported (default 3)\n"
+              << "  --threads N      threads of MSD radix sort, 0 - all cores (default 0)\n"
+              << "  --dist LIST      uniform,sorted,reverse,few-unique,zipf,common-prefix\n"
+              << "  --algo LIST      msd-radix,tree-avl,tree-plain,std-sort,std-stable-sort\n"
+              << "  --keys LIST      u64,string\n";
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--help") return false;
+        if (i + 1 >= argc) {
+            std::cerr << "Missing value for " << argument << "\n";
+            return false;
+        }
+        std::string value = argv[++i];
+        if (argument == "--min-exp") options.minExponent = std::atoi(value.c_str());
+        else if (argument == "--max-exp") options.maxExponent = std::atoi(value.c_str());
+        else if (argument == "--repeat") options.repeat = std::max(1, std::atoi(value.c_str()));
+        else if (argument == "--threads") options.threads = static_cast<std::size_t>(std::atoi(value.c_str()));
+        else if (argument == "--algo") options.algorithms = split(value);
+        else if (argument == "--keys") options.keyTypes = split(value);
+        else if (argument == "--dist") {
+            options.distributions.clear();
+            for (const std::string& name : split(value)) {
+                Distribution distribution;
+                if (!InputGenerator::parse(name, distribution)) {
+                    std::cerr << "Unknown distribution " << name << "\n";
+                    return false;
+                }
+                options.distributions.push_back(distribution);
+            }
+        } else {
+            std::cerr << "Unknown option " << argument << "\n";
+            return false;
+        }
+    }
+    return options.minExponent >= 0 && options.minExponent <= options.maxExponent && options.maxExponent <= 8;
+}
+
+struct Measurement {
+    double nsPerElement = 0;
+    std::size_t peakKb = 0;
+    std::size_t extraKb = 0;
+    std::uint64_t cacheMisses = 0;
+    std::uint64_t instructions = 0;
+    bool sorted = true;
+};
+
+// Лучший из repeat запусков; копия входа в замер не входит
+template <typename Key, typename Sort>
+Measurement measure(const std::vector<Key>& input, std::size_t repeat, PerfCounters& counters, Sort sort) {
+    Measurement best;
+    best.nsPerElement = -1;
+    for (std::size_t run = 0; run < repeat; ++run) {
+        std::vector<Key> keys = input;
+        PerfCounters::resetPeakMemory();
+        std::size_t baseKb = PerfCounters::peakMemoryKb();
+        counters.start();
+        auto begin = std::chrono::steady_clock::now();
+        sort(keys);
+        auto end = std::chrono::steady_clock::now();
+        counters.stop();
+        double ns = std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(input.size());
+        if (best.nsPerElement < 0 || ns < best.nsPerElement) {
+            best.nsPerElement = ns;
+            best.cacheMisses = counters.cacheMisses();
+            best.instructions = counters.instructions();
+            best.peakKb = PerfCounters::peakMemoryKb();
+            best.extraKb = best.peakKb > baseKb ? best.peakKb - baseKb : 0;
+        }
+        best.sorted = best.sorted && std::is_sorted(keys.begin(), keys.end());
+    }
+    return best;
+}
+
+void printRow(const std::string& keys, Distribution distribution, const std::string& algorithm,
+              std::size_t size, const Measurement* result, bool haveCounters) {
+    std::cout << std::left << std::setw(8) << keys << std::setw(15) << InputGenerator::name(distribution)
+              << std::setw(17) << algorithm << std::right << std::setw(11) << size;
+    if (!result) {
+        std::cout << "  skipped (quadratic on this input)\n";
+        return;
+    }
+    std::cout << std::fixed << std::setprecision(2) << std::setw(12) << result->nsPerElement
+              << std::setw(12) << result->peakKb << std::setw(12) << result->extraKb;
+    if (haveCounters) {
+        std::cout << std::setw(14) << result->cacheMisses << std::setw(12)
+                  << static_cast<double>(result->cacheMisses) / static_cast<double>(size) << std::setw(12)
+                  << static_cast<double>(result->instructions) / static_cast<double>(size);
+    } else {
+        std::cout << std::setw(14) << "n/a" << std::setw(12) << "n/a" << std::setw(12) << "n/a";
+    }
+    std::cout << (result->sorted ? "" : "  NOT SORTED") << "\n";
+}
+
+// Простое дерево на упорядоченном входе вырождается в список
+bool isQuadratic(const std::string& algorithm, Distribution distribution, std::size_t size) {
+    return algorithm == "tree-plain" && size > 20000 &&
+           (distribution == Distribution::Sorted || distribution == Distribution::Reverse);
+}
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    std::vector<Algorithm> selected;
+    for (const Algorithm& algorithm : algorithms()) {
+        if (std::find(options.algorithms.begin(), options.algorithms.end(), algorithm.name) != options.algorithms.end()) {
+            selected.push_back(algorithm);
+        }
+    }
+
+    PerfCounters counters;
+    InputGenerator generator;
+    std::cout << "cache-miss counters: " << (counters.isAvailable() ? "perf_event_open" : "unavailable") << "\n";
+    std::cout << std::left << std::setw(8) << "keys" << std::setw(15) << "distribution" << std::setw(17) << "algorithm"
+              << std::right << std::setw(11) << "n" << std::setw(12) << "ns/elem" << std::setw(12) << "peak KB"
+              << std::setw(12) << "extra KB" << std::setw(14) << "LLC misses" << std::setw(12) << "miss/elem"
+              << std::setw(12) << "instr/elem" << "\n";
+
+    for (int exponent = options.minExponent; exponent <= options.maxExponent; ++exponent) {
+        std::size_t size = 1;
+        for (int i = 0; i < exponent; ++i) size *= 10;
+        for (Distribution distribution : options.distributions) {
+            for (const std::string& keys : options.keyTypes) {
+                if (keys == "u64") {
+                    std::vector<std::uint64_t> input = generator.integers(distribution, size);
+                    for (const Algorithm& algorithm : selected) {
+                        if (isQuadratic(algorithm.name, distribution, size)) {
+                            printRow(keys, distribution, algorithm.name, size, nullptr, false);
+                            continue;
+                        }
+                        Measurement result = measure(input, options.repeat, counters, [&](std::vector<std::uint64_t>& data) {
+                            algorithm.sortIntegers(data, options.threads);
+                        });
+                        printRow(keys, distribution, algorithm.name, size, &result, counters.isAvailable());
+                    }
+                } else if (keys == "string") {
+                    std::vector<std::string> input = generator.strings(distribution, size);
+                    for (const Algorithm& algorithm : selected) {
+                        if (isQuadratic(algorithm.name, distribution, size)) {
+                            printRow(keys, distribution, algorithm.name, size, nullptr, false);
+                            continue;
+                        }
+                        Measurement result = measure(input, options.repeat, counters, [&](std::vector<std::string>& data) {
+                            algorithm.sortStrings(data, options.threads);
+                        });
+                        printRow(keys, distribution, algorithm.name, size, &result, counters.isAvailable());
+                    }
+                }
+            }
+        }
+    }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,114 @@
+#include "InputGenerator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace {
+constexpr std::size_t fewUniqueKeys = 16;
+constexpr std::size_t zipfUniverse = 1 << 20;   // различных ключей в законе Ципфа
+constexpr std::size_t stringDigits = 16;        // длина строки как у ISBN-13 с запасом
+constexpr std::size_t prefixLength = 64;
+
+// Ключ по рангу перемешивается, чтобы частые ключи не были соседними числами
+std::uint64_t scramble(std::uint64_t rank) {
+    rank += 0x9E3779B97F4A7C15ULL;
+    rank = (rank ^ (rank >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    rank = (rank ^ (rank >> 27)) * 0x94D049BB133111EBULL;
+    return rank ^ (rank >> 31);
+}
+
+std::string toHex(std::uint64_t value) {
+    static const char digits[] = "0123456789abcdef";
+    std::string text(stringDigits, '0');
+    for (std::size_t i = stringDigits; i-- > 0; value >>= 4) text[i] = digits[value & 0xF];
+    return text;
+}
+}
+
+InputGenerator::InputGenerator(std::uint64_t seed) : seed(seed) {}
+
+std::vector<std::uint64_t> InputGenerator::integers(Distribution distribution, std::size_t count) const {
+    std::mt19937_64 random(seed);
+    std::vector<std::uint64_t> keys(count);
+    switch (distribution) {
+    case Distribution::Uniform:
+        for (std::uint64_t& key : keys) key = random();
+        break;
+    case Distribution::Sorted:
+    case Distribution::Reverse:
+        for (std::uint64_t& key : keys) key = random();
+        std::sort(keys.begin(), keys.end());
+        if (distribution == Distribution::Reverse) std::reverse(keys.begin(), keys.end());
+        break;
+    case Distribution::FewUnique: {
+        std::uint64_t values[fewUniqueKeys];
+        for (std::uint64_t& value : values) value = random();
+        for (std::uint64_t& key : keys) key = values[random() % fewUniqueKeys];
+        break;
+    }
+    case Distribution::Zipf: {
+        std::vector<double> cumulative(zipfUniverse); // обратная функция распределения по таблице
+        double sum = 0;
+        for (std::size_t rank = 0; rank < zipfUniverse; ++rank) {
+            sum += 1.0 / static_cast<double>(rank + 1);
+            cumulative[rank] = sum;
+        }
+        std::uniform_real_distribution<double> uniform(0.0, sum);
+        for (std::uint64_t& key : keys) {
+            std::size_t rank = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(random)) - cumulative.begin();
+            key = scramble(std::min(rank, zipfUniverse - 1));
+        }
+        break;
+    }
+    case Distribution::CommonPrefix: {
+        std::uint64_t prefix = random() << 24; // старшие 40 бит общие
+        for (std::uint64_t& key : keys) key = prefix | (random() & 0xFFFFFF);
+        break;
+    }
+    }
+    return keys;
+}
+
+std::vector<std::string> InputGenerator::strings(Distribution distribution, std::size_t count) const {
+    std::vector<std::uint64_t> numbers = integers(distribution, count);
+    std::vector<std::string> keys;
+    keys.reserve(count);
+    std::string prefix;
+    if (distribution == Distribution::CommonPrefix) {
+        std::mt19937_64 random(seed + 1);
+        prefix.resize(prefixLength);
+        for (char& symbol : prefix) symbol = static_cast<char>('a' + random() % 26);
+    }
+    for (std::uint64_t number : numbers) keys.push_back(prefix + toHex(number));
+    return keys;
+}
+
+const char* InputGenerator::name(Distribution distribution) {
+    switch (distribution) {
+    case Distribution::Uniform: return "uniform";
+    case Distribution::Sorted: return "sorted";
+    case Distribution::Reverse: return "reverse";
+    case Distribution::FewUnique: return "few-unique";
+    case Distribution::Zipf: return "zipf";
+    case Distribution::CommonPrefix: return "common-prefix";
+    }
+    return "unknown";
+}
+
+bool InputGenerator::parse(const std::string& text, Distribution& distribution) {
+    for (Distribution candidate : all()) {
+        if (text == name(candidate)) {
+            distribution = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<Distribution>& InputGenerator::all() {
+    static const std::vector<Distribution> distributions = {
+        Distribution::Uniform, Distribution::Sorted, Distribution::Reverse,
+        Distribution::FewUnique, Distribution::Zipf, Distribution::CommonPrefix
+    };
+    return distributions;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file InputGenerator.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the InputGenerator class - input distributions for sorting benchmarks
+ * @version 0.1
+ * @date 2025-12-03
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Distribution of generated keys
+ *
+ */
+enum class Distribution {
+    Uniform,        ///< independent uniformly distributed keys
+    Sorted,         ///< already ascending
+    Reverse,        ///< descending
+    FewUnique,      ///< uniform over 16 distinct keys
+    Zipf,           ///< Zipf law with exponent 1, rank 1 is the most frequent key
+    CommonPrefix    ///< strings sharing a 64-character prefix (integers: shared high 40 bits)
+};
+
+/**
+ * @class InputGenerator
+ * @brief Deterministic generator of benchmark inputs
+ *
+ * The same seed gives the same keys, so different algorithms sort identical data.
+ * Strings are fixed-width hexadecimal renderings of the integer keys (ISBN-like length),
+ * therefore Sorted and Reverse keep their meaning for strings too.
+ */
+class InputGenerator {
+public:
+    /**
+     * @brief Construct a new InputGenerator object
+     *
+     * @param seed seed of the pseudo-random generator
+     */
+    explicit InputGenerator(std::uint64_t seed = 42);
+
+    /**
+     * @brief Generate 64-bit keys
+     *
+     * @param distribution distribution of keys
+     * @param count number of keys
+     * @return std::vector<std::uint64_t>
+     */
+    std::vector<std::uint64_t> integers(Distribution distribution, std::size_t count) const;
+
+    /**
+     * @brief Generate string keys
+     *
+     * @param distribution distribution of keys
+     * @param count number of keys
+     * @return std::vector<std::string>
+     */
+    std::vector<std::string> strings(Distribution distribution, std::size_t count) const;
+
+    /**
+     * @brief Get the name of a distribution as used on the command line
+     *
+     * @param distribution distribution
+     * @return const char*
+     */
+    static const char* name(Distribution distribution);
+
+    /**
+     * @brief Parse the name of a distribution
+     *
+     * @param text name as returned by name()
+     * @param distribution parsed distribution
+     * @return true if the name is known
+     * @return false otherwise
+     */
+    static bool parse(const std::string& text, Distribution& distribution);
+
+    /**
+     * @brief Get all distributions
+     *
+     * @return const std::vector<Distribution>&
+     */
+    static const std::vector<Distribution>& all();
+
+private:
+    std::uint64_t seed;
+};
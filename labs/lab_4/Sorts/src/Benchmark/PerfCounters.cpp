@@ -0,0 +1,101 @@
+#include "PerfCounters.hpp"
+#include <fstream>
+#include <string>
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+#if defined(__linux__)
+int openCounter(std::uint64_t config) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;           // считаем и потоки, созданные сортировкой
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    long fd = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    return static_cast<int>(fd);
+}
+#endif
+}
+
+PerfCounters::PerfCounters() {
+#if defined(__linux__)
+    missesFd = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+    instructionsFd = openCounter(PERF_COUNT_HW_INSTRUCTIONS);
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#if defined(__linux__)
+    if (missesFd >= 0) close(missesFd);
+    if (instructionsFd >= 0) close(instructionsFd);
+#endif
+}
+
+bool PerfCounters::isAvailable() const {
+    return missesFd >= 0;
+}
+
+void PerfCounters::start() {
+#if defined(__linux__)
+    for (int fd : {missesFd, instructionsFd}) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+void PerfCounters::stop() {
+#if defined(__linux__)
+    for (int fd : {missesFd, instructionsFd}) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+#endif
+}
+
+std::uint64_t PerfCounters::read(int fd) {
+#if defined(__linux__)
+    std::uint64_t value = 0;
+    if (fd >= 0 && ::read(fd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value))) return value;
+#else
+    (void)fd;
+#endif
+    return 0;
+}
+
+std::uint64_t PerfCounters::cacheMisses() const {
+    return read(missesFd);
+}
+
+std::uint64_t PerfCounters::instructions() const {
+    return read(instructionsFd);
+}
+
+void PerfCounters::resetPeakMemory() {
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) clearRefs << "5"; // сброс VmHWM до текущего RSS
+#endif
+}
+
+std::size_t PerfCounters::peakMemoryKb() {
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) return std::stoul(line.substr(6));
+    }
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) return static_cast<std::size_t>(usage.ru_maxrss);
+#endif
+    return 0;
+}
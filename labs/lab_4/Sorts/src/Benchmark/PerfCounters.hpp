@@ -0,0 +1,92 @@
+/**
+ * @file PerfCounters.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the PerfCounters class - hardware counters and memory usage of a measured run
+ * @version 0.1
+ * @date 2025-12-03
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @class PerfCounters
+ * @brief Cache-miss and instruction counters read through perf_event_open
+ *
+ * Counters follow threads created after start(), so worker pools of parallel sorts
+ * are included. When perf events are unavailable (not Linux, no permission,
+ * virtual machine without PMU) isAvailable() is false and counters read as zero.
+ */
+class PerfCounters {
+public:
+    /**
+     * @brief Construct a new PerfCounters object and open the counters
+     *
+     */
+    PerfCounters();
+
+    /**
+     * @brief Destroy the PerfCounters object and close the counters
+     *
+     */
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @brief Check whether hardware counters could be opened
+     *
+     * @return true
+     * @return false
+     */
+    bool isAvailable() const;
+
+    /**
+     * @brief Reset and enable the counters
+     *
+     */
+    void start();
+
+    /**
+     * @brief Disable the counters
+     *
+     */
+    void stop();
+
+    /**
+     * @brief Get the number of last level cache misses between start() and stop()
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t cacheMisses() const;
+
+    /**
+     * @brief Get the number of retired instructions between start() and stop()
+     *
+     * @return std::uint64_t
+     */
+    std::uint64_t instructions() const;
+
+    /**
+     * @brief Reset the peak resident set size of the process (Linux 4.0+, ignored elsewhere)
+     *
+     */
+    static void resetPeakMemory();
+
+    /**
+     * @brief Get the peak resident set size of the process in kilobytes
+     *
+     * @return std::size_t
+     */
+    static std::size_t peakMemoryKb();
+
+private:
+    int missesFd = -1;
+    int instructionsFd = -1;
+
+    static std::uint64_t read(int fd);
+};
@@ -0,0 +1,182 @@
+/**
+ * @file ArenaTree.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the ArenaTree class - arena-backed search tree used by tree sort
+ * @version 0.1
+ * @date 2025-12-04
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Kind of search tree used by BinaryTreeSort
+ *
+ */
+enum class TreeBalance {
+    None,   ///< plain binary search tree, O(n^2) on sorted or reverse input
+    AVL     ///< AVL tree, O(n log n) on any input
+};
+
+/**
+ * @class ArenaTree
+ * @brief Binary search tree whose nodes lie in one reserved vector and link by 32-bit indices
+ *
+ * Elements equivalent under Compare go to the right, so the in-order traversal is stable.
+ * For std::less over arithmetic types and strings equivalent elements are identical and
+ * share one node with a counter instead.
+ *
+ * @tparam T type of stored elements
+ * @tparam Compare strict weak ordering of elements
+ */
+template <typename T, typename Compare = std::less<T>>
+class ArenaTree {
+public:
+    static constexpr std::uint32_t nil = UINT32_MAX;
+
+    ArenaTree(std::size_t capacity, TreeBalance balance, Compare less = Compare())
+        : balance(balance), less(std::move(less)) {
+        if (capacity >= nil) throw std::length_error("BinaryTreeSort: too many elements");
+        nodes.reserve(capacity); // одно выделение памяти на все дерево
+    }
+
+    void insert(T&& value) {
+        if (root == nil) {
+            root = makeNode(std::move(value));
+            return;
+        }
+        path.clear();
+        std::uint32_t current = root;
+        while (true) {
+            if (balance == TreeBalance::AVL) path.push_back(current); // путь нужен только для балансировки
+            Node& node = nodes[current];
+            bool toLeft = less(value, node.value);
+            if (collapseEqual && !toLeft && !less(node.value, value)) {
+                node.count++; // равные ключи копятся в одном узле
+                return;
+            }
+            std::uint32_t next = toLeft ? node.left : node.right;
+            if (next == nil) {
+                std::uint32_t created = makeNode(std::move(value)); // арена зарезервирована, node не сдвинется
+                if (toLeft) node.left = created;
+                else node.right = created;
+                break;
+            }
+            current = next;
+        }
+        if (balance == TreeBalance::AVL) rebalance();
+    }
+
+    // Симметричный обход без рекурсии, значения переносятся в out
+    template <typename OutputIt>
+    void moveTo(OutputIt out) {
+        path.clear();
+        std::uint32_t current = root;
+        while (current != nil || !path.empty()) {
+            while (current != nil) {
+                path.push_back(current);
+                current = nodes[current].left;
+            }
+            current = path.back();
+            path.pop_back();
+            Node& node = nodes[current];
+            for (std::uint32_t i = 1; i < node.count; ++i) *out++ = node.value;
+            *out++ = std::move(node.value);
+            current = node.right;
+        }
+    }
+
+private:
+    // равные по std::less целые и строки неотличимы, их можно хранить счетчиком;
+    // у плавающих -0.0 и +0.0 (и NaN) равны по std::less, но различаются, поэтому их не сворачиваем
+    static constexpr bool collapseEqual =
+        (std::is_same_v<Compare, std::less<T>> || std::is_same_v<Compare, std::less<>>) &&
+        (std::is_integral_v<T> || std::is_same_v<T, std::string>);
+
+    struct Node {
+        T value;
+        std::uint32_t left = nil;
+        std::uint32_t right = nil;
+        std::uint32_t count = 1;
+        std::uint8_t height = 1;
+
+        explicit Node(T&& value) : value(std::move(value)) {}
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::uint32_t> path;    ///< Путь вставки / стек обхода
+    std::uint32_t root = nil;
+    TreeBalance balance;
+    Compare less;
+
+    std::uint32_t makeNode(T&& value) {
+        nodes.emplace_back(std::move(value));
+        return static_cast<std::uint32_t>(nodes.size() - 1);
+    }
+
+    int height(std::uint32_t index) const {
+        return index == nil ? 0 : nodes[index].height;
+    }
+
+    void update(std::uint32_t index) {
+        Node& node = nodes[index];
+        node.height = static_cast<std::uint8_t>(std::max(height(node.left), height(node.right)) + 1);
+    }
+
+    int balanceOf(std::uint32_t index) const {
+        return height(nodes[index].left) - height(nodes[index].right);
+    }
+
+    std::uint32_t rotateRight(std::uint32_t top) {
+        std::uint32_t pivot = nodes[top].left;
+        nodes[top].left = nodes[pivot].right;
+        nodes[pivot].right = top;
+        update(top);
+        update(pivot);
+        return pivot;
+    }
+
+    std::uint32_t rotateLeft(std::uint32_t top) {
+        std::uint32_t pivot = nodes[top].right;
+        nodes[top].right = nodes[pivot].left;
+        nodes[pivot].left = top;
+        update(top);
+        update(pivot);
+        return pivot;
+    }
+
+    // Подъем по пути вставки: после одного поворота высоты выше не меняются
+    void rebalance() {
+        for (std::size_t i = path.size(); i-- > 0;) {
+            std::uint32_t index = path[i];
+            int oldHeight = nodes[index].height;
+            update(index);
+            int factor = balanceOf(index);
+            std::uint32_t subtree = index;
+            if (factor > 1) {
+                if (balanceOf(nodes[index].left) < 0) nodes[index].left = rotateLeft(nodes[index].left);
+                subtree = rotateRight(index);
+            } else if (factor < -1) {
+                if (balanceOf(nodes[index].right) > 0) nodes[index].right = rotateRight(nodes[index].right);
+                subtree = rotateLeft(index);
+            } else {
+                if (nodes[index].height == oldHeight) return;
+                continue;
+            }
+            if (i == 0) root = subtree;
+            else if (nodes[path[i - 1]].left == index) nodes[path[i - 1]].left = subtree;
+            else nodes[path[i - 1]].right = subtree;
+            return;
+        }
+    }
+};
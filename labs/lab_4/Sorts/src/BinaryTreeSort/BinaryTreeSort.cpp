@@ -1 +1,13 @@
-#include "BinaryTreeSort.hpp"
\ No newline at end of file
+#include "BinaryTreeSort.hpp"
+
+void BinaryTreeSort::sort(std::vector<std::uint32_t>& keys, TreeBalance balance) {
+    tree_sort(keys.begin(), keys.end(), std::less<std::uint32_t>(), balance);
+}
+
+void BinaryTreeSort::sort(std::vector<std::uint64_t>& keys, TreeBalance balance) {
+    tree_sort(keys.begin(), keys.end(), std::less<std::uint64_t>(), balance);
+}
+
+void BinaryTreeSort::sort(std::vector<std::string>& keys, TreeBalance balance) {
+    tree_sort(keys.begin(), keys.end(), std::less<std::string>(), balance);
+}
@@ -1 +1,78 @@
-#pragma once
\ No newline at end of file
+/**
+ * @file BinaryTreeSort.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the BinaryTreeSort class - sorting by insertion into a binary search tree
+ * @version 0.1
+ * @date 2025-12-02
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+#include "ArenaTree.hpp"
+
+/**
+ * @class BinaryTreeSort
+ * @brief Tree sort with nodes taken from a contiguous arena
+ *
+ * All nodes are allocated at once in one array and refer to each other by 32-bit
+ * indices, there is no per-node new. Equal keys of the built-in types share a node with a counter, so inputs
+ * with few distinct keys build a small tree. Insertion and in-order traversal are
+ * iterative, the depth of the tree never touches the call stack.
+ */
+class BinaryTreeSort {
+public:
+    /**
+     * @brief Sort 32-bit unsigned keys in ascending order
+     *
+     * @param keys keys to sort
+     * @param balance kind of tree
+     */
+    static void sort(std::vector<std::uint32_t>& keys, TreeBalance balance = TreeBalance::AVL);
+
+    /**
+     * @brief Sort 64-bit unsigned keys in ascending order
+     *
+     * @param keys keys to sort
+     * @param balance kind of tree
+     */
+    static void sort(std::vector<std::uint64_t>& keys, TreeBalance balance = TreeBalance::AVL);
+
+    /**
+     * @brief Sort strings in ascending order
+     *
+     * @param keys strings to sort
+     * @param balance kind of tree
+     */
+    static void sort(std::vector<std::string>& keys, TreeBalance balance = TreeBalance::AVL);
+};
+
+/**
+ * @brief Sort a range of records with tree sort
+ *
+ * Records are moved into an ArenaTree and moved back in order, the sort is stable,
+ * e.g. tree_sort(books.begin(), books.end(), [](const auto& a, const auto& b) { return a->getPrice() < b->getPrice(); });
+ *
+ * @tparam ForwardIt forward iterator over movable records
+ * @tparam Compare strict weak ordering of records
+ * @param first beginning of the range
+ * @param last end of the range
+ * @param comp comparator
+ * @param balance kind of tree
+ */
+template <typename ForwardIt, typename Compare = std::less<>>
+void tree_sort(ForwardIt first, ForwardIt last, Compare comp = Compare(), TreeBalance balance = TreeBalance::AVL) {
+    using Value = typename std::iterator_traits<ForwardIt>::value_type;
+    std::size_t n = static_cast<std::size_t>(std::distance(first, last));
+    if (n < 2) return;
+    ArenaTree<Value, Compare> tree(n, balance, std::move(comp));
+    for (ForwardIt current = first; current != last; ++current) tree.insert(std::move(*current));
+    tree.moveTo(first);
+}
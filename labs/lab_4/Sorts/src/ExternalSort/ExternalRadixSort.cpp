@@ -0,0 +1,333 @@
+#include "ExternalRadixSort.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "MappedFile.hpp"
+#include "MSDRadixSort.hpp"
+
+namespace {
+// Двоичные 64-битные ключи, уровень - байт от старшего
+struct KeyRecords {
+    static constexpr std::size_t buckets = 256;
+    static constexpr bool terminated = false;
+
+    template <typename Function>
+    static void forEach(const char* data, std::size_t size, Function function) {
+        for (std::size_t offset = 0; offset < size; offset += sizeof(std::uint64_t)) {
+            function(data + offset, sizeof(std::uint64_t));
+        }
+    }
+
+    static std::uint64_t key(const char* record) {
+        std::uint64_t value;
+        std::memcpy(&value, record, sizeof(value));
+        return value;
+    }
+
+    static std::size_t digit(const char* record, std::size_t, std::size_t level) {
+        return static_cast<std::size_t>(key(record) >> (56 - 8 * level)) & 0xFF;
+    }
+
+    static bool isFinal(std::size_t, std::size_t level) {
+        return level == 7;
+    }
+
+    static std::size_t commonLevels(const char* a, std::size_t, const char* b, std::size_t) {
+        return RadixTraits<std::uint64_t>::commonLevels(key(a), key(b));
+    }
+
+    static bool isDone(std::size_t, std::size_t level) {
+        return level >= 8;
+    }
+
+    // анонимная память под сортировку в памяти: копия ключей и, в параллельном режиме, буфер раскладки
+    static std::size_t memoryFor(std::size_t bytes, std::size_t, bool parallel) {
+        return parallel ? 2 * bytes : bytes;
+    }
+
+    static std::size_t outputSize(const char*, std::size_t size) {
+        return size;
+    }
+
+    static std::size_t sortInMemory(const char* data, std::size_t size, std::size_t, char*& out, std::size_t threads) {
+        std::vector<std::uint64_t> keys(size / sizeof(std::uint64_t));
+        if (size) std::memcpy(keys.data(), data, size);
+        MSDRadixSort::sort(keys, threads);
+        if (size) std::memcpy(out, keys.data(), size);
+        out += size;
+        return keys.size();
+    }
+};
+
+// Строки, разделенные '\n'; уровень - номер символа, корзина 0 - строка закончилась
+struct LineRecords {
+    static constexpr std::size_t buckets = 257;
+    static constexpr bool terminated = true;
+
+    template <typename Function>
+    static void forEach(const char* data, std::size_t size, Function function) {
+        const char* end = data + size;
+        for (const char* current = data; current < end;) {
+            const char* newline = static_cast<const char*>(std::memchr(current, '\n', end - current));
+            std::size_t length = newline ? static_cast<std::size_t>(newline - current) : static_cast<std::size_t>(end - current);
+            function(current, length);
+            current += length + 1;
+        }
+    }
+
+    static std::size_t digit(const char* record, std::size_t length, std::size_t level) {
+        return level < length ? static_cast<unsigned char>(record[level]) + 1 : 0;
+    }
+
+    static bool isFinal(std::size_t bucket, std::size_t) {
+        return bucket == 0;
+    }
+
+    static std::size_t commonLevels(const char* a, std::size_t aLength, const char* b, std::size_t bLength) {
+        return RadixTraits<std::string_view>::commonLevels(std::string_view(a, aLength), std::string_view(b, bLength));
+    }
+
+    static bool isDone(std::size_t firstLength, std::size_t level) {
+        return level > firstLength;
+    }
+
+    // строки читаются из отображения и занимают память вместе с массивом ссылок и кэшем цифр;
+    // параллельный режим добавляет буфер раскладки и кэш цифр верхнего уровня
+    static std::size_t memoryFor(std::size_t bytes, std::size_t records, bool parallel) {
+        std::size_t perRecord = sizeof(std::string_view) + sizeof(std::uint16_t);
+        return bytes + records * (parallel ? 2 * perRecord : perRecord);
+    }
+
+    static std::size_t outputSize(const char* data, std::size_t size) {
+        return size + (size > 0 && data[size - 1] != '\n' ? 1 : 0);
+    }
+
+    static std::size_t sortInMemory(const char* data, std::size_t size, std::size_t records, char*& out, std::size_t threads) {
+        std::vector<std::string_view> lines;
+        lines.reserve(records);
+        forEach(data, size, [&lines](const char* record, std::size_t length) {
+            lines.emplace_back(record, length);
+        });
+        msd_radix_sort(lines.begin(), lines.end(), threads);
+        for (std::string_view line : lines) {
+            std::memcpy(out, line.data(), line.size());
+            out += line.size();
+            *out++ = '\n';
+        }
+        return lines.size();
+    }
+};
+
+// Файл корзины, пишется через большой буфер
+class SpillWriter {
+public:
+    std::string path;
+    std::uint64_t bytes = 0;
+    std::uint64_t records = 0;
+
+    void open(const std::string& filePath, std::size_t bufferSize) {
+        path = filePath;
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+        if (fd < 0) throw std::runtime_error("ExternalRadixSort: cannot create " + path + ": " + std::strerror(errno));
+        buffer.resize(bufferSize);
+    }
+
+    bool isOpen() const {
+        return fd >= 0;
+    }
+
+    void append(const char* record, std::size_t length, bool newline) {
+        std::size_t total = length + (newline ? 1 : 0);
+        if (used + total > buffer.size()) flush();
+        if (total > buffer.size()) { // запись длиннее буфера - пишем напрямую
+            writeAll(record, length);
+            if (newline) writeAll("\n", 1);
+        } else {
+            std::memcpy(buffer.data() + used, record, length);
+            used += length;
+            if (newline) buffer[used++] = '\n';
+        }
+        bytes += total;
+        records++;
+    }
+
+    void finish() {
+        flush();
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+        std::vector<char>().swap(buffer);
+    }
+
+    ~SpillWriter() {
+        if (fd >= 0) ::close(fd);
+    }
+
+private:
+    int fd = -1;
+    std::vector<char> buffer;
+    std::size_t used = 0;
+
+    void flush() {
+        writeAll(buffer.data(), used);
+        used = 0;
+    }
+
+    void writeAll(const char* data, std::size_t length) {
+        while (length > 0) {
+            ssize_t written = ::write(fd, data, length);
+            if (written < 0) {
+                if (errno == EINTR) continue;
+                throw std::runtime_error("ExternalRadixSort: cannot write " + path + ": " + std::strerror(errno));
+            }
+            data += written;
+            length -= static_cast<std::size_t>(written);
+        }
+    }
+};
+
+template <typename Records>
+class ExternalSorter {
+public:
+    ExternalRadixSort::Stats stats;
+
+    explicit ExternalSorter(const ExternalRadixSort::Options& options) : options(options) {
+        directory = options.tempDirectory.empty() ? std::filesystem::temp_directory_path() : std::filesystem::path(options.tempDirectory);
+        bufferSize = std::clamp<std::size_t>(options.memoryLimit / (2 * Records::buckets), std::size_t(64) << 10, std::size_t(8) << 20);
+    }
+
+    ~ExternalSorter() {
+        std::error_code ignored;
+        for (const std::string& path : created) std::filesystem::remove(path, ignored); // после исключения
+    }
+
+    // Сортирует область и пишет результат начиная с out; records == npos - число записей неизвестно
+    void sortRegion(const char* data, std::size_t size, std::size_t records, std::size_t level, char*& out) {
+        if (size == 0) return;
+        if (size <= options.memoryLimit) {
+            if (records == npos) {
+                records = 0;
+                Records::forEach(data, size, [&records](const char*, std::size_t) { records++; });
+            }
+            // параллельной сортировке не хватает памяти на буфер - сортируем в одном потоке
+            bool parallel = options.threads != 1 && records >= radix::parallelThreshold;
+            if (parallel && Records::memoryFor(size, records, true) > options.memoryLimit) parallel = false;
+            if (Records::memoryFor(size, records, parallel) <= options.memoryLimit) {
+                stats.records += Records::sortInMemory(data, size, records, out, parallel ? options.threads : 1);
+                return;
+            }
+        }
+        level = skipCommonLevels(data, size, level);
+        if (level == npos) { // все записи равны
+            copyRecords(data, size, out);
+            return;
+        }
+        stats.maxLevel = std::max(stats.maxLevel, level);
+
+        std::vector<SpillWriter> writers(Records::buckets);
+        Records::forEach(data, size, [&](const char* record, std::size_t length) {
+            SpillWriter& writer = writers[Records::digit(record, length, level)];
+            if (!writer.isOpen()) writer.open(spillPath(), bufferSize);
+            writer.append(record, length, Records::terminated);
+        });
+        for (SpillWriter& writer : writers) {
+            if (!writer.isOpen()) continue;
+            writer.finish();
+            stats.spilledBytes += writer.bytes;
+        }
+
+        for (std::size_t bucket = 0; bucket < Records::buckets; ++bucket) { // корзины по порядку - вывод последовательный
+            SpillWriter& writer = writers[bucket];
+            if (writer.path.empty()) continue;
+            {
+                MappedFile spill = MappedFile::openRead(writer.path);
+                if (Records::isFinal(bucket, level)) copyRecords(spill.data(), spill.size(), out);
+                else sortRegion(spill.data(), spill.size(), writer.records, level + 1, out);
+            }
+            std::filesystem::remove(writer.path);
+            created.erase(std::find(created.begin(), created.end(), writer.path));
+        }
+    }
+
+private:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    ExternalRadixSort::Options options;
+    std::filesystem::path directory;
+    std::size_t bufferSize;
+    std::vector<std::string> created;
+
+    std::string spillPath() {
+        std::string name = "radix-spill-" + std::to_string(::getpid()) + "-" + std::to_string(stats.spillFiles++);
+        created.push_back((directory / name).string());
+        return created.back();
+    }
+
+    // Уровень, на котором записи начинают различаться (один последовательный проход чтения
+    // вместо перезаписи всей области на каждом общем уровне); npos - все записи равны
+    std::size_t skipCommonLevels(const char* data, std::size_t size, std::size_t level) {
+        const char* first = nullptr;
+        std::size_t firstLength = 0;
+        std::size_t common = npos;
+        Records::forEach(data, size, [&](const char* record, std::size_t length) {
+            if (!first) {
+                first = record;
+                firstLength = length;
+                return;
+            }
+            if (common > level) common = std::min(common, Records::commonLevels(first, firstLength, record, length));
+        });
+        if (common == npos) return npos; // одна запись
+        if (Records::isDone(firstLength, common)) return npos;
+        return std::max(level, common);
+    }
+
+    void copyRecords(const char* data, std::size_t size, char*& out) {
+        Records::forEach(data, size, [&](const char* record, std::size_t length) {
+            std::memcpy(out, record, length);
+            out += length;
+            if (Records::terminated) *out++ = '\n';
+            stats.records++;
+        });
+    }
+};
+
+template <typename Records>
+ExternalRadixSort::Stats run(const std::string& input, const std::string& output, const ExternalRadixSort::Options& options) {
+    std::error_code error;
+    if (std::filesystem::equivalent(input, output, error)) {
+        throw std::runtime_error("ExternalRadixSort: output must differ from input");
+    }
+    MappedFile source = MappedFile::openRead(input);
+    if (!Records::terminated && source.size() % sizeof(std::uint64_t) != 0) {
+        throw std::runtime_error("ExternalRadixSort: size of " + input + " is not a multiple of 8");
+    }
+    MappedFile target = MappedFile::create(output, Records::outputSize(source.data(), source.size()));
+    ExternalSorter<Records> sorter(options);
+    char* out = target.data();
+    sorter.sortRegion(source.data(), source.size(), static_cast<std::size_t>(-1), 0, out);
+    target.sync();
+    return sorter.stats;
+}
+}
+
+ExternalRadixSort::Stats ExternalRadixSort::sortKeys(const std::string& input, const std::string& output, const Options& options) {
+    return run<KeyRecords>(input, output, options);
+}
+
+ExternalRadixSort::Stats ExternalRadixSort::sortLines(const std::string& input, const std::string& output, const Options& options) {
+    return run<LineRecords>(input, output, options);
+}
+
+ExternalRadixSort::Stats ExternalRadixSort::sortKeys(const std::string& input, const std::string& output) {
+    return sortKeys(input, output, Options());
+}
+
+ExternalRadixSort::Stats ExternalRadixSort::sortLines(const std::string& input, const std::string& output) {
+    return sortLines(input, output, Options());
+}
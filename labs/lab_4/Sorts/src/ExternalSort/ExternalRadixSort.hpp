@@ -0,0 +1,93 @@
+/**
+ * @file ExternalRadixSort.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the ExternalRadixSort class - out-of-core MSD radix sort of files
+ * @version 0.1
+ * @date 2025-12-05
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class ExternalRadixSort
+ * @brief MSD radix sort of files larger than the available memory
+ *
+ * The input is memory-mapped and read sequentially. If it does not fit into the memory
+ * limit, records are distributed by their first digit into per-bucket spill files
+ * written through large buffers. Buckets are then processed in order: a bucket that
+ * fits is sorted in memory with MSD radix sort, a larger one is partitioned again by
+ * the next digit. Sorted buckets are streamed into the memory-mapped output file.
+ * A bucket fits if its records, their in-memory copy and, for parallel sorting, the
+ * scratch buffer stay within the limit; without room for the buffer it is sorted in one thread.
+ *
+ * Two record formats are supported: native-endian 64-bit unsigned keys and
+ * newline-terminated text lines (a missing newline after the last line is added).
+ */
+class ExternalRadixSort {
+public:
+    /**
+     * @brief Settings of an external sort
+     *
+     */
+    struct Options {
+        std::size_t memoryLimit = std::size_t(256) << 20;  ///< Bytes for in-memory sorting and spill buffers
+        std::string tempDirectory;                          ///< Directory of spill files, empty - system temp directory
+        std::size_t threads = 0;                            ///< Threads of in-memory sorting, 0 - all cores
+    };
+
+    /**
+     * @brief Statistics of a finished sort
+     *
+     */
+    struct Stats {
+        std::uint64_t records = 0;      ///< Number of sorted records
+        std::uint64_t spilledBytes = 0; ///< Bytes written to spill files
+        std::size_t spillFiles = 0;     ///< Number of created spill files
+        std::size_t maxLevel = 0;       ///< Deepest digit used for partitioning
+    };
+
+    /**
+     * @brief Sort a binary file of 64-bit unsigned keys
+     *
+     * @param input path of the input file, its size must be a multiple of 8
+     * @param output path of the output file (created or truncated)
+     * @param options settings
+     * @return Stats
+     * @throw std::runtime_error on I/O errors or a malformed input
+     */
+    static Stats sortKeys(const std::string& input, const std::string& output, const Options& options);
+
+    /**
+     * @brief Sort a binary file of 64-bit unsigned keys with default settings
+     *
+     * @param input path of the input file
+     * @param output path of the output file
+     * @return Stats
+     */
+    static Stats sortKeys(const std::string& input, const std::string& output);
+
+    /**
+     * @brief Sort lines of a text file by their bytes
+     *
+     * @param input path of the input file
+     * @param output path of the output file (created or truncated)
+     * @param options settings
+     * @return Stats
+     * @throw std::runtime_error on I/O errors
+     */
+    static Stats sortLines(const std::string& input, const std::string& output, const Options& options);
+
+    /**
+     * @brief Sort lines of a text file with default settings
+     *
+     * @param input path of the input file
+     * @param output path of the output file
+     * @return Stats
+     */
+    static Stats sortLines(const std::string& input, const std::string& output);
+};
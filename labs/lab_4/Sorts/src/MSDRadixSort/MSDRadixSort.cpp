@@ -1 +1,13 @@
-#include "MSDRadixSort.hpp"
\ No newline at end of file
+#include "MSDRadixSort.hpp"
+
+void MSDRadixSort::sort(std::vector<std::uint32_t>& keys, std::size_t threads) {
+    msd_radix_sort(keys.begin(), keys.end(), threads);
+}
+
+void MSDRadixSort::sort(std::vector<std::uint64_t>& keys, std::size_t threads) {
+    msd_radix_sort(keys.begin(), keys.end(), threads);
+}
+
+void MSDRadixSort::sort(std::vector<std::string>& keys, std::size_t threads) {
+    msd_radix_sort(keys.begin(), keys.end(), threads);
+}
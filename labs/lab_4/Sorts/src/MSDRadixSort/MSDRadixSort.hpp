@@ -1 +1,121 @@
-#pragma once
\ No newline at end of file
+/**
+ * @file MSDRadixSort.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the MSDRadixSort class - most significant digit radix sort
+ * @version 0.1
+ * @date 2025-12-01
+ *
+ *
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "RadixEngine.hpp"
+
+/**
+ * @class MSDRadixSort
+ * @brief MSD radix sort of unsigned integer keys and strings
+ *
+ * Keys are split by one byte per pass (256 buckets, 257 for strings where the extra
+ * bucket holds strings that already ended). The top level is distributed out of place
+ * with per-thread histograms, deeper levels are permuted in place (American flag sort).
+ * A pass over a range whose keys all share the current byte is skipped, buckets of at
+ * most insertionThreshold keys are finished with insertion sort. Buckets of at least
+ * parallelThreshold keys are sorted as separate tasks of a WorkStealingPool.
+ */
+class MSDRadixSort {
+public:
+    static constexpr std::size_t insertionThreshold = radix::insertionThreshold; ///< Largest bucket sorted by insertion sort
+    static constexpr std::size_t parallelThreshold = radix::parallelThreshold;   ///< Smallest bucket sorted as a separate task
+
+    /**
+     * @brief Sort 32-bit unsigned keys in ascending order
+     *
+     * @param keys keys to sort
+     * @param threads number of threads, 0 means std::thread::hardware_concurrency(), 1 - no threads
+     */
+    static void sort(std::vector<std::uint32_t>& keys, std::size_t threads = 0);
+
+    /**
+     * @brief Sort 64-bit unsigned keys in ascending order
+     *
+     * @param keys keys to sort
+     * @param threads number of threads, 0 means std::thread::hardware_concurrency(), 1 - no threads
+     */
+    static void sort(std::vector<std::uint64_t>& keys, std::size_t threads = 0);
+
+    /**
+     * @brief Sort strings in lexicographic order of their bytes (as std::string::compare)
+     *
+     * @param keys strings to sort
+     * @param threads number of threads, 0 means std::thread::hardware_concurrency(), 1 - no threads
+     */
+    static void sort(std::vector<std::string>& keys, std::size_t threads = 0);
+};
+
+/**
+ * @brief Key extractor returning the record itself
+ *
+ */
+struct IdentityKey {
+    template <typename T>
+    const T& operator()(const T& value) const {
+        return value;
+    }
+};
+
+/**
+ * @brief Sort a random-access range of records by a key with MSD radix sort
+ *
+ * Digit extraction is chosen at compile time by RadixTraits of the key type
+ * (uint32_t, uint64_t, double, std::string, std::string_view). Records are moved,
+ * not copied, e.g. msd_radix_sort(books.begin(), books.end(),
+ * [](const std::shared_ptr<Book>& book) { return book->getISBN().getPackedCode(); });
+ * The key is read for every digit of every pass and every insertion-sort comparison, so
+ * the extractor must be cheap and must not allocate: return a number, a std::string_view
+ * or a const reference to a string held by the record, never a std::string by value.
+ * The parallel top level needs default-constructible records, otherwise the sort is sequential.
+ * The sort is not stable.
+ *
+ * @tparam RandomIt random-access iterator
+ * @tparam KeyFn callable with const record& returning the key by value only if it is a number or a view
+ * @param first beginning of the range
+ * @param last end of the range
+ * @param keyOf key extractor
+ * @param threads number of threads, 0 means std::thread::hardware_concurrency(), 1 - no threads
+ */
+template <typename RandomIt, typename KeyFn,
+          typename = std::enable_if_t<std::is_invocable_v<const KeyFn&, const typename std::iterator_traits<RandomIt>::value_type&>>>
+void msd_radix_sort(RandomIt first, RandomIt last, KeyFn keyOf, std::size_t threads = 0) {
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+    std::size_t n = static_cast<std::size_t>(last - first);
+    if (n < 2) return;
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if constexpr (std::is_default_constructible_v<Value>) {
+        if (threads > 1 && n >= radix::parallelThreshold) {
+            WorkStealingPool pool(threads);
+            radix::RadixEngine<Value, KeyFn>(keyOf, &pool).sortParallel(first, n);
+            return;
+        }
+    }
+    radix::RadixEngine<Value, KeyFn>(keyOf, nullptr).sortRange(first, last, 0);
+}
+
+/**
+ * @brief Sort a random-access range of keys with MSD radix sort
+ *
+ * @tparam RandomIt random-access iterator over keys supported by RadixTraits
+ * @param first beginning of the range
+ * @param last end of the range
+ * @param threads number of threads, 0 means std::thread::hardware_concurrency(), 1 - no threads
+ */
+template <typename RandomIt>
+void msd_radix_sort(RandomIt first, RandomIt last, std::size_t threads = 0) {
+    msd_radix_sort(first, last, IdentityKey{}, threads);
+}
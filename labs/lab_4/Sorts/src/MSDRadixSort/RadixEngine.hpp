@@ -0,0 +1,257 @@
+/**
+ * @file RadixEngine.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the RadixEngine class - generic MSD radix sort over records with a key extractor
+ * @version 0.1
+ * @date 2025-12-04
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "RadixTraits.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace radix {
+constexpr std::size_t insertionThreshold = 32;      ///< Largest bucket sorted by insertion sort
+constexpr std::size_t parallelThreshold = 1 << 16;  ///< Smallest bucket sorted as a separate task
+
+/**
+ * @class RadixEngine
+ * @brief MSD radix sort of records of type Value by the key returned from KeyFn
+ *
+ * Records are permuted in place, keys are never copied into a separate array.
+ * Digits of a pass are cached when reading the key is indirect (strings, records),
+ * so the key of every record is read once per pass.
+ *
+ * @tparam Value type of sorted records
+ * @tparam KeyFn key extractor, callable with const Value& and returning a key supported by RadixTraits
+ */
+template <typename Value, typename KeyFn>
+class RadixEngine {
+public:
+    using Key = std::decay_t<std::invoke_result_t<const KeyFn&, const Value&>>;
+    using Traits = RadixTraits<Key>;
+
+    RadixEngine(const KeyFn& keyOf, WorkStealingPool* pool) : keyOf(keyOf), pool(pool) {}
+
+    // Сортировка диапазона на месте начиная с уровня level, без рекурсии
+    template <typename Iterator>
+    void sortRange(Iterator first, Iterator last, std::size_t level) {
+        std::vector<Range<Iterator>> stack;
+        stack.push_back({first, last, level});
+        std::array<std::size_t, Traits::buckets> counts;
+        while (!stack.empty()) {
+            Range<Iterator> range = stack.back();
+            stack.pop_back();
+            if (!countDigits(range, counts)) continue;
+            permute(range, counts);
+            Iterator begin = range.first;
+            for (std::size_t bucket = 0; bucket < Traits::buckets; ++bucket) {
+                std::size_t size = counts[bucket];
+                if (size > 1 && !Traits::isFinal(bucket, range.level)) {
+                    Range<Iterator> child{begin, begin + size, range.level + 1};
+                    if (pool && size >= parallelThreshold) {
+                        pool->submit([this, child] { sortRange(child.first, child.last, child.level); });
+                    } else {
+                        stack.push_back(child);
+                    }
+                }
+                begin += size;
+            }
+        }
+    }
+
+    // Параллельный верхний уровень: гистограммы по кускам, раскладка в буфер, корзины - задачами
+    template <typename Iterator>
+    void sortParallel(Iterator data, std::size_t n) {
+        const std::size_t chunks = pool->size();
+        const std::size_t chunkSize = (n + chunks - 1) / chunks;
+
+        std::vector<std::size_t> common(chunks, Traits::commonLevels(keyOf(data[0]), keyOf(data[0])));
+        forEachChunk(n, chunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::size_t level = common[chunk];
+            for (std::size_t i = begin; i < end && level > 0; ++i) {
+                level = std::min(level, Traits::commonLevels(keyOf(data[0]), keyOf(data[i])));
+            }
+            common[chunk] = level;
+        });
+        const std::size_t level = *std::min_element(common.begin(), common.end());
+        if (Traits::isDone(keyOf(data[0]), level)) return; // все ключи равны
+
+        std::unique_ptr<std::uint16_t[]> digits(cacheDigits ? new std::uint16_t[n] : nullptr);
+        std::vector<std::array<std::size_t, Traits::buckets>> offsets(chunks);
+        forEachChunk(n, chunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::array<std::size_t, Traits::buckets>& histogram = offsets[chunk];
+            histogram.fill(0);
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t d = Traits::digit(keyOf(data[i]), level);
+                if constexpr (cacheDigits) digits[i] = static_cast<std::uint16_t>(d);
+                histogram[d]++;
+            }
+        });
+        std::array<std::size_t, Traits::buckets> bucketStart;
+        std::size_t position = 0;
+        for (std::size_t bucket = 0; bucket < Traits::buckets; ++bucket) { // кусок c пишет корзину после кусков 0..c-1
+            bucketStart[bucket] = position;
+            for (std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                std::size_t count = offsets[chunk][bucket];
+                offsets[chunk][bucket] = position;
+                position += count;
+            }
+        }
+
+        std::unique_ptr<Value[]> buffer(new Value[n]);
+        forEachChunk(n, chunkSize, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+            std::array<std::size_t, Traits::buckets>& next = offsets[chunk];
+            for (std::size_t i = begin; i < end; ++i) {
+                std::size_t d;
+                if constexpr (cacheDigits) d = digits[i];
+                else d = Traits::digit(keyOf(data[i]), level);
+                buffer[next[d]++] = std::move(data[i]);
+            }
+        });
+        digits.reset();
+
+        // обычная корзина сортируется в буфере и сразу, пока в кэше, переносится обратно;
+        // крупная (перекос распределения) дробится на задачи и переносится после всех
+        std::vector<std::pair<std::size_t, std::size_t>> large;
+        Value* sorted = buffer.get();
+        for (std::size_t bucket = 0; bucket < Traits::buckets; ++bucket) {
+            std::size_t begin = bucketStart[bucket];
+            std::size_t end = bucket + 1 < Traits::buckets ? bucketStart[bucket + 1] : n;
+            if (begin == end) continue;
+            bool needsSort = end - begin > 1 && !Traits::isFinal(bucket, level);
+            if (needsSort && end - begin > chunkSize) {
+                large.emplace_back(begin, end);
+                pool->submit([this, sorted, begin, end, level] { sortRange(sorted + begin, sorted + end, level + 1); });
+                continue;
+            }
+            pool->submit([this, sorted, data, begin, end, level, needsSort] {
+                if (needsSort) RadixEngine(keyOf, nullptr).sortRange(sorted + begin, sorted + end, level + 1);
+                std::move(sorted + begin, sorted + end, data + begin);
+            });
+        }
+        pool->wait();
+        for (const auto& [begin, end] : large) {
+            forEachChunk(end - begin, chunkSize / 4 + 1, [sorted, data, begin = begin](std::size_t, std::size_t from, std::size_t to) {
+                std::move(sorted + begin + from, sorted + begin + to, data + begin + from);
+            });
+        }
+    }
+
+private:
+    template <typename Iterator>
+    struct Range {
+        Iterator first;
+        Iterator last;
+        std::size_t level;
+    };
+
+    // кэшируем цифры, если ключ достается косвенно
+    static constexpr bool cacheDigits = Traits::cacheDigits || !std::is_same_v<Key, Value>;
+
+    const KeyFn& keyOf;
+    WorkStealingPool* pool;
+
+    static thread_local std::vector<std::uint16_t> digitCache;
+
+    template <typename Function>
+    void forEachChunk(std::size_t n, std::size_t chunkSize, Function function) {
+        for (std::size_t chunk = 0; chunk * chunkSize < n; ++chunk) {
+            std::size_t begin = chunk * chunkSize;
+            std::size_t end = std::min(n, begin + chunkSize);
+            pool->submit([&function, chunk, begin, end] { function(chunk, begin, end); });
+        }
+        pool->wait();
+    }
+
+    template <typename Iterator>
+    void insertionSort(Iterator first, Iterator last, std::size_t level) const {
+        for (Iterator current = first + 1; current < last; ++current) {
+            Value value = std::move(*current);
+            Iterator hole = current;
+            for (; hole > first && Traits::less(keyOf(value), keyOf(*(hole - 1)), level); --hole) {
+                *hole = std::move(*(hole - 1));
+            }
+            *hole = std::move(value);
+        }
+    }
+
+    // Гистограмма первого уровня, на котором ключи различаются: общий префикс диапазона
+    // находится одним проходом commonLevels, как в sortParallel, а не проходом на каждый уровень.
+    // false - диапазон уже отсортирован
+    template <typename Iterator>
+    bool countDigits(Range<Iterator>& range, std::array<std::size_t, Traits::buckets>& counts) {
+        std::size_t n = range.last - range.first;
+        if (n <= insertionThreshold) {
+            insertionSort(range.first, range.last, range.level);
+            return false;
+        }
+        const auto& first = keyOf(range.first[0]);
+        std::size_t level = Traits::commonLevels(first, keyOf(range.first[1]));
+        for (std::size_t i = 2; i < n && level > range.level; ++i) { // ключи диапазона уже совпадают до range.level
+            level = std::min(level, Traits::commonLevels(first, keyOf(range.first[i])));
+        }
+        if (Traits::isDone(first, level)) return false; // все ключи равны
+        range.level = std::max(range.level, level);
+        counts.fill(0);
+        if constexpr (cacheDigits) {
+            digitCache.resize(n);
+            for (std::size_t i = 0; i < n; ++i) {
+                digitCache[i] = static_cast<std::uint16_t>(Traits::digit(keyOf(range.first[i]), range.level));
+                counts[digitCache[i]]++;
+            }
+        } else {
+            for (std::size_t i = 0; i < n; ++i) counts[Traits::digit(keyOf(range.first[i]), range.level)]++;
+        }
+        return true;
+    }
+
+    // Перестановка на месте по циклам (American flag sort)
+    template <typename Iterator>
+    void permute(const Range<Iterator>& range, const std::array<std::size_t, Traits::buckets>& counts) {
+        std::array<std::size_t, Traits::buckets> heads;
+        std::array<std::size_t, Traits::buckets> tails;
+        std::size_t position = 0;
+        for (std::size_t bucket = 0; bucket < Traits::buckets; ++bucket) {
+            heads[bucket] = position;
+            position += counts[bucket];
+            tails[bucket] = position;
+        }
+        Iterator data = range.first;
+        for (std::size_t bucket = 0; bucket < Traits::buckets; ++bucket) {
+            while (heads[bucket] < tails[bucket]) {
+                std::size_t i = heads[bucket];
+                std::size_t d = digitOf(data, i, range.level);
+                while (d != bucket) { // ставим элемент в его корзину, забираем оттуда следующий
+                    std::size_t j = heads[d]++;
+                    std::iter_swap(data + i, data + j);
+                    if constexpr (cacheDigits) std::swap(digitCache[i], digitCache[j]);
+                    d = digitOf(data, i, range.level);
+                }
+                heads[bucket]++;
+            }
+        }
+    }
+
+    template <typename Iterator>
+    std::size_t digitOf(Iterator data, std::size_t i, std::size_t level) const {
+        if constexpr (cacheDigits) return digitCache[i];
+        else return Traits::digit(keyOf(data[i]), level);
+    }
+};
+
+template <typename Value, typename KeyFn>
+thread_local std::vector<std::uint16_t> RadixEngine<Value, KeyFn>::digitCache;
+}
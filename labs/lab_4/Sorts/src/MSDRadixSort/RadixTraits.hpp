@@ -0,0 +1,144 @@
+/**
+ * @file RadixTraits.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of RadixTraits - compile-time digit extraction for MSD radix sort
+ * @version 0.1
+ * @date 2025-12-04
+ *
+ *
+ */
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * @struct RadixTraits
+ * @brief Digit layout of a key type, specialised for every supported key
+ *
+ * A specialisation provides:
+ * - buckets - number of digit values;
+ * - cacheDigits - whether digits are worth caching during a pass (the key is behind a pointer);
+ * - digit(key, level) - digit of the key on the given level, level 0 is the most significant;
+ * - isFinal(bucket, level) - true if keys of this bucket are equal after this level;
+ * - commonLevels(a, b) - number of leading levels on which two keys agree;
+ * - isDone(key, level) - true if level is past the last digit of the key;
+ * - less(a, b, level) - comparison of keys known to be equal before level.
+ *
+ * @tparam Key type of the key
+ */
+template <typename Key, typename = void>
+struct RadixTraits {
+    static_assert(sizeof(Key) == 0, "RadixTraits: unsupported key type, use uint32_t, uint64_t, double or strings");
+};
+
+/**
+ * @brief Unsigned integers: one byte per level
+ *
+ */
+template <typename Key>
+struct RadixTraits<Key, std::enable_if_t<std::is_same_v<Key, std::uint32_t> || std::is_same_v<Key, std::uint64_t>>> {
+    static constexpr std::size_t buckets = 256;
+    static constexpr std::size_t levels = sizeof(Key);
+    static constexpr bool cacheDigits = false;
+
+    static std::size_t digit(Key key, std::size_t level) {
+        return static_cast<std::size_t>(key >> (8 * (levels - 1 - level))) & 0xFF;
+    }
+
+    static bool isFinal(std::size_t, std::size_t level) {
+        return level + 1 == levels;
+    }
+
+    static std::size_t commonLevels(Key a, Key b) {
+        Key diff = a ^ b;
+        std::size_t level = 0;
+        while (level < levels && digit(diff, level) == 0) level++;
+        return level;
+    }
+
+    static bool isDone(Key, std::size_t level) {
+        return level >= levels;
+    }
+
+    static bool less(Key a, Key b, std::size_t) {
+        return a < b;
+    }
+};
+
+/**
+ * @brief Double: bits are mapped to an unsigned key with the same order
+ * (negative numbers are inverted, positive ones get the sign bit set)
+ *
+ */
+template <>
+struct RadixTraits<double> {
+    using Bits = RadixTraits<std::uint64_t>;
+    static constexpr std::size_t buckets = Bits::buckets;
+    static constexpr bool cacheDigits = false;
+
+    static std::uint64_t encode(double key) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &key, sizeof(bits));
+        return (bits >> 63) ? ~bits : bits | (std::uint64_t(1) << 63);
+    }
+
+    static std::size_t digit(double key, std::size_t level) {
+        return Bits::digit(encode(key), level);
+    }
+
+    static bool isFinal(std::size_t bucket, std::size_t level) {
+        return Bits::isFinal(bucket, level);
+    }
+
+    static std::size_t commonLevels(double a, double b) {
+        return Bits::commonLevels(encode(a), encode(b));
+    }
+
+    static bool isDone(double, std::size_t level) {
+        return level >= Bits::levels;
+    }
+
+    static bool less(double a, double b, std::size_t) {
+        return encode(a) < encode(b); // -0.0 < +0.0, NaN по краям - как в поразрядном порядке
+    }
+};
+
+/**
+ * @brief Strings: one character per level, bucket 0 holds strings that already ended
+ *
+ */
+template <typename Key>
+struct RadixTraits<Key, std::enable_if_t<std::is_same_v<Key, std::string> || std::is_same_v<Key, std::string_view>>> {
+    static constexpr std::size_t buckets = 257;
+    static constexpr bool cacheDigits = true; // символ лежит в куче, читаем его один раз за проход
+
+    static std::size_t digit(std::string_view key, std::size_t level) {
+        return level < key.size() ? static_cast<unsigned char>(key[level]) + 1 : 0;
+    }
+
+    static bool isFinal(std::size_t bucket, std::size_t) {
+        return bucket == 0; // закончившиеся строки равны между собой
+    }
+
+    static std::size_t commonLevels(std::string_view a, std::string_view b) {
+        std::size_t limit = std::min(a.size(), b.size());
+        std::size_t level = 0;
+        while (level < limit && a[level] == b[level]) level++;
+        if (level == limit && a.size() == b.size()) level++; // совпал и конец строки
+        return level;
+    }
+
+    static bool isDone(std::string_view key, std::size_t level) {
+        return level > key.size();
+    }
+
+    static bool less(std::string_view a, std::string_view b, std::size_t level) {
+        return a.substr(level) < b.substr(level); // префикс уже совпал
+    }
+};
@@ -0,0 +1,98 @@
+#include "WorkStealingPool.hpp"
+
+namespace {
+// пул и индекс очереди текущего потока-исполнителя
+thread_local const WorkStealingPool* currentPool = nullptr;
+thread_local std::size_t currentIndex = 0;
+}
+
+WorkStealingPool::WorkStealingPool(std::size_t threads) {
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    for (std::size_t i = 0; i < threads; ++i) {
+        queues.push_back(std::make_unique<Queue>());
+    }
+    workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+    for (std::thread& worker : workers) worker.join();
+}
+
+std::size_t WorkStealingPool::size() const {
+    return workers.size();
+}
+
+void WorkStealingPool::submit(Task task) {
+    std::size_t index = currentPool == this
+        ? currentIndex // свою подзадачу кладем себе: данные еще в кэше
+        : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    pending.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.push_back(std::move(task));
+    }
+    queued.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex); // без этого уведомление можно потерять
+    }
+    wakeUp.notify_one();
+}
+
+bool WorkStealingPool::runOne(std::size_t self) {
+    Task task;
+    for (std::size_t step = 0; step < queues.size() && !task; ++step) {
+        std::size_t index = (self + step) % queues.size();
+        Queue& queue = *queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+        if (step == 0) { // своя очередь - с конца, чужая - с начала
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+    }
+    if (!task) return false;
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    task();
+    if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        finished.notify_all();
+    }
+    return true;
+}
+
+void WorkStealingPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentIndex = index;
+    while (true) {
+        if (runOne(index)) continue;
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] {
+            return stopping || queued.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && queued.load(std::memory_order_acquire) == 0) return;
+    }
+}
+
+void WorkStealingPool::wait() {
+    std::size_t self = nextQueue.load(std::memory_order_relaxed) % queues.size();
+    while (pending.load(std::memory_order_acquire) > 0) {
+        if (runOne(self)) continue; // ожидающий поток тоже работает
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        finished.wait(lock, [this] {
+            return pending.load(std::memory_order_acquire) == 0 || queued.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
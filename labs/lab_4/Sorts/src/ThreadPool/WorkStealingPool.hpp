@@ -0,0 +1,104 @@
+/**
+ * @file WorkStealingPool.hpp
+ * @author George (BSUIR, Gr.421702)
+ * @brief Header file of the WorkStealingPool class - thread pool used by parallel sorts
+ * @version 0.1
+ * @date 2025-12-01
+ *
+ *
+ */
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Fixed-size thread pool with a task deque per worker
+ *
+ * A worker pushes and pops its own tasks at the back of its deque (the most recently
+ * split bucket is still in cache) and, when it runs out of work, steals the oldest
+ * task from the front of another deque. Tasks submitted from outside the pool are
+ * spread over the deques round-robin. Tasks may submit further tasks.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Construct a new WorkStealingPool object and start the workers
+     *
+     * @param threads number of worker threads, 0 means std::thread::hardware_concurrency()
+     */
+    explicit WorkStealingPool(std::size_t threads = 0);
+
+    /**
+     * @brief Destroy the WorkStealingPool object, waits for all submitted tasks
+     *
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Submit a task for execution
+     *
+     * @param task task to run, exceptions thrown by it terminate the program
+     */
+    void submit(Task task);
+
+    /**
+     * @brief Wait until all submitted tasks (including tasks they submitted) are finished
+     *
+     * The calling thread runs queued tasks itself while waiting.
+     * Must not be called from a task of the same pool.
+     */
+    void wait();
+
+    /**
+     * @brief Get the number of worker threads
+     *
+     * @return std::size_t
+     */
+    std::size_t size() const;
+
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues;     ///< One deque per worker
+    std::vector<std::thread> workers;
+    std::atomic<std::size_t> queued{0};             ///< Tasks waiting in deques
+    std::atomic<std::size_t> pending{0};            ///< Submitted but not finished tasks
+    std::atomic<std::size_t> nextQueue{0};          ///< Round-robin counter for external submits
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;                 ///< Signalled when work appears or on stop
+    std::condition_variable finished;               ///< Signalled when pending drops to zero
+    bool stopping = false;
+
+    /**
+     * @brief Take a task from the own deque or steal one from another deque and run it
+     *
+     * @param self index of the own deque
+     * @return true if a task was run
+     * @return false if all deques were empty
+     */
+    bool runOne(std::size_t self);
+
+    /**
+     * @brief Main loop of a worker thread
+     *
+     * @param index index of the worker
+     */
+    void workerLoop(std::size_t index);
+};